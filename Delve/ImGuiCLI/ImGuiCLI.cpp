@@ -384,6 +384,44 @@ namespace ImGuiCLI
         }
         return false;
     }
+    void ImGuiCli::SetDragDropPayload(System::String^ id, array<int>^ data)
+    {
+        if (data->Length == 0)
+        {
+            ImGui::SetDragDropPayload(ToSTLString(id).c_str(), NULL, 0);
+            return;
+        }
+        pin_ptr<int> p = &data[0];
+        ImGui::SetDragDropPayload(ToSTLString(id).c_str(), p, data->Length * sizeof(int));
+    }
+    void ImGuiCli::SetDragDropPayload(System::String^ id, array<System::Guid>^ data)
+    {
+        if (data->Length == 0)
+        {
+            ImGui::SetDragDropPayload(ToSTLString(id).c_str(), NULL, 0);
+            return;
+        }
+        pin_ptr<System::Guid> p = &data[0];
+        ImGui::SetDragDropPayload(ToSTLString(id).c_str(), p, data->Length * sizeof(System::Guid));
+    }
+    void ImGuiCli::SetDragDropPayload(System::String^ id, array<System::Byte>^ data)
+    {
+        if (data->Length == 0)
+        {
+            ImGui::SetDragDropPayload(ToSTLString(id).c_str(), NULL, 0);
+            return;
+        }
+        pin_ptr<System::Byte> p = &data[0];
+        ImGui::SetDragDropPayload(ToSTLString(id).c_str(), p, data->Length);
+    }
+    DragDropPayload^ ImGuiCli::AcceptDragDropPayload(System::String^ id)
+    {
+        const ::ImGuiPayload* payload = ImGui::AcceptDragDropPayload(ToSTLString(id).c_str());
+        if (!payload)
+            return nullptr;
+        dragDropPayload_->payload_ = payload;
+        return dragDropPayload_;
+    }
     bool ImGuiCli::BeginDragDropSource() { return ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID); }
     void ImGuiCli::EndDragDropSource() { ImGui::EndDragDropSource(); }
     bool ImGuiCli::BeginDragDropTarget() { return ImGui::BeginDragDropTarget(); }
@@ -694,6 +732,30 @@ namespace ImGuiCLI
         pin_ptr<float> p = &values[0];
         ImGui::PlotLines(LBL, p, values->Length, valueOffset, ToSTLString(overlayText).c_str(), minVal, maxVal);
     }
+    void ImGuiCli::PlotLines(System::String^ label, PlotStream^ stream)
+    {
+        ImGui::PlotStreamLines(LBL, (::ImGuiPlotStream*)stream->data_);
+    }
+    void ImGuiCli::PlotLines(System::String^ label, PlotStream^ stream, Vector2 size)
+    {
+        ImGui::PlotStreamLines(LBL, (::ImGuiPlotStream*)stream->data_, 0x0, FLT_MAX, FLT_MAX, ImVec2(size.X, size.Y));
+    }
+    void ImGuiCli::PlotLines(System::String^ label, PlotStream^ stream, float minVal, float maxVal, Vector2 size)
+    {
+        ImGui::PlotStreamLines(LBL, (::ImGuiPlotStream*)stream->data_, 0x0, minVal, maxVal, ImVec2(size.X, size.Y));
+    }
+    void ImGuiCli::PlotHistogram(System::String^ label, PlotStream^ stream)
+    {
+        ImGui::PlotStreamHistogram(LBL, (::ImGuiPlotStream*)stream->data_);
+    }
+    void ImGuiCli::PlotHistogram(System::String^ label, PlotStream^ stream, Vector2 size)
+    {
+        ImGui::PlotStreamHistogram(LBL, (::ImGuiPlotStream*)stream->data_, 0x0, FLT_MAX, FLT_MAX, ImVec2(size.X, size.Y));
+    }
+    void ImGuiCli::PlotHistogram(System::String^ label, PlotStream^ stream, float minVal, float maxVal, Vector2 size)
+    {
+        ImGui::PlotStreamHistogram(LBL, (::ImGuiPlotStream*)stream->data_, 0x0, minVal, maxVal, ImVec2(size.X, size.Y));
+    }
 
     void ImGuiCli::PushClipRect(Vector2 min, Vector2 max, bool intersect) { ImGui::PushClipRect(ImVec2(min.X, min.Y), ImVec2(max.X, max.Y), intersect); }
     void ImGuiCli::PopClipRect() { ImGui::PopClipRect(); }
@@ -956,6 +1018,10 @@ void ImGuiCLI::ImGuiDock::EndDock() { ImGui::EndDock(); }
 void ImGuiCLI::ImGuiDock::SetDockActive() { ImGui::SetDockActive(); }
 void ImGuiCLI::ImGuiDock::LoadDock() { ImGui::LoadDock(); }
 void ImGuiCLI::ImGuiDock::SaveDock() { ImGui::SaveDock(); }
+void ImGuiCLI::ImGuiDock::SaveDockPreset(System::String^ name) { ImGui::SaveDockPreset(ToSTLString(name).c_str()); }
+bool ImGuiCLI::ImGuiDock::LoadDockPreset(System::String^ name) { return ImGui::LoadDockPreset(ToSTLString(name).c_str()); }
+void ImGuiCLI::ImGuiDock::RemoveDockPreset(System::String^ name) { ImGui::RemoveDockPreset(ToSTLString(name).c_str()); }
+bool ImGuiCLI::ImGuiDock::HasDockPreset(System::String^ name) { return ImGui::HasDockPreset(ToSTLString(name).c_str()); }
 
 /// ImGuiStyle
 Vector2 ImGuiCLI::ImGuiStyle::WindowPadding::get()
@@ -1049,6 +1115,40 @@ void ImGuiCLI::ImGuiStyle::StyleColorsLight() { ImGui::StyleColorsLight(); }
 void ImGuiCLI::ImGuiStyle::StyleColorsClassic() { ImGui::StyleColorsClassic(); }
 void ImGuiCLI::ImGuiStyle::StyleColorsDark() { ImGui::StyleColorsDark(); }
 
+ImGuiCLI::PlotStream::PlotStream(int capacity)
+{
+    data_ = (void*)new ::ImGuiPlotStream(capacity);
+}
+
+ImGuiCLI::PlotStream::~PlotStream()
+{
+    if (data_)
+        delete ((::ImGuiPlotStream*)data_);
+    data_ = nullptr;
+}
+
+void ImGuiCLI::PlotStream::Append(float value)
+{
+    ((::ImGuiPlotStream*)data_)->Append(value);
+}
+void ImGuiCLI::PlotStream::Append(array<float>^ values)
+{
+    if (values == nullptr || values->Length == 0)
+        return;
+    pin_ptr<float> p = &values[0];
+    ((::ImGuiPlotStream*)data_)->Append(p, values->Length);
+}
+void ImGuiCLI::PlotStream::Clear()
+{
+    ((::ImGuiPlotStream*)data_)->Clear();
+}
+
+int ImGuiCLI::PlotStream::Count::get() { return ((::ImGuiPlotStream*)data_)->Count; }
+int ImGuiCLI::PlotStream::Capacity::get() { return ((::ImGuiPlotStream*)data_)->Capacity; }
+void ImGuiCLI::PlotStream::Capacity::set(int value) { ((::ImGuiPlotStream*)data_)->SetCapacity(value); }
+float ImGuiCLI::PlotStream::Min::get() { return ((::ImGuiPlotStream*)data_)->GetMin(); }
+float ImGuiCLI::PlotStream::Max::get() { return ((::ImGuiPlotStream*)data_)->GetMax(); }
+
 ImGuiCLI::ImGuiTextFilter::ImGuiTextFilter()
 {
     data_ = (void*)new ::ImGuiTextFilter();
@@ -1084,6 +1184,129 @@ bool ImGuiCLI::ImGuiTextFilter::PassFilter(System::String^ label)
     return ((::ImGuiTextFilter*)data_)->PassFilter(LBL);
 }
 
+namespace ImGuiCLI
+{
+    // Runs the jobs of a native jobs_runner call on the thread pool
+    ref class ParallelJobs
+    {
+    public:
+        ParallelJobs(void (*runJob)(int, void*), void* jobs) : runJob_(runJob), jobs_(jobs) { }
+        void Run(int jobIndex) { runJob_(jobIndex, jobs_); }
+    private:
+        void (*runJob_)(int, void*);
+        void* jobs_;
+    };
+
+    void ParallelJobsRunner(int jobCount, void (*runJob)(int, void*), void* jobs, void*)
+    {
+        ParallelJobs^ parallelJobs = gcnew ParallelJobs(runJob, jobs);
+        System::Threading::Tasks::Parallel::For(0, jobCount, gcnew System::Action<int>(parallelJobs, &ParallelJobs::Run));
+    }
+}
+
+array<int>^ ImGuiCLI::ImGuiTextFilter::PassFilter(TextList^ texts)
+{
+    ImVector<int> indices;
+    ((::ImGuiTextList*)texts->data_)->Filter(*(::ImGuiTextFilter*)data_, &indices, ParallelJobsRunner);
+    array<int>^ ret = gcnew array<int>(indices.Size);
+    if (indices.Size > 0)
+        Marshal::Copy(IntPtr(indices.Data), ret, 0, indices.Size);
+    return ret;
+}
+
+#define PAYLOAD ((const ::ImGuiPayload*)payload_)
+System::String^ ImGuiCLI::DragDropPayload::DataType::get() { return gcnew System::String(PAYLOAD->DataType); }
+System::IntPtr ImGuiCLI::DragDropPayload::Data::get() { return System::IntPtr((void*)PAYLOAD->Data); }
+int ImGuiCLI::DragDropPayload::Size::get() { return PAYLOAD->DataSize; }
+unsigned ImGuiCLI::DragDropPayload::Version::get() { return PAYLOAD->DataVersion; }
+bool ImGuiCLI::DragDropPayload::IsPreview::get() { return PAYLOAD->IsPreview(); }
+bool ImGuiCLI::DragDropPayload::IsDelivery::get() { return PAYLOAD->IsDelivery(); }
+
+array<int>^ ImGuiCLI::DragDropPayload::ToIntArray()
+{
+    array<int>^ ret = gcnew array<int>(PAYLOAD->DataSize / sizeof(int));
+    if (ret->Length > 0)
+        Marshal::Copy(IntPtr((void*)PAYLOAD->Data), ret, 0, ret->Length);
+    return ret;
+}
+array<System::Guid>^ ImGuiCLI::DragDropPayload::ToGuidArray()
+{
+    array<System::Guid>^ ret = gcnew array<System::Guid>(PAYLOAD->DataSize / sizeof(System::Guid));
+    if (ret->Length > 0)
+    {
+        pin_ptr<System::Guid> p = &ret[0];
+        memcpy(p, PAYLOAD->Data, ret->Length * sizeof(System::Guid));
+    }
+    return ret;
+}
+array<System::Byte>^ ImGuiCLI::DragDropPayload::ToByteArray()
+{
+    array<System::Byte>^ ret = gcnew array<System::Byte>(PAYLOAD->DataSize);
+    if (ret->Length > 0)
+        Marshal::Copy(IntPtr((void*)PAYLOAD->Data), ret, 0, ret->Length);
+    return ret;
+}
+#undef PAYLOAD
+
+ImGuiCLI::TextList::TextList()
+{
+    data_ = (void*)new ::ImGuiTextList();
+}
+
+ImGuiCLI::TextList::~TextList()
+{
+    if (data_)
+        delete ((::ImGuiTextList*)data_);
+    data_ = nullptr;
+}
+
+int ImGuiCLI::TextList::Add(System::String^ text)
+{
+    std::string str = ToSTLString(text);
+    return ((::ImGuiTextList*)data_)->Add(str.data(), str.data() + str.size());
+}
+void ImGuiCLI::TextList::Clear()
+{
+    ((::ImGuiTextList*)data_)->Clear();
+}
+
+int ImGuiCLI::TextList::Count::get() { return ((::ImGuiTextList*)data_)->Size(); }
+
+ImGuiCLI::FuzzyIndex::FuzzyIndex()
+{
+    data_ = (void*)new ::ImGuiFuzzyIndex();
+}
+
+ImGuiCLI::FuzzyIndex::~FuzzyIndex()
+{
+    if (data_)
+        delete ((::ImGuiFuzzyIndex*)data_);
+    data_ = nullptr;
+}
+
+int ImGuiCLI::FuzzyIndex::Add(System::String^ text)
+{
+    std::string str = ToSTLString(text);
+    return ((::ImGuiFuzzyIndex*)data_)->Add(str.data(), str.data() + str.size());
+}
+void ImGuiCLI::FuzzyIndex::Clear()
+{
+    ((::ImGuiFuzzyIndex*)data_)->Clear();
+}
+
+array<int>^ ImGuiCLI::FuzzyIndex::Search(System::String^ pattern, int maxResults)
+{
+    ImVector<::ImGuiFuzzyMatch> matches;
+    matches.resize(ImMax(maxResults, 0));
+    const int count = ((::ImGuiFuzzyIndex*)data_)->Search(ToSTLString(pattern).c_str(), matches.Data, matches.Size);
+    array<int>^ ret = gcnew array<int>(count);
+    for (int i = 0; i < count; ++i)
+        ret[i] = matches[i].Index;
+    return ret;
+}
+
+int ImGuiCLI::FuzzyIndex::Count::get() { return ((::ImGuiFuzzyIndex*)data_)->Size(); }
+
 namespace ImGuiCLI
 {
     Gizmo::Gizmo()
@@ -1108,16 +1331,11 @@ namespace ImGuiCLI
         projectionMatrix_ = projMatrix;
     }
 
-    bool Gizmo::Manipulate(Matrix% editMatrix, Matrix% deltaMatrx)
+    static void GetGizmoOperation(GizmoMode gizmoMode, bool isLocal, ImGuizmo::OPERATION& op, ImGuizmo::MODE& loc)
     {
-        ImGuizmo::SetContext((ImGuizmo::Context*)context_);
-        Matrix edit = editMatrix;
-        Matrix delta;
-        ImGuizmo::SetDrawlist();
-
-        ImGuizmo::OPERATION op = ImGuizmo::OPERATION::TRANSLATE;
-        ImGuizmo::MODE loc = isLocal_ ? ImGuizmo::MODE::LOCAL : ImGuizmo::MODE::WORLD;
-        switch (gizmoMode_)
+        op = ImGuizmo::OPERATION::TRANSLATE;
+        loc = isLocal ? ImGuizmo::MODE::LOCAL : ImGuizmo::MODE::WORLD;
+        switch (gizmoMode)
         {
         case GizmoMode::Translate:
             op = ImGuizmo::OPERATION::TRANSLATE;
@@ -1134,6 +1352,18 @@ namespace ImGuiCLI
             loc = ImGuizmo::MODE::LOCAL;
             break;
         }
+    }
+
+    bool Gizmo::Manipulate(Matrix% editMatrix, Matrix% deltaMatrx)
+    {
+        ImGuizmo::SetContext((ImGuizmo::Context*)context_);
+        Matrix edit = editMatrix;
+        Matrix delta;
+        ImGuizmo::SetDrawlist();
+
+        ImGuizmo::OPERATION op;
+        ImGuizmo::MODE loc;
+        GetGizmoOperation(gizmoMode_, isLocal_, op, loc);
 
         Matrix vm = viewMatrix_;
         Matrix pm = projectionMatrix_;
@@ -1147,6 +1377,28 @@ namespace ImGuiCLI
         return false;
     }
 
+    bool Gizmo::ManipulateMany(array<Matrix>^ matrices, bool individualOrigins, Matrix% deltaMatrx)
+    {
+        if (matrices == nullptr || matrices->Length == 0)
+            return false;
+
+        ImGuizmo::SetContext((ImGuizmo::Context*)context_);
+        Matrix delta;
+        ImGuizmo::SetDrawlist();
+
+        ImGuizmo::OPERATION op;
+        ImGuizmo::MODE loc;
+        GetGizmoOperation(gizmoMode_, isLocal_, op, loc);
+
+        Matrix vm = viewMatrix_;
+        Matrix pm = projectionMatrix_;
+        pin_ptr<float> data = &matrices[0].M11;
+        bool changed = ImGuizmo::ManipulateMany(&vm.M11, &pm.M11, op, loc, individualOrigins ? ImGuizmo::PIVOT_INDIVIDUAL : ImGuizmo::PIVOT_CENTER, data, matrices->Length, &delta.M11);
+        if (changed)
+            deltaMatrx = delta;
+        return changed;
+    }
+
     bool Gizmo::IsOver::get()
     {
         ImGuizmo::SetContext((ImGuizmo::Context*)context_);
@@ -309,6 +309,46 @@ namespace ImGuiCLI {
         static property float CurrentDPI { float get(); }
     };
 
+    /// Native ring buffer of samples for plotting long histories, samples are appended once instead of resubmitting the whole array every frame
+    public ref class PlotStream
+    {
+    public:
+        PlotStream(int capacity);
+        ~PlotStream();
+
+        void Append(float value);
+        void Append(array<float>^ values);
+        void Clear();
+
+        property int Count { int get(); }
+        property int Capacity { int get(); void set(int); }
+        property float Min { float get(); }
+        property float Max { float get(); }
+
+    internal:
+        void* data_;
+    };
+
+    /// Payload accepted by ImGuiCli::AcceptDragDropPayload(id), a view over the native payload that is reused across frames.
+    /// Version only changes when the source submits different data, so decoded arrays can be cached against it.
+    public ref class DragDropPayload
+    {
+    public:
+        property System::String^ DataType { System::String^ get(); }
+        property System::IntPtr Data { System::IntPtr get(); }
+        property int Size { int get(); }
+        property unsigned Version { unsigned get(); }
+        property bool IsPreview { bool get(); }
+        property bool IsDelivery { bool get(); }
+
+        array<int>^ ToIntArray();
+        array<System::Guid>^ ToGuidArray();
+        array<System::Byte>^ ToByteArray();
+
+    internal:
+        const void* payload_;
+    };
+
 	public ref class ImGuiCli
 	{
     public:
@@ -412,8 +452,14 @@ namespace ImGuiCLI {
 
         // Drag and drop
         static void SetDragDropPayload(System::String^ id, System::String^ data);
+        /// Blittable payloads are compared with the current one natively and only copied when they differ
+        static void SetDragDropPayload(System::String^ id, array<int>^ data);
+        static void SetDragDropPayload(System::String^ id, array<System::Guid>^ data);
+        static void SetDragDropPayload(System::String^ id, array<System::Byte>^ data);
         static bool BeginDragDropSource();
         static bool AcceptDragDropPayload(System::String^ id, System::String^% outData);
+        /// Returns nullptr when nothing of type id is accepted
+        static DragDropPayload^ AcceptDragDropPayload(System::String^ id);
         static void EndDragDropSource();
         static bool BeginDragDropTarget();
         static void EndDragDropTarget();
@@ -538,6 +584,12 @@ namespace ImGuiCLI {
         static void PlotLines(System::String^ label, array<float>^ values, int valueOffset, float minVal, float maxVal);
         static void PlotLines(System::String^ label, array<float>^ values, int valueOffset, float minVal, float maxVal, Vector2 size);
         static void PlotLines(System::String^ label, array<float>^ values, int valueOffset, System::String^ overlayText, float minVal, float maxVal);
+        static void PlotLines(System::String^ label, PlotStream^ stream);
+        static void PlotLines(System::String^ label, PlotStream^ stream, Vector2 size);
+        static void PlotLines(System::String^ label, PlotStream^ stream, float minVal, float maxVal, Vector2 size);
+        static void PlotHistogram(System::String^ label, PlotStream^ stream);
+        static void PlotHistogram(System::String^ label, PlotStream^ stream, Vector2 size);
+        static void PlotHistogram(System::String^ label, PlotStream^ stream, float minVal, float maxVal, Vector2 size);
 
         // Clipping
         static void PushClipRect(Vector2 min, Vector2 max, bool intersect);
@@ -553,6 +605,9 @@ namespace ImGuiCLI {
         static void ShowDemoWindow();
         static void ShowMetricsWindow();
         static void ShowStyleEditor();
+
+    private:
+        static DragDropPayload^ dragDropPayload_ = gcnew DragDropPayload();
 	};
 
     public ref class ImGuiEx
@@ -633,6 +688,46 @@ namespace ImGuiCLI {
         static void SetDockActive();
         static void LoadDock();
         static void SaveDock();
+        /// Captures the current dock tree as a named in-memory preset.
+        static void SaveDockPreset(System::String^ name);
+        /// Switches to a preset, only docks that differ from it are touched.
+        static bool LoadDockPreset(System::String^ name);
+        static void RemoveDockPreset(System::String^ name);
+        static bool HasDockPreset(System::String^ name);
+    };
+
+    /// Native list of UTF-8 strings, converted once when added and then filtered as a whole by ImGuiTextFilter::PassFilter(TextList^)
+    public ref class TextList
+    {
+    public:
+        TextList();
+        ~TextList();
+
+        int Add(System::String^ text);
+        void Clear();
+
+        property int Count { int get(); }
+
+    internal:
+        void* data_;
+    };
+
+    /// Native fuzzy search index for command palettes and asset pickers, candidates are prepared once when added
+    public ref class FuzzyIndex
+    {
+    public:
+        FuzzyIndex();
+        ~FuzzyIndex();
+
+        int Add(System::String^ text);
+        void Clear();
+        /// Indices of the best maxResults candidates for pattern, best first. Typing more characters only rescans the previous matches.
+        array<int>^ Search(System::String^ pattern, int maxResults);
+
+        property int Count { int get(); }
+
+    internal:
+        void* data_;
     };
 
     public ref class ImGuiTextFilter
@@ -647,6 +742,8 @@ namespace ImGuiCLI {
 
         property bool IsActive { bool get(); }
         bool PassFilter(System::String^ text);
+        /// Indices of the strings of texts that pass the filter, in order. Large lists are split across the thread pool.
+        array<int>^ PassFilter(TextList^ texts);
     private:
         void* data_;
     };
@@ -679,6 +776,8 @@ namespace ImGuiCLI {
 
         void Prepare(Matrix viewMatrix, Matrix projection, int x, int y, int w, int h);
         bool Manipulate(Matrix% editMatrix, Matrix% deltaMatrx);
+        /// Manipulate a whole selection in place around its center or around each matrix origin, returns true if any matrix changed
+        bool ManipulateMany(array<Matrix>^ matrices, bool individualOrigins, Matrix% deltaMatrx);
 
     private:
         Matrix viewMatrix_;
@@ -83,6 +83,7 @@ namespace ImGuiCLI
         main_viewport->PlatformHandle = (void*)g_hWnd;
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
             ImGui_ImplWin32_InitPlatformInterface();
+        ImGui_ImplWin32_InitIniWriter();
         //??ImGui::GetIO().ImeWindowHandle = g_hWnd;
 
         // Keyboard mapping. ImGui will use those indices to peek into the io.KeysDown[] array that we will update during the application lifetime.
@@ -234,6 +235,7 @@ namespace ImGuiCLI
 
         extern void ImGui_ImplWin32_ShutdownPlatformInterface();
         ImGui_ImplWin32_ShutdownPlatformInterface();
+        ImGui_ImplWin32_ShutdownIniWriter();
 
         ImGui::DestroyContext();
     }
@@ -26,9 +26,20 @@
 #endif
 #include "imgui_internal.h"
 #include "ImGuizmo.h"
+#include "ImGuizmo_internal.h"
 
 #include <algorithm>
 
+// SSE versions of the matrix/vector kernels, the scalar versions stay compiled for RunKernel(). Managed (/clr) builds keep the
+// scalar code, intrinsics would be compiled as native functions there and pay a managed/native transition on every call.
+// ImGuiCLI.vcxproj builds this file without /clr for that reason, the managed code only crosses over at the API calls.
+#if !defined(IMGUIZMO_DISABLE_SSE) && !defined(_M_CEE) && (defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__))
+#define IMGUIZMO_SSE 1
+#include <xmmintrin.h>
+#else
+#define IMGUIZMO_SSE 0
+#endif
+
 // includes patches for multiview from
 // https://github.com/CedricGuillemet/ImGuizmo/issues/15
 
@@ -58,17 +69,32 @@ namespace ImGuizmo
            if (!state)
                currentTime_ = 0.0f;
        }
-
-       float Update(float value)
-       {
-
-       }
    };
 
    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    // utility and math
 
-   void FPU_MatrixF_x_MatrixF(const float *a, const float *b, float *r)
+#if IMGUIZMO_SSE
+   static void MatrixF_x_MatrixF_SSE(const float *a, const float *b, float *r)
+   {
+      // b is loaded upfront and every row of a is read before its row of r is written, so r may alias a or b
+      const __m128 b0 = _mm_loadu_ps(b);
+      const __m128 b1 = _mm_loadu_ps(b + 4);
+      const __m128 b2 = _mm_loadu_ps(b + 8);
+      const __m128 b3 = _mm_loadu_ps(b + 12);
+      for (int i = 0; i < 16; i += 4)
+      {
+         __m128 row = _mm_mul_ps(_mm_set1_ps(a[i]), b0);
+         row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 1]), b1));
+         row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 2]), b2));
+         row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 3]), b3));
+         _mm_storeu_ps(r + i, row);
+      }
+   }
+#endif
+
+   // r must not alias a or b
+   static void MatrixF_x_MatrixF_Scalar(const float *a, const float *b, float *r)
    {
       r[0] = a[0] * b[0] + a[1] * b[4] + a[2] * b[8] + a[3] * b[12];
       r[1] = a[0] * b[1] + a[1] * b[5] + a[2] * b[9] + a[3] * b[13];
@@ -91,6 +117,15 @@ namespace ImGuizmo
       r[15] = a[12] * b[3] + a[13] * b[7] + a[14] * b[11] + a[15] * b[15];
    }
 
+   void FPU_MatrixF_x_MatrixF(const float *a, const float *b, float *r)
+   {
+#if IMGUIZMO_SSE
+      MatrixF_x_MatrixF_SSE(a, b, r);
+#else
+      MatrixF_x_MatrixF_Scalar(a, b, r);
+#endif
+   }
+
    //template <typename T> T LERP(T x, T y, float z) { return (x + (y - x)*z); }
    template <typename T> T Clamp(T x, T y, T z) { return ((x<y) ? y : ((x>z) ? z : x)); }
    //template <typename T> T max(T x, T y) { return (x > y) ? x : y; }
@@ -304,25 +339,83 @@ namespace ImGuizmo
 
       void OrthoNormalize()
       {
+#if IMGUIZMO_SSE
+         OrthoNormalizeSSE();
+#else
+         OrthoNormalizeScalar();
+#endif
+      }
+#if IMGUIZMO_SSE
+      void OrthoNormalizeSSE()
+      {
+         for (int i = 0; i < 3; i++)
+         {
+            // same as vec_t::Normalize, length from xyz and all 4 components scaled
+            const __m128 row = _mm_loadu_ps(m16 + i * 4);
+            __m128 sq = _mm_mul_ps(row, row);
+            sq = _mm_add_ss(sq, _mm_add_ss(_mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2))));
+            const __m128 invLength = _mm_div_ss(_mm_set_ss(1.f), _mm_sqrt_ss(sq));
+            _mm_storeu_ps(m16 + i * 4, _mm_mul_ps(row, _mm_shuffle_ps(invLength, invLength, 0)));
+         }
+      }
+#endif
+      void OrthoNormalizeScalar()
+      {
          v.right.Normalize();
          v.up.Normalize();
          v.dir.Normalize();
       }
    };
 
-   void vec_t::Transform(const matrix_t& matrix)
+#if IMGUIZMO_SSE
+   // x * row0 + y * row1 + z * row2 (+ w * row3), rows of the matrix are the basis vectors
+   static inline __m128 TransformRows(const vec_t& vec, const matrix_t& matrix, bool point, bool vector)
    {
-      vec_t out;
+      __m128 out = _mm_mul_ps(_mm_set1_ps(vec.x), _mm_loadu_ps(matrix.m16));
+      out = _mm_add_ps(out, _mm_mul_ps(_mm_set1_ps(vec.y), _mm_loadu_ps(matrix.m16 + 4)));
+      out = _mm_add_ps(out, _mm_mul_ps(_mm_set1_ps(vec.z), _mm_loadu_ps(matrix.m16 + 8)));
+      if (point)
+         out = _mm_add_ps(out, _mm_loadu_ps(matrix.m16 + 12));
+      else if (!vector)
+         out = _mm_add_ps(out, _mm_mul_ps(_mm_set1_ps(vec.w), _mm_loadu_ps(matrix.m16 + 12)));
+      return out;
+   }
+#endif
 
-      out.x = x * matrix.m[0][0] + y * matrix.m[1][0] + z * matrix.m[2][0] + w * matrix.m[3][0];
-      out.y = x * matrix.m[0][1] + y * matrix.m[1][1] + z * matrix.m[2][1] + w * matrix.m[3][1];
-      out.z = x * matrix.m[0][2] + y * matrix.m[1][2] + z * matrix.m[2][2] + w * matrix.m[3][2];
-      out.w = x * matrix.m[0][3] + y * matrix.m[1][3] + z * matrix.m[2][3] + w * matrix.m[3][3];
+   static vec_t TransformRowsScalar(const vec_t& vec, const matrix_t& matrix, bool point, bool vector)
+   {
+      vec_t out;
+      if (point)
+      {
+         out.x = vec.x * matrix.m[0][0] + vec.y * matrix.m[1][0] + vec.z * matrix.m[2][0] + matrix.m[3][0];
+         out.y = vec.x * matrix.m[0][1] + vec.y * matrix.m[1][1] + vec.z * matrix.m[2][1] + matrix.m[3][1];
+         out.z = vec.x * matrix.m[0][2] + vec.y * matrix.m[1][2] + vec.z * matrix.m[2][2] + matrix.m[3][2];
+         out.w = vec.x * matrix.m[0][3] + vec.y * matrix.m[1][3] + vec.z * matrix.m[2][3] + matrix.m[3][3];
+      }
+      else if (vector)
+      {
+         out.x = vec.x * matrix.m[0][0] + vec.y * matrix.m[1][0] + vec.z * matrix.m[2][0];
+         out.y = vec.x * matrix.m[0][1] + vec.y * matrix.m[1][1] + vec.z * matrix.m[2][1];
+         out.z = vec.x * matrix.m[0][2] + vec.y * matrix.m[1][2] + vec.z * matrix.m[2][2];
+         out.w = vec.x * matrix.m[0][3] + vec.y * matrix.m[1][3] + vec.z * matrix.m[2][3];
+      }
+      else
+      {
+         out.x = vec.x * matrix.m[0][0] + vec.y * matrix.m[1][0] + vec.z * matrix.m[2][0] + vec.w * matrix.m[3][0];
+         out.y = vec.x * matrix.m[0][1] + vec.y * matrix.m[1][1] + vec.z * matrix.m[2][1] + vec.w * matrix.m[3][1];
+         out.z = vec.x * matrix.m[0][2] + vec.y * matrix.m[1][2] + vec.z * matrix.m[2][2] + vec.w * matrix.m[3][2];
+         out.w = vec.x * matrix.m[0][3] + vec.y * matrix.m[1][3] + vec.z * matrix.m[2][3] + vec.w * matrix.m[3][3];
+      }
+      return out;
+   }
 
-      x = out.x;
-      y = out.y;
-      z = out.z;
-      w = out.w;
+   void vec_t::Transform(const matrix_t& matrix)
+   {
+#if IMGUIZMO_SSE
+      _mm_storeu_ps(&x, TransformRows(*this, matrix, false, false));
+#else
+      *this = TransformRowsScalar(*this, matrix, false, false);
+#endif
    }
 
    void vec_t::Transform(const vec_t & s, const matrix_t& matrix)
@@ -333,33 +426,180 @@ namespace ImGuizmo
 
    void vec_t::TransformPoint(const matrix_t& matrix)
    {
-      vec_t out;
-
-      out.x = x * matrix.m[0][0] + y * matrix.m[1][0] + z * matrix.m[2][0] + matrix.m[3][0];
-      out.y = x * matrix.m[0][1] + y * matrix.m[1][1] + z * matrix.m[2][1] + matrix.m[3][1];
-      out.z = x * matrix.m[0][2] + y * matrix.m[1][2] + z * matrix.m[2][2] + matrix.m[3][2];
-      out.w = x * matrix.m[0][3] + y * matrix.m[1][3] + z * matrix.m[2][3] + matrix.m[3][3];
-
-      x = out.x;
-      y = out.y;
-      z = out.z;
-      w = out.w;
+#if IMGUIZMO_SSE
+      _mm_storeu_ps(&x, TransformRows(*this, matrix, true, false));
+#else
+      *this = TransformRowsScalar(*this, matrix, true, false);
+#endif
    }
 
 
    void vec_t::TransformVector(const matrix_t& matrix)
    {
-      vec_t out;
+#if IMGUIZMO_SSE
+      _mm_storeu_ps(&x, TransformRows(*this, matrix, false, true));
+#else
+      *this = TransformRowsScalar(*this, matrix, false, true);
+#endif
+   }
 
-      out.x = x * matrix.m[0][0] + y * matrix.m[1][0] + z * matrix.m[2][0];
-      out.y = x * matrix.m[0][1] + y * matrix.m[1][1] + z * matrix.m[2][1];
-      out.z = x * matrix.m[0][2] + y * matrix.m[1][2] + z * matrix.m[2][2];
-      out.w = x * matrix.m[0][3] + y * matrix.m[1][3] + z * matrix.m[2][3];
+#if IMGUIZMO_SSE
+   // Cramer's rule with SSE, same cofactor expansion as the scalar path (Intel AP-928). Returns the determinant.
+   static float InverseSSE(const float* src, float* dst)
+   {
+      __m128 minor0, minor1, minor2, minor3;
+      __m128 row0, row1, row2, row3;
+      __m128 det, tmp1;
+
+      // load and transpose, rows 1 and 3 come out with their halves swapped
+      tmp1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(src)), (const __m64*)(src + 4));
+      row1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(src + 8)), (const __m64*)(src + 12));
+      row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+      row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
+      tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (const __m64*)(src + 2)), (const __m64*)(src + 6));
+      row3 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(src + 10)), (const __m64*)(src + 14));
+      row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+      row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
+
+      tmp1 = _mm_mul_ps(row2, row3);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+      minor0 = _mm_mul_ps(row1, tmp1);
+      minor1 = _mm_mul_ps(row0, tmp1);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+      minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp1), minor0);
+      minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor1);
+      minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+      tmp1 = _mm_mul_ps(row1, row2);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+      minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor0);
+      minor3 = _mm_mul_ps(row0, tmp1);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+      minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp1));
+      minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor3);
+      minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+      tmp1 = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+      row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+      minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor0);
+      minor2 = _mm_mul_ps(row0, tmp1);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+      minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp1));
+      minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor2);
+      minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+      tmp1 = _mm_mul_ps(row0, row1);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+      minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor2);
+      minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp1), minor3);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+      minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp1), minor2);
+      minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp1));
+
+      tmp1 = _mm_mul_ps(row0, row3);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+      minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp1));
+      minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor2);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+      minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor1);
+      minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp1));
+
+      tmp1 = _mm_mul_ps(row0, row2);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+      minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor1);
+      minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp1));
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+      minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp1));
+      minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor3);
+
+      det = _mm_mul_ps(row0, minor0);
+      det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+      det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+      const float determinant = _mm_cvtss_f32(det);
+
+      // exact division rather than _mm_rcp_ss, the result has to match the scalar path
+      tmp1 = _mm_div_ss(_mm_set_ss(1.f), det);
+      tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x00);
+      _mm_storeu_ps(dst, _mm_mul_ps(tmp1, minor0));
+      _mm_storeu_ps(dst + 4, _mm_mul_ps(tmp1, minor1));
+      _mm_storeu_ps(dst + 8, _mm_mul_ps(tmp1, minor2));
+      _mm_storeu_ps(dst + 12, _mm_mul_ps(tmp1, minor3));
+      return determinant;
+   }
+#endif
 
-      x = out.x;
-      y = out.y;
-      z = out.z;
-      w = out.w;
+   static float InverseScalar(const float* srcMatrix, float* m16)
+   {
+      // transpose matrix
+      float src[16];
+      for (int i = 0; i < 4; ++i)
+      {
+         src[i] = srcMatrix[i * 4];
+         src[i + 4] = srcMatrix[i * 4 + 1];
+         src[i + 8] = srcMatrix[i * 4 + 2];
+         src[i + 12] = srcMatrix[i * 4 + 3];
+      }
+
+      // calculate pairs for first 8 elements (cofactors)
+      float tmp[12]; // temp array for pairs
+      tmp[0] = src[10] * src[15];
+      tmp[1] = src[11] * src[14];
+      tmp[2] = src[9] * src[15];
+      tmp[3] = src[11] * src[13];
+      tmp[4] = src[9] * src[14];
+      tmp[5] = src[10] * src[13];
+      tmp[6] = src[8] * src[15];
+      tmp[7] = src[11] * src[12];
+      tmp[8] = src[8] * src[14];
+      tmp[9] = src[10] * src[12];
+      tmp[10] = src[8] * src[13];
+      tmp[11] = src[9] * src[12];
+
+      // calculate first 8 elements (cofactors)
+      m16[0] = (tmp[0] * src[5] + tmp[3] * src[6] + tmp[4] * src[7]) - (tmp[1] * src[5] + tmp[2] * src[6] + tmp[5] * src[7]);
+      m16[1] = (tmp[1] * src[4] + tmp[6] * src[6] + tmp[9] * src[7]) - (tmp[0] * src[4] + tmp[7] * src[6] + tmp[8] * src[7]);
+      m16[2] = (tmp[2] * src[4] + tmp[7] * src[5] + tmp[10] * src[7]) - (tmp[3] * src[4] + tmp[6] * src[5] + tmp[11] * src[7]);
+      m16[3] = (tmp[5] * src[4] + tmp[8] * src[5] + tmp[11] * src[6]) - (tmp[4] * src[4] + tmp[9] * src[5] + tmp[10] * src[6]);
+      m16[4] = (tmp[1] * src[1] + tmp[2] * src[2] + tmp[5] * src[3]) - (tmp[0] * src[1] + tmp[3] * src[2] + tmp[4] * src[3]);
+      m16[5] = (tmp[0] * src[0] + tmp[7] * src[2] + tmp[8] * src[3]) - (tmp[1] * src[0] + tmp[6] * src[2] + tmp[9] * src[3]);
+      m16[6] = (tmp[3] * src[0] + tmp[6] * src[1] + tmp[11] * src[3]) - (tmp[2] * src[0] + tmp[7] * src[1] + tmp[10] * src[3]);
+      m16[7] = (tmp[4] * src[0] + tmp[9] * src[1] + tmp[10] * src[2]) - (tmp[5] * src[0] + tmp[8] * src[1] + tmp[11] * src[2]);
+
+      // calculate pairs for second 8 elements (cofactors)
+      tmp[0] = src[2] * src[7];
+      tmp[1] = src[3] * src[6];
+      tmp[2] = src[1] * src[7];
+      tmp[3] = src[3] * src[5];
+      tmp[4] = src[1] * src[6];
+      tmp[5] = src[2] * src[5];
+      tmp[6] = src[0] * src[7];
+      tmp[7] = src[3] * src[4];
+      tmp[8] = src[0] * src[6];
+      tmp[9] = src[2] * src[4];
+      tmp[10] = src[0] * src[5];
+      tmp[11] = src[1] * src[4];
+
+      // calculate second 8 elements (cofactors)
+      m16[8] = (tmp[0] * src[13] + tmp[3] * src[14] + tmp[4] * src[15]) - (tmp[1] * src[13] + tmp[2] * src[14] + tmp[5] * src[15]);
+      m16[9] = (tmp[1] * src[12] + tmp[6] * src[14] + tmp[9] * src[15]) - (tmp[0] * src[12] + tmp[7] * src[14] + tmp[8] * src[15]);
+      m16[10] = (tmp[2] * src[12] + tmp[7] * src[13] + tmp[10] * src[15]) - (tmp[3] * src[12] + tmp[6] * src[13] + tmp[11] * src[15]);
+      m16[11] = (tmp[5] * src[12] + tmp[8] * src[13] + tmp[11] * src[14]) - (tmp[4] * src[12] + tmp[9] * src[13] + tmp[10] * src[14]);
+      m16[12] = (tmp[2] * src[10] + tmp[5] * src[11] + tmp[1] * src[9]) - (tmp[4] * src[11] + tmp[0] * src[9] + tmp[3] * src[10]);
+      m16[13] = (tmp[8] * src[11] + tmp[0] * src[8] + tmp[7] * src[10]) - (tmp[6] * src[10] + tmp[9] * src[11] + tmp[1] * src[8]);
+      m16[14] = (tmp[6] * src[9] + tmp[11] * src[11] + tmp[3] * src[8]) - (tmp[10] * src[11] + tmp[2] * src[8] + tmp[7] * src[9]);
+      m16[15] = (tmp[10] * src[10] + tmp[4] * src[8] + tmp[9] * src[9]) - (tmp[8] * src[9] + tmp[11] * src[10] + tmp[5] * src[8]);
+
+      // calculate determinant
+      const float det = src[0] * m16[0] + src[1] * m16[1] + src[2] * m16[2] + src[3] * m16[3];
+
+      // calculate matrix inverse
+      float invdet = 1 / det;
+      for (int j = 0; j < 16; ++j)
+      {
+         m16[j] *= invdet;
+      }
+      return det;
    }
 
    float matrix_t::Inverse(const matrix_t &srcMatrix, bool affine)
@@ -385,74 +625,11 @@ namespace ImGuizmo
       }
       else
       {
-         // transpose matrix
-         float src[16];
-         for (int i = 0; i < 4; ++i)
-         {
-            src[i] = srcMatrix.m16[i * 4];
-            src[i + 4] = srcMatrix.m16[i * 4 + 1];
-            src[i + 8] = srcMatrix.m16[i * 4 + 2];
-            src[i + 12] = srcMatrix.m16[i * 4 + 3];
-         }
-
-         // calculate pairs for first 8 elements (cofactors)
-         float tmp[12]; // temp array for pairs
-         tmp[0] = src[10] * src[15];
-         tmp[1] = src[11] * src[14];
-         tmp[2] = src[9] * src[15];
-         tmp[3] = src[11] * src[13];
-         tmp[4] = src[9] * src[14];
-         tmp[5] = src[10] * src[13];
-         tmp[6] = src[8] * src[15];
-         tmp[7] = src[11] * src[12];
-         tmp[8] = src[8] * src[14];
-         tmp[9] = src[10] * src[12];
-         tmp[10] = src[8] * src[13];
-         tmp[11] = src[9] * src[12];
-
-         // calculate first 8 elements (cofactors)
-         m16[0] = (tmp[0] * src[5] + tmp[3] * src[6] + tmp[4] * src[7]) - (tmp[1] * src[5] + tmp[2] * src[6] + tmp[5] * src[7]);
-         m16[1] = (tmp[1] * src[4] + tmp[6] * src[6] + tmp[9] * src[7]) - (tmp[0] * src[4] + tmp[7] * src[6] + tmp[8] * src[7]);
-         m16[2] = (tmp[2] * src[4] + tmp[7] * src[5] + tmp[10] * src[7]) - (tmp[3] * src[4] + tmp[6] * src[5] + tmp[11] * src[7]);
-         m16[3] = (tmp[5] * src[4] + tmp[8] * src[5] + tmp[11] * src[6]) - (tmp[4] * src[4] + tmp[9] * src[5] + tmp[10] * src[6]);
-         m16[4] = (tmp[1] * src[1] + tmp[2] * src[2] + tmp[5] * src[3]) - (tmp[0] * src[1] + tmp[3] * src[2] + tmp[4] * src[3]);
-         m16[5] = (tmp[0] * src[0] + tmp[7] * src[2] + tmp[8] * src[3]) - (tmp[1] * src[0] + tmp[6] * src[2] + tmp[9] * src[3]);
-         m16[6] = (tmp[3] * src[0] + tmp[6] * src[1] + tmp[11] * src[3]) - (tmp[2] * src[0] + tmp[7] * src[1] + tmp[10] * src[3]);
-         m16[7] = (tmp[4] * src[0] + tmp[9] * src[1] + tmp[10] * src[2]) - (tmp[5] * src[0] + tmp[8] * src[1] + tmp[11] * src[2]);
-
-         // calculate pairs for second 8 elements (cofactors)
-         tmp[0] = src[2] * src[7];
-         tmp[1] = src[3] * src[6];
-         tmp[2] = src[1] * src[7];
-         tmp[3] = src[3] * src[5];
-         tmp[4] = src[1] * src[6];
-         tmp[5] = src[2] * src[5];
-         tmp[6] = src[0] * src[7];
-         tmp[7] = src[3] * src[4];
-         tmp[8] = src[0] * src[6];
-         tmp[9] = src[2] * src[4];
-         tmp[10] = src[0] * src[5];
-         tmp[11] = src[1] * src[4];
-
-         // calculate second 8 elements (cofactors)
-         m16[8] = (tmp[0] * src[13] + tmp[3] * src[14] + tmp[4] * src[15]) - (tmp[1] * src[13] + tmp[2] * src[14] + tmp[5] * src[15]);
-         m16[9] = (tmp[1] * src[12] + tmp[6] * src[14] + tmp[9] * src[15]) - (tmp[0] * src[12] + tmp[7] * src[14] + tmp[8] * src[15]);
-         m16[10] = (tmp[2] * src[12] + tmp[7] * src[13] + tmp[10] * src[15]) - (tmp[3] * src[12] + tmp[6] * src[13] + tmp[11] * src[15]);
-         m16[11] = (tmp[5] * src[12] + tmp[8] * src[13] + tmp[11] * src[14]) - (tmp[4] * src[12] + tmp[9] * src[13] + tmp[10] * src[14]);
-         m16[12] = (tmp[2] * src[10] + tmp[5] * src[11] + tmp[1] * src[9]) - (tmp[4] * src[11] + tmp[0] * src[9] + tmp[3] * src[10]);
-         m16[13] = (tmp[8] * src[11] + tmp[0] * src[8] + tmp[7] * src[10]) - (tmp[6] * src[10] + tmp[9] * src[11] + tmp[1] * src[8]);
-         m16[14] = (tmp[6] * src[9] + tmp[11] * src[11] + tmp[3] * src[8]) - (tmp[10] * src[11] + tmp[2] * src[8] + tmp[7] * src[9]);
-         m16[15] = (tmp[10] * src[10] + tmp[4] * src[8] + tmp[9] * src[9]) - (tmp[8] * src[9] + tmp[11] * src[10] + tmp[5] * src[8]);
-
-         // calculate determinant
-         det = src[0] * m16[0] + src[1] * m16[1] + src[2] * m16[2] + src[3] * m16[3];
-
-         // calculate matrix inverse
-         float invdet = 1 / det;
-         for (int j = 0; j < 16; ++j)
-         {
-            m16[j] *= invdet;
-         }
+#if IMGUIZMO_SSE
+         det = InverseSSE(srcMatrix.m16, m16);
+#else
+         det = InverseScalar(srcMatrix.m16, m16);
+#endif
       }
 
       return det;
@@ -605,6 +782,9 @@ namespace ImGuizmo
       bool mbUsingBounds;
       matrix_t mBoundsMatrix;
 
+      // ManipulateMany, pivot is kept while the gizmo is in use
+      matrix_t mBatchPivot;
+
       //
       int mCurrentOperation;
 
@@ -865,7 +1045,8 @@ namespace ImGuizmo
        ImColor selCol(selectionColor);
        ImVec4 selV(selCol);
        
-       static auto Lerp = [](const ImVec4& lhs, const ImVec4& rhs, float td) {
+       // ImU32 so both branches of the ?: below have the same type
+       static auto Lerp = [](const ImVec4& lhs, const ImVec4& rhs, float td) -> ImU32 {
            return ImColor(ImVec4(
                lhs.x + td * (rhs.x - lhs.x),
                lhs.y + td * (rhs.y - lhs.y),
@@ -2029,6 +2210,109 @@ namespace ImGuizmo
       }
    }
 
+   static void ComputeBatchPivot(const matrix_t* matrices, int count, MODE mode, matrix_t& pivot)
+   {
+      vec_t center = makeVect(0.f, 0.f, 0.f);
+      for (int i = 0; i < count; i++)
+         center += matrices[i].v.position;
+      center *= 1.f / float(count);
+
+      if (mode == LOCAL)
+      {
+         pivot = matrices[0];
+         pivot.OrthoNormalize();
+      }
+      else
+      {
+         pivot.SetToIdentity();
+      }
+      pivot.v.position.Set(center.x, center.y, center.z, 1.f);
+   }
+
+   // straight line per matrix, no branches in the loop body besides the pivot mode
+   static void ApplyBatchDelta(matrix_t* matrices, int count, const matrix_t& delta, const vec_t& pivotMove, PIVOT pivot)
+   {
+      for (int i = 0; i < count; i++)
+      {
+         matrix_t& mat = matrices[i];
+         mat.v.right.TransformVector(delta);
+         mat.v.up.TransformVector(delta);
+         mat.v.dir.TransformVector(delta);
+         if (pivot == PIVOT_CENTER)
+            mat.v.position.TransformPoint(delta);
+         else
+            mat.v.position += pivotMove;
+      }
+   }
+
+   bool ManipulateMany(const float *view, const float *projection, OPERATION operation, MODE mode, PIVOT pivot, float *matrices, int matrixCount, float *deltaMatrix, float *snap)
+   {
+      if (deltaMatrix)
+         ((matrix_t*)deltaMatrix)->SetToIdentity();
+      if (matrixCount <= 0)
+         return false;
+
+      matrix_t* batch = (matrix_t*)matrices;
+      if (!gContext->mbUsing)
+         ComputeBatchPivot(batch, matrixCount, mode, gContext->mBatchPivot);
+
+      const matrix_t pivotBefore = gContext->mBatchPivot;
+      Manipulate(view, projection, operation, mode, gContext->mBatchPivot.m16, NULL, snap);
+      if (!memcmp(pivotBefore.m16, gContext->mBatchPivot.m16, sizeof(float) * 16))
+         return false;
+
+      matrix_t pivotBeforeInverse;
+      pivotBeforeInverse.Inverse(pivotBefore);
+      const matrix_t delta = pivotBeforeInverse * gContext->mBatchPivot;
+      vec_t pivotMove = gContext->mBatchPivot.v.position - pivotBefore.v.position;
+      pivotMove.w = 0.f;
+      ApplyBatchDelta(batch, matrixCount, delta, pivotMove, pivot);
+
+      if (deltaMatrix)
+         *(matrix_t*)deltaMatrix = delta;
+      return true;
+   }
+
+   bool RunKernel(KERNEL kernel, bool simd, const float *a, const float *b, float *out, int count)
+   {
+#if IMGUIZMO_SSE
+      if (simd)
+      {
+         for (int i = 0; i < count; i++, a += 16, b += 16, out += 16)
+         {
+            switch (kernel)
+            {
+            case KERNEL_MULTIPLY: MatrixF_x_MatrixF_SSE(a, b, out); break;
+            case KERNEL_INVERSE: InverseSSE(a, out); break;
+            case KERNEL_TRANSFORM: _mm_storeu_ps(out, TransformRows(*(const vec_t*)a, *(const matrix_t*)b, false, false)); break;
+            case KERNEL_TRANSFORM_POINT: _mm_storeu_ps(out, TransformRows(*(const vec_t*)a, *(const matrix_t*)b, true, false)); break;
+            case KERNEL_TRANSFORM_VECTOR: _mm_storeu_ps(out, TransformRows(*(const vec_t*)a, *(const matrix_t*)b, false, true)); break;
+            case KERNEL_ORTHONORMALIZE: memcpy(out, a, sizeof(float) * 16); ((matrix_t*)out)->OrthoNormalizeSSE(); break;
+            default: return false;
+            }
+         }
+         return true;
+      }
+#else
+      if (simd)
+         return false;
+#endif
+      for (int i = 0; i < count; i++, a += 16, b += 16, out += 16)
+      {
+         switch (kernel)
+         {
+         case KERNEL_MULTIPLY: MatrixF_x_MatrixF_Scalar(a, b, out); break;
+         case KERNEL_INVERSE: InverseScalar(a, out); break;
+         case KERNEL_TRANSFORM: *(vec_t*)out = TransformRowsScalar(*(const vec_t*)a, *(const matrix_t*)b, false, false); break;
+         case KERNEL_TRANSFORM_POINT: *(vec_t*)out = TransformRowsScalar(*(const vec_t*)a, *(const matrix_t*)b, true, false); break;
+         case KERNEL_TRANSFORM_VECTOR: *(vec_t*)out = TransformRowsScalar(*(const vec_t*)a, *(const matrix_t*)b, false, true); break;
+         case KERNEL_ORTHONORMALIZE: memcpy(out, a, sizeof(float) * 16); ((matrix_t*)out)->OrthoNormalizeScalar(); break;
+         default: return false;
+         }
+      }
+      return true;
+   }
+
    void DrawCube(const float *view, const float *projection, float *matrix)
    {
       matrix_t viewInverse;
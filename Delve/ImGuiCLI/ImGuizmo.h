@@ -176,4 +176,14 @@ namespace ImGuizmo
 	};
 
 	IMGUI_API void Manipulate(const float *view, const float *projection, OPERATION operation, MODE mode, float *matrix, float *deltaMatrix = 0, float *snap = 0, float *localBounds = NULL, float *boundsSnap = NULL);
+
+	enum PIVOT
+	{
+		PIVOT_CENTER,       // rotate/scale around the center of all the matrices
+		PIVOT_INDIVIDUAL    // rotate/scale every matrix around its own origin
+	};
+
+	// manipulate a selection: the gizmo is placed on a pivot built from matrixCount matrices (16 floats each, contiguous)
+	// and the resulting delta is applied to all of them in place. Returns true if the matrices were modified this call.
+	IMGUI_API bool ManipulateMany(const float *view, const float *projection, OPERATION operation, MODE mode, PIVOT pivot, float *matrices, int matrixCount, float *deltaMatrix = 0, float *snap = 0);
 };
@@ -0,0 +1,21 @@
+// Internals of ImGuizmo.cpp for tests, not part of the API (see ImGuizmo.h)
+#pragma once
+
+namespace ImGuizmo
+{
+	// matrix/vector kernels behind the gizmo math, so tests can compare the SSE versions with the scalar ones and time them
+	enum KERNEL
+	{
+		KERNEL_MULTIPLY,            // out = a * b
+		KERNEL_INVERSE,             // out = inverse of a
+		KERNEL_TRANSFORM,           // out = a (4 components) * b
+		KERNEL_TRANSFORM_POINT,     // out = a (w = 1) * b
+		KERNEL_TRANSFORM_VECTOR,    // out = a (w = 0) * b
+		KERNEL_ORTHONORMALIZE,      // out = a with its first 3 rows normalized
+		KERNEL_COUNT
+	};
+
+	// run kernel count times, a, b and out hold count matrices of 16 floats (vectors are the first 4). simd picks the SSE versions, false is returned
+	// when they are compiled out: IMGUIZMO_DISABLE_SSE, no SSE on the target, or ImGuizmo.cpp built with /clr (ImGuiCLI.vcxproj builds it native).
+	bool RunKernel(KERNEL kernel, bool simd, const float *a, const float *b, float *out, int count);
+}
@@ -15,8 +15,17 @@ inline std::string ToSTLString(System::String^ str)
     return stlStr;
 }
 
+inline System::String^ FromUTF8(const char* str, size_t length)
+{
+    array<Byte>^ bytes = gcnew array<Byte>((int)length);
+    if (length > 0)
+        Marshal::Copy(IntPtr((void*)str), bytes, 0, (int)length);
+    return System::Text::Encoding::UTF8->GetString(bytes);
+}
+
 namespace ImGuiCLI
 {
+    void ParallelJobsRunner(int jobCount, void (*runJob)(int, void*), void* jobs, void*);
 
     TextEditor::TextEditor()
     {
@@ -30,7 +39,19 @@ namespace ImGuiCLI
 
     System::String^ TextEditor::Text::get()
     {
-        return gcnew System::String(editor_->GetText().c_str());
+        if (text_ != nullptr && !editor_->IsChangedSince(textVersion_))
+            return text_;
+
+        // Exported once straight into the managed array, then decoded
+        array<Byte>^ bytes = gcnew array<Byte>((int)editor_->GetText(nullptr, 0));
+        if (bytes->Length > 0)
+        {
+            pin_ptr<Byte> p = &bytes[0];
+            editor_->GetText((char*)p, bytes->Length);
+        }
+        text_ = System::Text::Encoding::UTF8->GetString(bytes);
+        textVersion_ = editor_->GetVersion();
+        return text_;
     }
     void TextEditor::Text::set(System::String^ txt)
     {
@@ -38,7 +59,42 @@ namespace ImGuiCLI
     }
     System::String^ TextEditor::SelectedText::get()
     {
-        return gcnew System::String(editor_->GetSelectedText().c_str());
+        auto text = editor_->GetSelectedText();
+        return FromUTF8(text.data(), text.size());
+    }
+    unsigned int TextEditor::Version::get()
+    {
+        return editor_->GetVersion();
+    }
+    bool TextEditor::ChangedSince(unsigned int version)
+    {
+        return editor_->IsChangedSince(version);
+    }
+
+    bool TextEditor::LoadFile(System::String^ path)
+    {
+        return editor_->LoadFile(ToSTLString(path).c_str(), ParallelJobsRunner);
+    }
+    void TextEditor::ReleaseFile()
+    {
+        editor_->ReleaseFile();
+    }
+
+    bool TextEditor::SetSearch(System::String^ pattern, bool caseSensitive, bool regex)
+    {
+        return editor_->SetSearch(ToSTLString(pattern), caseSensitive, regex);
+    }
+    bool TextEditor::FindNext(bool backwards)
+    {
+        return editor_->FindNext(backwards);
+    }
+    bool TextEditor::Replace(System::String^ with)
+    {
+        return editor_->Replace(ToSTLString(with));
+    }
+    int TextEditor::ReplaceAll(System::String^ with)
+    {
+        return editor_->ReplaceAll(ToSTLString(with));
     }
 
     bool TextEditor::IsReadOnly::get() { return editor_->IsReadOnly(); }
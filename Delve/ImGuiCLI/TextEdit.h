@@ -23,15 +23,32 @@ namespace ImGuiCLI
         TextEditor();
         ~TextEditor();
 
+        /// The string is kept until the text changes, reading Text every frame doesn't copy it out of the editor again.
         property System::String^ Text { System::String^ get(); void set(System::String^); }
         property System::String^ SelectedText { System::String^ get(); }
+        /// Changes with every edit, a caller holding a copy of Text from Version v only needs to read it again when ChangedSince(v).
+        property unsigned int Version { unsigned int get(); }
+        bool ChangedSince(unsigned int version);
         property bool IsReadOnly { bool get(); void set(bool); }
 
         void SetLanguage(TextEditorLang);
+        /// Opens a file without copying it, lines are read from the mapped file when shown or edited. Returns false if the file can't be opened.
+        /// The file stays mapped until ReleaseFile(), setting Text or the next LoadFile().
+        bool LoadFile(System::String^ path);
+        /// Reads the lines still in the mapped file into the editor and closes it, call it before saving over the file.
+        void ReleaseFile();
+
+        /// Searches the native line storage, matches are highlighted. Returns false for an invalid regex, an empty pattern ends the search.
+        bool SetSearch(System::String^ pattern, bool caseSensitive, bool regex);
+        bool FindNext(bool backwards);
+        bool Replace(System::String^ with);
+        int ReplaceAll(System::String^ with);
         void Render(System::String^ title, Vector2 size, bool border);
 
     private:
         ::TextEditor* editor_;
+        System::String^ text_;
+        unsigned int textVersion_;
     };
 
 }
\ No newline at end of file
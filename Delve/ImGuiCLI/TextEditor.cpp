@@ -1,11 +1,25 @@
 #include <algorithm>
 #include <chrono>
+#include <climits>
 #include <string>
+#include <string.h>
 #include <regex>
 
 #include "TextEditor.h"
 #include "imgui_internal.h"
 
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #undef max
 #undef min
 
@@ -29,6 +43,7 @@ TextEditor::TextEditor()
 	, mColorRangeMin(0)
 	, mColorRangeMax(0)
 	, mCheckMultilineComments(true)
+	, mVersion(0)
 {
 	SetPalette(GetDarkPalette());
 	SetLanguageDefinition(LanguageDefinition::HLSL());
@@ -40,6 +55,353 @@ TextEditor::~TextEditor()
 {
 }
 
+// Multi-line comment and string state machine of ColorizeInternal() over one line, aCharAt(n) gives the character at column n and aSetFlag(n, inComment) receives the flags.
+// The state carries over to the next line, aSkipFirst is set when the line ends with a '\\' in a string, which skips the first character of the next line.
+// When no flags are needed, aStops may tell the characters that can change the state, the others are skipped.
+template <typename CharAt, typename SetFlag>
+static void ScanMultiLineComments(int aSize, CharAt aCharAt, SetFlag aSetFlag, const std::string& aStartStr, const std::string& aEndStr, bool& aInComment, bool& aInString, bool& aSkipFirst, const bool* aStops = nullptr)
+{
+	auto matches = [&](const std::string& aStr, int aColumn)
+	{
+		for (size_t j = 0; j < aStr.size(); ++j)
+			if (aCharAt(aColumn + (int)j) != aStr[j])
+				return false;
+		return true;
+	};
+
+	int column = aSkipFirst ? 1 : 0;
+	aSkipFirst = false;
+	for (; column < aSize; ++column)
+	{
+		if (aStops)
+		{
+			while (column < aSize && !aStops[(unsigned char)aCharAt(column)])
+				++column;
+			if (column == aSize)
+				break;
+		}
+
+		auto c = aCharAt(column);
+		bool inComment = aInComment;
+
+		if (aInString)
+		{
+			aSetFlag(column, inComment);
+
+			if (c == '\"')
+			{
+				if (column + 1 < aSize && aCharAt(column + 1) == '\"')
+					aSetFlag(++column, inComment);
+				else
+					aInString = false;
+			}
+			else if (c == '\\')
+			{
+				if (column + 1 < aSize)
+					aSetFlag(++column, inComment);
+				else
+				{
+					aSetFlag(0, inComment);
+					aSkipFirst = true;
+				}
+			}
+		}
+		else
+		{
+			if (c == '\"')
+			{
+				aInString = true;
+				aSetFlag(column, inComment);
+			}
+			else
+			{
+				if (column + (int)aStartStr.size() <= aSize && matches(aStartStr, column))
+					aInComment = true;
+
+				inComment = aInComment;
+
+				aSetFlag(column, inComment);
+
+				if (column + 1 >= (int)aEndStr.size() && matches(aEndStr, column + 1 - (int)aEndStr.size()))
+					aInComment = false;
+			}
+		}
+	}
+}
+
+static bool EqualsLowerCase(const char* aText, const char* aLowerCase, size_t aCount)
+{
+	for (size_t i = 0; i < aCount; ++i)
+	{
+		char c = aText[i];
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		if (c != aLowerCase[i])
+			return false;
+	}
+	return true;
+}
+
+// First occurrence of aPattern in [aBegin, aEnd), or nullptr. The candidates come from memchr() on the first character, which the C runtimes vectorize.
+// When not case sensitive aPattern is in lower case, and the ASCII letters of the text match it in either case.
+static const char* FindLiteral(const char* aBegin, const char* aEnd, const std::string& aPattern, bool aCaseSensitive)
+{
+	const size_t count = aPattern.size();
+	if (count == 0 || (size_t)(aEnd - aBegin) < count)
+		return nullptr;
+
+	const char* last = aEnd - count;
+	const char first = aPattern[0];
+	const char firstUpper = !aCaseSensitive && first >= 'a' && first <= 'z' ? first - ('a' - 'A') : first;
+	for (const char* p = aBegin; p <= last; ++p)
+	{
+		if (firstUpper == first)
+		{
+			p = (const char*)memchr(p, first, last - p + 1);
+			if (p == nullptr)
+				return nullptr;
+		}
+		else
+		{
+			// Both cases, a block at a time so that the rarer one isn't searched to the end for every candidate of the other
+			const char* found = nullptr;
+			while (found == nullptr && p <= last)
+			{
+				size_t block = std::min<size_t>(last - p + 1, 4096);
+				const char* lower = (const char*)memchr(p, first, block);
+				const char* upper = (const char*)memchr(p, firstUpper, lower != nullptr ? lower - p : block);
+				found = upper != nullptr ? upper : lower;
+				if (found == nullptr)
+					p += block;
+			}
+			if (found == nullptr)
+				return nullptr;
+			p = found;
+		}
+
+		if (aCaseSensitive ? memcmp(p + 1, aPattern.data() + 1, count - 1) == 0 : EqualsLowerCase(p + 1, aPattern.data() + 1, count - 1))
+			return p;
+	}
+	return nullptr;
+}
+
+// Read-only view of a whole file
+struct TextEditor::FileMapping
+{
+	const char* mData;
+	size_t mSize;
+#ifdef _WIN32
+	HANDLE mFile;
+	HANDLE mMapping;
+#else
+	int mFile;
+#endif
+
+	FileMapping() : mData(nullptr), mSize(0)
+#ifdef _WIN32
+		, mFile(INVALID_HANDLE_VALUE), mMapping(NULL)
+#else
+		, mFile(-1)
+#endif
+	{}
+
+	~FileMapping()
+	{
+#ifdef _WIN32
+		if (mData)
+			UnmapViewOfFile(mData);
+		if (mMapping)
+			CloseHandle(mMapping);
+		if (mFile != INVALID_HANDLE_VALUE)
+			CloseHandle(mFile);
+#else
+		if (mData)
+			munmap((void*)mData, mSize);
+		if (mFile != -1)
+			close(mFile);
+#endif
+	}
+
+	bool Open(const char* aPath)
+	{
+#ifdef _WIN32
+		// aPath is UTF-8
+		int wpathLength = MultiByteToWideChar(CP_UTF8, 0, aPath, -1, NULL, 0);
+		std::vector<wchar_t> wpath(wpathLength > 0 ? wpathLength : 1, 0);
+		MultiByteToWideChar(CP_UTF8, 0, aPath, -1, wpath.data(), (int)wpath.size());
+		// Other programs may still rename, delete or save the file, see ReleaseFile()
+		mFile = CreateFileW(wpath.data(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		LARGE_INTEGER size;
+		if (mFile == INVALID_HANDLE_VALUE || !GetFileSizeEx(mFile, &size))
+			return false;
+		mSize = (size_t)size.QuadPart;
+		if (mSize == 0)
+			return true;
+		mMapping = CreateFileMappingW(mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mMapping)
+			mData = (const char*)MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+#else
+		mFile = open(aPath, O_RDONLY);
+		struct stat st;
+		if (mFile == -1 || fstat(mFile, &st) != 0)
+			return false;
+		mSize = (size_t)st.st_size;
+		if (mSize == 0)
+			return true;
+		void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mFile, 0);
+		if (data != MAP_FAILED)
+			mData = (const char*)data;
+#endif
+		return mData != nullptr;
+	}
+};
+
+// Lines are indexed in three passes over mJobCount chunks: new lines are counted per chunk of the file, then the line offsets are written, then their lengths per chunk of lines
+struct TextEditor::LineIndexJobs
+{
+	const char* mData;
+	size_t mSize;
+	int mJobCount;
+	int mPass;
+	std::vector<size_t> mFirstLines;	// Index of the first line starting in each chunk of the file
+	std::vector<LineSource>* mLines;
+};
+
+void TextEditor::RunLineIndexJob(int aJobIndex, void* aJobs)
+{
+	auto& jobs = *(LineIndexJobs*)aJobs;
+	const char* data = jobs.mData;
+	if (jobs.mPass < 2)
+	{
+		const char* s = data + jobs.mSize * aJobIndex / jobs.mJobCount;
+		const char* end = data + jobs.mSize * (aJobIndex + 1) / jobs.mJobCount;
+		size_t line = jobs.mFirstLines[aJobIndex];
+		while (s < end && (s = (const char*)memchr(s, '\n', (size_t)(end - s))) != nullptr)
+		{
+			++s;
+			++line;
+			if (jobs.mPass == 1)
+				(*jobs.mLines)[line].mOffset = (size_t)(s - data);
+		}
+		if (jobs.mPass == 0)
+			jobs.mFirstLines[aJobIndex] = line;
+	}
+	else
+	{
+		auto& lines = *jobs.mLines;
+		size_t first = lines.size() * aJobIndex / jobs.mJobCount;
+		size_t last = lines.size() * (aJobIndex + 1) / jobs.mJobCount;
+		for (size_t i = first; i < last; ++i)
+		{
+			size_t end = i + 1 < lines.size() ? lines[i + 1].mOffset - 1 : jobs.mSize;
+			if (end > lines[i].mOffset && data[end - 1] == '\r')
+				--end;
+			lines[i].mLength = (int)(end - lines[i].mOffset);
+		}
+	}
+}
+
+bool TextEditor::LoadFile(const char* aPath, void (*aJobsRunner)(int aJobCount, void (*aRunJob)(int aJobIndex, void* aJobs), void* aJobs, void* aUserData), void* aJobsRunnerUserData)
+{
+	std::unique_ptr<FileMapping> file(new FileMapping());
+	if (!file->Open(aPath))
+		return false;
+
+	UnloadFile();
+	mLines.clear();
+	OnLinesChanged();
+	mUndoBuffer.clear();
+	mUndoIndex = 0;
+	mState = EditorState();
+	mInteractiveStart = mInteractiveEnd = Coordinates();
+
+	LineIndexJobs jobs;
+	jobs.mData = file->mData;
+	jobs.mSize = file->mSize;
+	jobs.mJobCount = (int)std::min<size_t>(64, file->mSize / (1 << 20) + 1);
+	jobs.mFirstLines.assign(jobs.mJobCount, 0);
+	jobs.mLines = &mLineSources;
+	for (jobs.mPass = 0; jobs.mPass < 3; ++jobs.mPass)
+	{
+		if (jobs.mPass == 1)
+		{
+			// Turn the new line counts into the index of the first line of each chunk
+			size_t lineCount = 1;
+			for (auto& count : jobs.mFirstLines)
+			{
+				size_t chunkLines = count;
+				count = lineCount - 1;
+				lineCount += chunkLines;
+			}
+			mLineSources.resize(lineCount);
+			mLineSources[0].mOffset = 0;
+		}
+		if (aJobsRunner && jobs.mJobCount > 1)
+			aJobsRunner(jobs.mJobCount, RunLineIndexJob, &jobs, aJobsRunnerUserData);
+		else
+			for (int i = 0; i < jobs.mJobCount; ++i)
+				RunLineIndexJob(i, &jobs);
+	}
+
+	mLines.resize(mLineSources.size());
+	mFile = std::move(file);
+	Colorize();
+	return true;
+}
+
+void TextEditor::ReleaseFile()
+{
+	if (!mFile)
+		return;
+	for (int i = 0; i < (int)mLines.size(); ++i)
+		if (!IsLineLoaded(i))
+			LoadLine(i);
+	UnloadFile();
+}
+
+void TextEditor::UnloadFile()
+{
+	mLineSources.clear();
+	mFile.reset();
+}
+
+void TextEditor::LoadLine(int aIndex)
+{
+	auto& source = mLineSources[aIndex];
+	auto& line = mLines[aIndex];
+	const char* chars = mFile->mData + source.mOffset;
+	line.reserve(source.mLength);
+	for (int i = 0; i < source.mLength; ++i)
+		line.push_back(Glyph(chars[i], PaletteIndex::Default));
+	source.mLength = -1;
+
+	// The multi-line comment flags come from the state ColorizeInternal() left at the start of the line
+	bool inComment = source.mInComment, inString = source.mInString, skipFirst = source.mSkipFirst;
+	ScanMultiLineComments((int)line.size(), [&](int n) { return line[n].mChar; }, [&](int n, bool c) { line[n].mMultiLineComment = c; },
+		mLanguageDefinition.mCommentStart, mLanguageDefinition.mCommentEnd, inComment, inString, skipFirst);
+	ColorizeRange(aIndex, aIndex + 1);
+}
+
+TextEditor::Line& TextEditor::GetLine(int aIndex)
+{
+	if (!IsLineLoaded(aIndex))
+		LoadLine(aIndex);
+	return mLines[aIndex];
+}
+
+const TextEditor::Line& TextEditor::GetLine(int aIndex) const
+{
+	// Creating the glyphs of a line doesn't change the document
+	if (!IsLineLoaded(aIndex))
+		const_cast<TextEditor*>(this)->LoadLine(aIndex);
+	return mLines[aIndex];
+}
+
+int TextEditor::GetLineLength(int aIndex) const
+{
+	return IsLineLoaded(aIndex) ? (int)mLines[aIndex].size() : mLineSources[aIndex].mLength;
+}
+
 void TextEditor::SetLanguageDefinition(const LanguageDefinition & aLanguageDef)
 {
 	mLanguageDefinition = aLanguageDef;
@@ -73,23 +435,53 @@ int TextEditor::AppendBuffer(std::string& aBuffer, char chr, int aIndex)
 std::string TextEditor::GetText(const Coordinates & aStart, const Coordinates & aEnd) const
 {
 	std::string result;
+	result.resize(CopyText(aStart, aEnd, nullptr));
+	if (!result.empty())
+		CopyText(aStart, aEnd, &result[0]);
+	return result;
+}
+
+// Only adds up the line lengths when aBuffer is null, so the text can be sized before it is copied
+size_t TextEditor::CopyText(const Coordinates & aStart, const Coordinates & aEnd, char* aBuffer) const
+{
+	size_t size = 0;
 
-	int prevLineNo = aStart.mLine;
-	for (auto it = aStart; it <= aEnd; Advance(it))
+	// Lines without glyphs are copied from the file
+	int lastLine = std::min(aEnd.mLine, (int)mLines.size() - 1);
+	for (int lineNo = aStart.mLine; lineNo <= lastLine && aStart <= aEnd; ++lineNo)
 	{
-		if (prevLineNo != it.mLine && it.mLine < (int) mLines.size())
-			result.push_back('\n');
+		if (lineNo != aStart.mLine)
+		{
+			if (aBuffer)
+				aBuffer[size] = '\n';
+			++size;
+		}
 
-		if (it == aEnd)
-			break;
+		int first = lineNo == aStart.mLine ? aStart.mColumn : 0;
+		int last = GetLineLength(lineNo);
+		if (lineNo == aEnd.mLine)
+			last = std::min(last, aEnd.mColumn);
+		if (first >= last)
+			continue;
 
-		prevLineNo = it.mLine;
-		const auto& line = mLines[it.mLine];
-		if (!line.empty() && it.mColumn < (int)line.size())
-			result.push_back(line[it.mColumn].mChar);
+		if (aBuffer)
+		{
+			char* out = aBuffer + size;
+			if (!IsLineLoaded(lineNo))
+			{
+				memcpy(out, mFile->mData + mLineSources[lineNo].mOffset + first, (size_t)(last - first));
+			}
+			else
+			{
+				const Glyph* glyph = mLines[lineNo].data();
+				for (int i = first; i < last; ++i)
+					*out++ = glyph[i].mChar;
+			}
+		}
+		size += (size_t)(last - first);
 	}
 
-	return result;
+	return size;
 }
 
 TextEditor::Coordinates TextEditor::GetActualCursorCoordinates() const
@@ -100,7 +492,7 @@ TextEditor::Coordinates TextEditor::GetActualCursorCoordinates() const
 TextEditor::Coordinates TextEditor::SanitizeCoordinates(const Coordinates & aValue) const
 {
 	auto line = std::max(0, std::min((int)mLines.size() - 1, aValue.mLine));
-	auto column = mLines.empty() ? 0 : std::min((int)mLines[line].size(), aValue.mColumn);
+	auto column = mLines.empty() ? 0 : std::min(GetLineLength(line), aValue.mColumn);
 	return Coordinates(line, column);
 }
 
@@ -108,9 +500,7 @@ void TextEditor::Advance(Coordinates & aCoordinates) const
 {
 	if (aCoordinates.mLine < (int)mLines.size())
 	{
-		auto& line = mLines[aCoordinates.mLine];
-
-		if (aCoordinates.mColumn + 1 < (int)line.size())
+		if (aCoordinates.mColumn + 1 < GetLineLength(aCoordinates.mLine))
 			++aCoordinates.mColumn;
 		else
 		{
@@ -130,7 +520,8 @@ void TextEditor::DeleteRange(const Coordinates & aStart, const Coordinates & aEn
 
 	if (aStart.mLine == aEnd.mLine)
 	{
-		auto& line = mLines[aStart.mLine];
+		OnLineChanged(aStart.mLine);
+		auto& line = GetLine(aStart.mLine);
 		if (aEnd.mColumn >= (int)line.size())
 			line.erase(line.begin() + aStart.mColumn, line.end());
 		else
@@ -138,8 +529,8 @@ void TextEditor::DeleteRange(const Coordinates & aStart, const Coordinates & aEn
 	}
 	else
 	{
-		auto& firstLine = mLines[aStart.mLine];
-		auto& lastLine = mLines[aEnd.mLine];
+		auto& firstLine = GetLine(aStart.mLine);
+		auto& lastLine = GetLine(aEnd.mLine);
 
 		firstLine.erase(firstLine.begin() + aStart.mColumn, firstLine.end());
 		lastLine.erase(lastLine.begin(), lastLine.begin() + aEnd.mColumn);
@@ -169,10 +560,10 @@ int TextEditor::InsertTextAt(Coordinates& /* inout */ aWhere, const char * aValu
 		}
 		else if (chr == '\n')
 		{
-			if (aWhere.mColumn < (int)mLines[aWhere.mLine].size())
+			if (aWhere.mColumn < GetLineLength(aWhere.mLine))
 			{
 				auto& newLine = InsertLine(aWhere.mLine + 1);
-				auto& line = mLines[aWhere.mLine];
+				auto& line = GetLine(aWhere.mLine);
 				newLine.insert(newLine.begin(), line.begin() + aWhere.mColumn, line.end());
 				line.erase(line.begin() + aWhere.mColumn, line.end());
 			}
@@ -186,13 +577,16 @@ int TextEditor::InsertTextAt(Coordinates& /* inout */ aWhere, const char * aValu
 		}
 		else
 		{
-			auto& line = mLines[aWhere.mLine];
+			auto& line = GetLine(aWhere.mLine);
 			line.insert(line.begin() + aWhere.mColumn, Glyph(chr, PaletteIndex::Default));
 			++aWhere.mColumn;
 		}
 		chr = *(++aValue);
 	}
 
+	// A line break has already dropped them all
+	if (totalLines == 0)
+		OnLineChanged(aWhere.mLine);
 	return totalLines;
 }
 
@@ -210,28 +604,19 @@ TextEditor::Coordinates TextEditor::ScreenPosToCoordinates(const ImVec2& aPositi
 	ImVec2 origin = ImGui::GetCursorScreenPos();
 	ImVec2 local(aPosition.x - origin.x, aPosition.y - origin.y);
 
-	int lineNo = std::max(0, (int)floor(local.y / mCharAdvance.y));
+	// Clamped before converting, ImGui::GetMousePos() is -FLT_MAX while the mouse is unavailable and far away positions don't fit an int
+	const float cMaxCoordinate = (float)(INT_MAX / 2);
+	int lineNo = (int)ImClamp(floorf(local.y / mCharAdvance.y), 0.0f, cMaxCoordinate);
     float fPos = local.x / mCharAdvance.x - cTextStart;
     float frac = fPos - floorf(fPos);
 
-	int columnCoord = std::max(0, (int)floor(local.x / mCharAdvance.x) - cTextStart);
+	int columnCoord = (int)ImClamp(floorf(local.x / mCharAdvance.x) - cTextStart, 0.0f, cMaxCoordinate);
     if (frac > 0.5f)
         columnCoord += 1;
 
 	int column = 0;
 	if (lineNo >= 0 && lineNo < (int)mLines.size())
-	{
-		auto& line = mLines[lineNo];
-		auto distance = 0;
-		while (distance < columnCoord && column < (int)line.size())
-		{
-			if (line[column].mChar == '\t')
-				distance = (distance / mTabSize) * mTabSize + mTabSize;
-			else
-				++distance;
-			++column;
-		}
-	}
+		column = VisualColumnToColumn(lineNo, columnCoord);
 	return Coordinates(lineNo, column);
 }
 
@@ -241,7 +626,7 @@ TextEditor::Coordinates TextEditor::FindWordStart(const Coordinates & aFrom) con
 	if (at.mLine >= (int)mLines.size())
 		return at;
 
-	auto& line = mLines[at.mLine];
+	auto& line = GetLine(at.mLine);
 
 	if (at.mColumn >= (int)line.size())
 		return at;
@@ -262,7 +647,7 @@ TextEditor::Coordinates TextEditor::FindWordEnd(const Coordinates & aFrom) const
 	if (at.mLine >= (int)mLines.size())
 		return at;
 
-	auto& line = mLines[at.mLine];
+	auto& line = GetLine(at.mLine);
 
 	if (at.mColumn >= (int)line.size())
 		return at;
@@ -282,63 +667,247 @@ bool TextEditor::IsOnWordBoundary(const Coordinates & aAt) const
 	if (aAt.mLine >= (int)mLines.size() || aAt.mColumn == 0)
 		return true;
 
-	auto& line = mLines[aAt.mLine];
+	auto& line = GetLine(aAt.mLine);
 	if (aAt.mColumn >= (int)line.size())
 		return true;
 
 	return line[aAt.mColumn].mColorIndex != line[aAt.mColumn - 1].mColorIndex;
 }
 
-void TextEditor::RemoveLine(int aStart, int aEnd)
+template <typename T>
+void TextEditor::LineMarkers<T>::Clear()
 {
-	assert(!mReadOnly);
+	mNodes.clear();
+	mFreeNodes.clear();
+	mRoot = -1;
+}
+
+template <typename T>
+void TextEditor::LineMarkers<T>::Push(int aNode)
+{
+	auto& node = mNodes[aNode];
+	if (node.mOffset == 0)
+		return;
+	if (node.mLeft >= 0)
+		mNodes[node.mLeft].mOffset += node.mOffset;
+	if (node.mRight >= 0)
+		mNodes[node.mRight].mOffset += node.mOffset;
+	node.mLine += node.mOffset;
+	node.mOffset = 0;
+}
 
-	ErrorMarkers etmp;
-	for (auto& i : mErrorMarkers)
+// aBefore gets the lines before aLine, aAfter aLine and the ones after
+template <typename T>
+void TextEditor::LineMarkers<T>::Split(int aNode, int aLine, int& aBefore, int& aAfter)
+{
+	if (aNode < 0)
 	{
-		ErrorMarkers::value_type e(i.first >= aStart ? i.first - 1 : i.first, i.second);
-		if (e.first >= aStart && e.first <= aEnd)
-			continue;
-		etmp.insert(e);
+		aBefore = aAfter = -1;
+		return;
 	}
-	mErrorMarkers = std::move(etmp);
 
-	Breakpoints btmp;
-	for (auto i : mBreakpoints)
+	Push(aNode);
+	if (mNodes[aNode].mLine < aLine)
 	{
-		if (i >= aStart && i <= aEnd)
-			continue;
-		btmp.insert(i >= aStart ? i - 1 : i);
+		int right;
+		Split(mNodes[aNode].mRight, aLine, right, aAfter);
+		mNodes[aNode].mRight = right;
+		aBefore = aNode;
+	}
+	else
+	{
+		int left;
+		Split(mNodes[aNode].mLeft, aLine, aBefore, left);
+		mNodes[aNode].mLeft = left;
+		aAfter = aNode;
 	}
-	mBreakpoints = std::move(btmp);
+}
 
-	mLines.erase(mLines.begin() + aStart, mLines.begin() + aEnd);
+// All the lines of aBefore must come before the ones of aAfter
+template <typename T>
+int TextEditor::LineMarkers<T>::Merge(int aBefore, int aAfter)
+{
+	if (aBefore < 0 || aAfter < 0)
+		return aBefore < 0 ? aAfter : aBefore;
+
+	if (mNodes[aBefore].mPriority > mNodes[aAfter].mPriority)
+	{
+		Push(aBefore);
+		int right = Merge(mNodes[aBefore].mRight, aAfter);
+		mNodes[aBefore].mRight = right;
+		return aBefore;
+	}
+	Push(aAfter);
+	int left = Merge(aBefore, mNodes[aAfter].mLeft);
+	mNodes[aAfter].mLeft = left;
+	return aAfter;
 }
 
-void TextEditor::RemoveLine(int aIndex)
+template <typename T>
+void TextEditor::LineMarkers<T>::Insert(int aLine, const T& aValue)
 {
-	assert(!mReadOnly);
+	int before, at, after;
+	Split(mRoot, aLine, before, after);
+	Split(after, aLine + 1, at, after);
+	if (at < 0)
+	{
+		if (mFreeNodes.empty())
+		{
+			at = (int)mNodes.size();
+			mNodes.emplace_back();
+		}
+		else
+		{
+			at = mFreeNodes.back();
+			mFreeNodes.pop_back();
+		}
+		mSeed ^= mSeed << 13;
+		mSeed ^= mSeed >> 17;
+		mSeed ^= mSeed << 5;
+		auto& node = mNodes[at];
+		node.mLine = aLine;
+		node.mOffset = 0;
+		node.mPriority = mSeed;
+		node.mLeft = node.mRight = -1;
+	}
+	mNodes[at].mValue = aValue;
+	mRoot = Merge(Merge(before, at), after);
+}
 
-	ErrorMarkers etmp;
-	for (auto& i : mErrorMarkers)
+template <typename T>
+const T* TextEditor::LineMarkers<T>::Find(int aLine) const
+{
+	int offset = 0;
+	for (int n = mRoot; n >= 0; )
 	{
-		ErrorMarkers::value_type e(i.first >= aIndex ? i.first - 1 : i.first, i.second);
-		if (e.first == aIndex)
-			continue;
-		etmp.insert(e);
+		auto& node = mNodes[n];
+		offset += node.mOffset;
+		if (node.mLine + offset == aLine)
+			return &node.mValue;
+		n = aLine < node.mLine + offset ? node.mLeft : node.mRight;
 	}
-	mErrorMarkers = std::move(etmp);
+	return nullptr;
+}
+
+template <typename T>
+void TextEditor::LineMarkers<T>::Erase(int aFirst, int aLast)
+{
+	if (aFirst >= aLast)
+		return;
 
-	Breakpoints btmp;
-	for (auto i : mBreakpoints)
+	int before, erased, after;
+	Split(mRoot, aFirst, before, after);
+	Split(after, aLast, erased, after);
+	for (std::vector<int> stack(erased >= 0 ? 1 : 0, erased); !stack.empty(); )
 	{
-		if (i == aIndex)
-			continue;
-		btmp.insert(i >= aIndex ? i - 1 : i);
+		int n = stack.back();
+		stack.pop_back();
+		if (mNodes[n].mLeft >= 0)
+			stack.push_back(mNodes[n].mLeft);
+		if (mNodes[n].mRight >= 0)
+			stack.push_back(mNodes[n].mRight);
+		mNodes[n].mValue = T();
+		mFreeNodes.push_back(n);
 	}
-	mBreakpoints = std::move(btmp);
+	mRoot = Merge(before, after);
+}
+
+template <typename T>
+void TextEditor::LineMarkers<T>::Shift(int aFirst, int aDelta)
+{
+	int before, after;
+	Split(mRoot, aFirst, before, after);
+	if (after >= 0)
+		mNodes[after].mOffset += aDelta;
+	mRoot = Merge(before, after);
+}
+
+template <typename T>
+template <typename Fn>
+void TextEditor::LineMarkers<T>::Visit(int aNode, int aOffset, int aFirst, int aLast, Fn& aFn) const
+{
+	if (aNode < 0)
+		return;
+
+	auto& node = mNodes[aNode];
+	aOffset += node.mOffset;
+	int line = node.mLine + aOffset;
+	if (line > aFirst)
+		Visit(node.mLeft, aOffset, aFirst, aLast, aFn);
+	if (line >= aFirst && line < aLast)
+		aFn(line, node.mValue);
+	if (line < aLast - 1)
+		Visit(node.mRight, aOffset, aFirst, aLast, aFn);
+}
+
+template <typename T>
+template <typename Fn>
+void TextEditor::LineMarkers<T>::ForEach(int aFirst, int aLast, Fn aFn) const
+{
+	Visit(mRoot, 0, aFirst, aLast, aFn);
+}
+
+void TextEditor::SetErrorMarkers(const ErrorMarkers& aMarkers)
+{
+	mErrorMarkers.Clear();
+	for (auto& marker : aMarkers)
+		mErrorMarkers.Insert(marker.first, marker.second);
+}
+
+void TextEditor::SetBreakpoints(const Breakpoints& aMarkers)
+{
+	mBreakpoints.Clear();
+	for (auto line : aMarkers)
+		mBreakpoints.Insert(line, true);
+}
+
+TextEditor::ErrorMarkers TextEditor::GetErrorMarkers() const
+{
+	ErrorMarkers result;
+	mErrorMarkers.ForEach(INT_MIN, INT_MAX, [&](int aLine, const std::string& aText) { result.emplace_hint(result.end(), aLine, aText); });
+	return result;
+}
+
+TextEditor::Breakpoints TextEditor::GetBreakpoints() const
+{
+	Breakpoints result;
+	mBreakpoints.ForEach(INT_MIN, INT_MAX, [&](int aLine, bool) { result.insert(aLine); });
+	return result;
+}
+
+// The inverse of InsertLine(): markers are compared with the 0-based line indices, the ones on the removed lines [aStart, aEnd) are dropped
+// and the ones after move up by the number of removed lines, so deleting pasted lines puts the markers back where they were before the paste.
+void TextEditor::RemoveMarkers(int aStart, int aEnd)
+{
+	mErrorMarkers.Erase(aStart, aEnd);
+	mErrorMarkers.Shift(aEnd, aStart - aEnd);
+
+	mBreakpoints.Erase(aStart, aEnd);
+	mBreakpoints.Shift(aEnd, aStart - aEnd);
+}
+
+void TextEditor::RemoveLine(int aStart, int aEnd)
+{
+	assert(!mReadOnly);
+
+	RemoveMarkers(aStart, aEnd);
+	OnLinesChanged();
+
+	mLines.erase(mLines.begin() + aStart, mLines.begin() + aEnd);
+	if (!mLineSources.empty())
+		mLineSources.erase(mLineSources.begin() + aStart, mLineSources.begin() + aEnd);
+}
+
+void TextEditor::RemoveLine(int aIndex)
+{
+	assert(!mReadOnly);
+
+	RemoveMarkers(aIndex, aIndex + 1);
+	OnLinesChanged();
 
 	mLines.erase(mLines.begin() + aIndex);
+	if (!mLineSources.empty())
+		mLineSources.erase(mLineSources.begin() + aIndex);
 }
 
 TextEditor::Line& TextEditor::InsertLine(int aIndex)
@@ -346,16 +915,12 @@ TextEditor::Line& TextEditor::InsertLine(int aIndex)
 	assert(!mReadOnly);
 
 	auto& result = *mLines.insert(mLines.begin() + aIndex, Line());
+	if (!mLineSources.empty())
+		mLineSources.insert(mLineSources.begin() + aIndex, LineSource());
 
-	ErrorMarkers etmp;
-	for (auto& i : mErrorMarkers)
-		etmp.insert(ErrorMarkers::value_type(i.first >= aIndex ? i.first + 1 : i.first, i.second));
-	mErrorMarkers = std::move(etmp);
-
-	Breakpoints btmp;
-	for (auto i : mBreakpoints)
-		btmp.insert(i >= aIndex ? i + 1 : i);
-	mBreakpoints = std::move(btmp);
+	mErrorMarkers.Shift(aIndex, 1);
+	mBreakpoints.Shift(aIndex, 1);
+	OnLinesChanged();
 
 	return result;
 }
@@ -374,7 +939,7 @@ std::string TextEditor::GetWordAt(const Coordinates & aCoords) const
 	std::string r;
 
 	for (auto it = start; it < end; Advance(it))
-		r.push_back(mLines[it.mLine][it.mColumn].mChar);
+		r.push_back(GetLine(it.mLine)[it.mColumn].mChar);
 
 	return r;
 }
@@ -519,16 +1084,28 @@ void TextEditor::Render(const char* aTitle, const ImVec2& aSize, bool aBorder)
 	auto scrollY = ImGui::GetScrollY();
 
 	auto lineNo = (int)floor(scrollY / mCharAdvance.y);
+	auto firstVisibleColumn = (int)floor(scrollX / mCharAdvance.x) - cTextStart;
+	auto visibleColumns = (int)ceil(ImGui::GetWindowWidth() / mCharAdvance.x);
 	auto lineMax = std::max(0, std::min((int)mLines.size() - 1, lineNo + (int)floor((scrollY + contentSize.y) / mCharAdvance.y)));
 	if (!mLines.empty())
 	{
+		// Markers of the visible lines in line order, the markers are numbered from 1
+		static std::vector<int> breakpoints;
+		static std::vector<std::pair<int, const std::string*>> errorMarkers;
+		breakpoints.clear();
+		errorMarkers.clear();
+		mBreakpoints.ForEach(lineNo + 1, lineMax + 2, [](int aLine, bool) { breakpoints.push_back(aLine); });
+		mErrorMarkers.ForEach(lineNo + 1, lineMax + 2, [](int aLine, const std::string& aText) { errorMarkers.emplace_back(aLine, &aText); });
+		size_t breakpointIndex = 0, errorMarkerIndex = 0;
+
 		while (lineNo <= lineMax)
 		{
 			ImVec2 lineStartScreenPos = ImVec2(cursorScreenPos.x, cursorScreenPos.y + lineNo * mCharAdvance.y);
 			ImVec2 textScreenPos = ImVec2(lineStartScreenPos.x + mCharAdvance.x * cTextStart, lineStartScreenPos.y);
 
-			auto& line = mLines[lineNo];
-			longest = std::max(cTextStart + TextDistanceToLineStart(Coordinates(lineNo, (int) line.size())), longest);
+			auto& line = GetLine(lineNo);
+			auto lineLength = TextDistanceToLineStart(Coordinates(lineNo, (int) line.size()));
+			longest = std::max(cTextStart + lineLength, longest);
 			auto columnNo = 0;
 			Coordinates lineStartCoord(lineNo, 0);
 			Coordinates lineEndCoord(lineNo, (int)line.size());
@@ -552,18 +1129,32 @@ void TextEditor::Render(const char* aTitle, const ImVec2& aSize, bool aBorder)
 				drawList->AddRectFilled(vstart, vend, mPalette[(int)PaletteIndex::Selection]);
 			}
 
+			if (!mSearch.mPattern.empty())
+			{
+				static std::string searchBuffer;
+				int length, mstart, mend;
+				auto chars = GetLineChars(lineNo, searchBuffer, length);
+				for (int column = 0; FindInLine(chars, length, column, mstart, mend); column = mend)
+				{
+					ImVec2 vstart(lineStartScreenPos.x + (mCharAdvance.x) * (TextDistanceToLineStart(Coordinates(lineNo, mstart)) + cTextStart), lineStartScreenPos.y);
+					ImVec2 vend(lineStartScreenPos.x + (mCharAdvance.x) * (TextDistanceToLineStart(Coordinates(lineNo, mend)) + cTextStart), lineStartScreenPos.y + mCharAdvance.y);
+					drawList->AddRectFilled(vstart, vend, mPalette[(int)PaletteIndex::SearchMatch]);
+				}
+			}
+
 			static char buf[16];
 			auto start = ImVec2(lineStartScreenPos.x + scrollX, lineStartScreenPos.y);
 
-			if (mBreakpoints.find(lineNo + 1) != mBreakpoints.end())
+			if (breakpointIndex < breakpoints.size() && breakpoints[breakpointIndex] == lineNo + 1)
 			{
+				++breakpointIndex;
 				auto end = ImVec2(lineStartScreenPos.x + contentSize.x + 2.0f * scrollX, lineStartScreenPos.y + mCharAdvance.y);
 				drawList->AddRectFilled(start, end, mPalette[(int)PaletteIndex::Breakpoint]);
 			}
 
-			auto errorIt = mErrorMarkers.find(lineNo + 1);
-			if (errorIt != mErrorMarkers.end())
+			if (errorMarkerIndex < errorMarkers.size() && errorMarkers[errorMarkerIndex].first == lineNo + 1)
 			{
+				auto& errorMarker = errorMarkers[errorMarkerIndex++];
 				auto end = ImVec2(lineStartScreenPos.x + contentSize.x + 2.0f * scrollX, lineStartScreenPos.y + mCharAdvance.y);
 				drawList->AddRectFilled(start, end, mPalette[(int)PaletteIndex::ErrorMarker]);
 
@@ -571,11 +1162,11 @@ void TextEditor::Render(const char* aTitle, const ImVec2& aSize, bool aBorder)
 				{
 					ImGui::BeginTooltip();
 					ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.2f, 0.2f, 1.0f));
-					ImGui::Text("Error at line %d:", errorIt->first);
+					ImGui::Text("Error at line %d:", errorMarker.first);
 					ImGui::PopStyleColor();
 					ImGui::Separator();
 					ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 1.0f, 0.2f, 1.0f));
-					ImGui::Text("%s", errorIt->second.c_str());
+					ImGui::Text("%s", errorMarker.second->c_str());
 					ImGui::PopStyleColor();
 					ImGui::EndTooltip();
 				}
@@ -614,11 +1205,20 @@ void TextEditor::Render(const char* aTitle, const ImVec2& aSize, bool aBorder)
 				}
 			}
 
-			appendIndex = 0;
-			auto prevColor = line.empty() ? PaletteIndex::Default : (line[0].mMultiLineComment ? PaletteIndex::MultiLineComment : line[0].mColorIndex);
+			// Only the glyphs in view are laid out, with one more on each side for the partly visible ones
+			int firstColumn = 0, lastColumn = (int)line.size();
+			if (firstVisibleColumn > 0 || lineLength > firstVisibleColumn + visibleColumns)
+			{
+				firstColumn = std::max(0, VisualColumnToColumn(lineNo, firstVisibleColumn) - 1);
+				lastColumn = std::min(lastColumn, VisualColumnToColumn(lineNo, firstVisibleColumn + visibleColumns) + 1);
+			}
+			appendIndex = firstColumn > 0 ? TextDistanceToLineStart(Coordinates(lineNo, firstColumn)) : 0;
+			textScreenPos.x += mCharAdvance.x * appendIndex;
+			auto prevColor = firstColumn >= lastColumn ? PaletteIndex::Default : (line[firstColumn].mMultiLineComment ? PaletteIndex::MultiLineComment : line[firstColumn].mColorIndex);
 
-			for (auto& glyph : line)
+			for (int i = firstColumn; i < lastColumn; ++i)
 			{
+				auto& glyph = line[i];
 				auto color = glyph.mMultiLineComment ? PaletteIndex::MultiLineComment : glyph.mColorIndex;
 
 				if (color != prevColor && !buffer.empty())
@@ -687,13 +1287,17 @@ void TextEditor::Render(const char* aTitle, const ImVec2& aSize, bool aBorder)
 
 void TextEditor::SetText(const std::string & aText)
 {
+	UnloadFile();
 	mLines.clear();
-	for (auto chr : aText)
+	OnLinesChanged();
+	mLines.push_back(Line());
+	for (size_t i = 0; i < aText.size(); ++i)
 	{
-		if (mLines.empty())
-			mLines.push_back(Line());
+		auto chr = aText[i];
 		if (chr == '\n')
 			mLines.push_back(Line());
+		else if (chr == '\r' && (i + 1 == aText.size() || aText[i + 1] == '\n'))
+			continue;	// Dropped as LoadFile() does
 		else
 		{
 			mLines.back().push_back(Glyph(chr, PaletteIndex::Default));
@@ -730,7 +1334,7 @@ void TextEditor::EnterCharacter(Char aChar)
 	if (aChar == '\n')
 	{
 		InsertLine(coord.mLine + 1);
-		auto& line = mLines[coord.mLine];
+		auto& line = GetLine(coord.mLine);
 		auto& newLine = mLines[coord.mLine + 1];
 		newLine.insert(newLine.begin(), line.begin() + coord.mColumn, line.end());
 		line.erase(line.begin() + coord.mColumn, line.begin() + line.size());
@@ -738,13 +1342,14 @@ void TextEditor::EnterCharacter(Char aChar)
 	}
 	else
 	{
-		auto& line = mLines[coord.mLine];
+		auto& line = GetLine(coord.mLine);
 		if (mOverwrite && (int)line.size() > coord.mColumn)
 			line[coord.mColumn] = Glyph(aChar, PaletteIndex::Default);
 		else
 			line.insert(line.begin() + coord.mColumn, Glyph(aChar, PaletteIndex::Default));
 		mState.mCursorPosition = coord;
 		++mState.mCursorPosition.mColumn;
+		OnLineChanged(coord.mLine);
 	}
 
 	u.mAdded = aChar;
@@ -904,7 +1509,7 @@ void TextEditor::MoveLeft(int aAmount, bool aSelect, bool aWordMode)
 			if (mState.mCursorPosition.mLine > 0)
 			{
 				--mState.mCursorPosition.mLine;
-				mState.mCursorPosition.mColumn = (int)mLines[mState.mCursorPosition.mLine].size();
+				mState.mCursorPosition.mColumn = GetLineLength(mState.mCursorPosition.mLine);
 			}
 		}
 		else
@@ -944,15 +1549,15 @@ void TextEditor::MoveRight(int aAmount, bool aSelect, bool aWordMode)
 
 	while (aAmount-- > 0)
 	{
-		auto& line = mLines[mState.mCursorPosition.mLine];
-		if (mState.mCursorPosition.mColumn >= (int)line.size())
+		int lineLength = GetLineLength(mState.mCursorPosition.mLine);
+		if (mState.mCursorPosition.mColumn >= lineLength)
 		{
 			mState.mCursorPosition.mLine = std::max(0, std::min((int)mLines.size() - 1, mState.mCursorPosition.mLine + 1));
 			mState.mCursorPosition.mColumn = 0;
 		}
 		else
 		{
-			mState.mCursorPosition.mColumn = std::max(0, std::min((int)line.size(), mState.mCursorPosition.mColumn + 1));
+			mState.mCursorPosition.mColumn = std::max(0, std::min(lineLength, mState.mCursorPosition.mColumn + 1));
 			if (aWordMode)
 				mState.mCursorPosition = FindWordEnd(mState.mCursorPosition);
 		}
@@ -1038,7 +1643,7 @@ void TextEditor::MoveHome(bool aSelect)
 void TextEditor::MoveEnd(bool aSelect)
 {
 	auto oldPos = mState.mCursorPosition;
-	SetCursorPosition(Coordinates(mState.mCursorPosition.mLine, (int)mLines[oldPos.mLine].size()));
+	SetCursorPosition(Coordinates(mState.mCursorPosition.mLine, GetLineLength(oldPos.mLine)));
 
 	if (mState.mCursorPosition != oldPos)
 	{
@@ -1082,7 +1687,7 @@ void TextEditor::Delete()
 	{
 		auto pos = GetActualCursorCoordinates();
 		SetCursorPosition(pos);
-		auto& line = mLines[pos.mLine];
+		auto& line = GetLine(pos.mLine);
 
 		if (pos.mColumn == (int)line.size())
 		{
@@ -1093,7 +1698,7 @@ void TextEditor::Delete()
 			u.mRemovedStart = u.mRemovedEnd = GetActualCursorCoordinates();
 			Advance(u.mRemovedEnd);
 
-			auto& nextLine = mLines[pos.mLine + 1];
+			auto& nextLine = GetLine(pos.mLine + 1);
 			line.insert(line.end(), nextLine.begin(), nextLine.end());
 			RemoveLine(pos.mLine + 1);
 		}
@@ -1104,6 +1709,7 @@ void TextEditor::Delete()
 			u.mRemovedEnd.mColumn++;
 
 			line.erase(line.begin() + pos.mColumn);
+			OnLineChanged(pos.mLine);
 		}
 
 		Colorize(pos.mLine, 1);
@@ -1146,8 +1752,8 @@ void TextEditor::BackSpace()
 			u.mRemovedStart = u.mRemovedEnd = GetActualCursorCoordinates();
 			Advance(u.mRemovedEnd);
 
-			auto& line = mLines[mState.mCursorPosition.mLine];
-			auto& prevLine = mLines[mState.mCursorPosition.mLine - 1];
+			auto& line = GetLine(mState.mCursorPosition.mLine);
+			auto& prevLine = GetLine(mState.mCursorPosition.mLine - 1);
 			auto prevSize = (int)prevLine.size();
 			prevLine.insert(prevLine.end(), line.begin(), line.end());
 			RemoveLine(mState.mCursorPosition.mLine);
@@ -1156,7 +1762,7 @@ void TextEditor::BackSpace()
 		}
 		else
 		{
-			auto& line = mLines[mState.mCursorPosition.mLine];
+			auto& line = GetLine(mState.mCursorPosition.mLine);
 
 			u.mRemoved = line[pos.mColumn - 1].mChar;
 			u.mRemovedStart = u.mRemovedEnd = GetActualCursorCoordinates();
@@ -1165,6 +1771,7 @@ void TextEditor::BackSpace()
 			--mState.mCursorPosition.mColumn;
 			if (mState.mCursorPosition.mColumn < (int)line.size())
 				line.erase(line.begin() + mState.mCursorPosition.mColumn);
+			OnLineChanged(mState.mCursorPosition.mLine);
 		}
 		EnsureCursorVisible();
 		Colorize(mState.mCursorPosition.mLine, 1);
@@ -1200,11 +1807,8 @@ void TextEditor::Copy()
 	{
 		if (!mLines.empty())
 		{
-			std::string str;
-			auto& line = mLines[GetActualCursorCoordinates().mLine];
-			for (auto& g : line)
-				str.push_back(g.mChar);
-			ImGui::SetClipboardText(str.c_str());
+			auto line = GetActualCursorCoordinates().mLine;
+			ImGui::SetClipboardText(GetText(Coordinates(line, 0), Coordinates(line, GetLineLength(line))).c_str());
 		}
 	}
 }
@@ -1283,6 +1887,312 @@ void TextEditor::Redo(int aSteps)
 		mUndoBuffer[mUndoIndex++].Redo(this);
 }
 
+bool TextEditor::SetSearch(const std::string& aPattern, bool aCaseSensitive, bool aRegex)
+{
+	if (aPattern == mSearch.mPattern && aCaseSensitive == mSearch.mCaseSensitive && aRegex == mSearch.mRegex)
+		return true;
+
+	if (aRegex && !aPattern.empty())
+	{
+		try
+		{
+			auto flags = aCaseSensitive ? std::regex_constants::ECMAScript : std::regex_constants::ECMAScript | std::regex_constants::icase;
+			mSearch.mExpression = std::regex(aPattern, flags);
+		}
+		catch (const std::regex_error&)
+		{
+			mSearch.mPattern.clear();
+			return false;
+		}
+	}
+
+	mSearch.mPattern = aPattern;
+	mSearch.mLiteral = aPattern;
+	if (!aCaseSensitive)
+		for (auto& c : mSearch.mLiteral)
+			if (c >= 'A' && c <= 'Z')
+				c += 'a' - 'A';
+	mSearch.mCaseSensitive = aCaseSensitive;
+	mSearch.mRegex = aRegex;
+	mSearch.mFromSelectionStart = true;
+	return true;
+}
+
+// Characters of a line, straight from the mapped file when it has no glyphs yet, else copied into aBuffer
+const char* TextEditor::GetLineChars(int aIndex, std::string& aBuffer, int& aLength) const
+{
+	if (!IsLineLoaded(aIndex))
+	{
+		aLength = mLineSources[aIndex].mLength;
+		return mFile->mData + mLineSources[aIndex].mOffset;
+	}
+
+	auto& line = mLines[aIndex];
+	aBuffer.resize(line.size());
+	for (size_t i = 0; i < line.size(); ++i)
+		aBuffer[i] = line[i].mChar;
+	aLength = (int)line.size();
+	return aBuffer.data();
+}
+
+// First match starting at aFromColumn or after, empty regex matches are skipped
+bool TextEditor::FindInLine(const char* aChars, int aLength, int aFromColumn, int& aStart, int& aEnd) const
+{
+	if (aFromColumn > aLength)
+		return false;
+
+	if (!mSearch.mRegex)
+	{
+		auto found = FindLiteral(aChars + aFromColumn, aChars + aLength, mSearch.mLiteral, mSearch.mCaseSensitive);
+		if (found == nullptr)
+			return false;
+		aStart = (int)(found - aChars);
+		aEnd = aStart + (int)mSearch.mLiteral.size();
+		return true;
+	}
+
+	std::cmatch match;
+	for (int column = aFromColumn; column <= aLength; )
+	{
+		auto flags = column > 0 ? std::regex_constants::match_prev_avail : std::regex_constants::match_default;
+		if (!std::regex_search(aChars + column, aChars + aLength, match, mSearch.mExpression, flags))
+			return false;
+		aStart = column + (int)match.position(0);
+		aEnd = aStart + (int)match.length(0);
+		if (aEnd > aStart)
+			return true;
+		column = aStart + 1;
+	}
+	return false;
+}
+
+// First match in the lines [aFromLine, aToLine), from aFromColumn in the first one
+bool TextEditor::FindForward(int aFromLine, int aFromColumn, int aToLine, Coordinates& aStart, Coordinates& aEnd) const
+{
+	// Lines hold no line breaks
+	if (!mSearch.mRegex && mSearch.mLiteral.find('\n') != std::string::npos)
+		return false;
+
+	std::string buffer;
+	for (int i = aFromLine; i < aToLine; )
+	{
+		int column = i == aFromLine ? aFromColumn : 0;
+		if (!IsLineLoaded(i) && !mSearch.mRegex)
+		{
+			// A literal is searched for in one pass over the run of lines that are still in the file as they were mapped, a match can't cross their '\n'
+			auto followed = [&](int aLine)
+			{
+				auto& source = mLineSources[aLine];
+				auto& next = mLineSources[aLine + 1];
+				size_t end = source.mOffset + source.mLength;
+				return next.mLength >= 0 && (next.mOffset == end + 1 || (next.mOffset == end + 2 && mFile->mData[end] == '\r'));
+			};
+			int runEnd = i + 1;
+			while (runEnd < aToLine && followed(runEnd - 1))
+				++runEnd;
+
+			auto& lastSource = mLineSources[runEnd - 1];
+			const char* end = mFile->mData + lastSource.mOffset + lastSource.mLength;
+			const char* from = mFile->mData + mLineSources[i].mOffset + std::min(column, mLineSources[i].mLength);
+			while (const char* found = FindLiteral(from, end, mSearch.mLiteral, mSearch.mCaseSensitive))
+			{
+				size_t offset = found - mFile->mData;
+				auto source = std::upper_bound(mLineSources.begin() + i, mLineSources.begin() + runEnd, offset,
+					[](size_t aOffset, const LineSource& aSource) { return aOffset < aSource.mOffset; }) - 1;
+				int start = (int)(offset - source->mOffset);
+				if (start + (int)mSearch.mLiteral.size() <= source->mLength)
+				{
+					int line = (int)(source - mLineSources.begin());
+					aStart = Coordinates(line, start);
+					aEnd = Coordinates(line, start + (int)mSearch.mLiteral.size());
+					return true;
+				}
+				from = found + 1;	// Matched the '\r' ending the line
+			}
+			i = runEnd;
+			continue;
+		}
+
+		int length, start, end;
+		auto chars = GetLineChars(i, buffer, length);
+		if (FindInLine(chars, length, column, start, end))
+		{
+			aStart = Coordinates(i, start);
+			aEnd = Coordinates(i, end);
+			return true;
+		}
+		++i;
+	}
+	return false;
+}
+
+// Last match starting before aBefore, wrapping around to the end of the document
+bool TextEditor::FindBackward(const Coordinates& aBefore, Coordinates& aStart, Coordinates& aEnd) const
+{
+	std::string buffer;
+	int lineCount = (int)mLines.size();
+	for (int n = 0; n <= lineCount; ++n)
+	{
+		int i = (aBefore.mLine - n + lineCount) % lineCount;
+		int before = n == 0 ? aBefore.mColumn : INT_MAX;
+		int length, start, end;
+		auto chars = GetLineChars(i, buffer, length);
+		bool found = false;
+		for (int column = 0; FindInLine(chars, length, column, start, end) && start < before; column = start + 1)
+		{
+			aStart = Coordinates(i, start);
+			aEnd = Coordinates(i, end);
+			found = true;
+		}
+		if (found)
+			return true;
+	}
+	return false;
+}
+
+bool TextEditor::IsMatch(const Coordinates& aStart, const Coordinates& aEnd) const
+{
+	if (mSearch.mPattern.empty() || aStart.mLine != aEnd.mLine || aStart.mLine >= (int)mLines.size())
+		return false;
+
+	std::string buffer;
+	int length, start, end;
+	auto chars = GetLineChars(aStart.mLine, buffer, length);
+	for (int column = 0; FindInLine(chars, length, column, start, end) && start <= aStart.mColumn; column = start + 1)
+		if (start == aStart.mColumn && end == aEnd.mColumn)
+			return true;
+	return false;
+}
+
+// Text replacing the match at aStart, InsertTextAt() would drop '\r' and stop at '\0'
+std::string TextEditor::FormatReplacement(const Coordinates& aStart, const std::string& aWith) const
+{
+	std::string result = aWith;
+	if (mSearch.mRegex)
+	{
+		std::string buffer;
+		std::cmatch match;
+		int length;
+		auto chars = GetLineChars(aStart.mLine, buffer, length);
+		auto flags = std::regex_constants::match_continuous | (aStart.mColumn > 0 ? std::regex_constants::match_prev_avail : std::regex_constants::match_default);
+		if (std::regex_search(chars + aStart.mColumn, chars + length, match, mSearch.mExpression, flags))
+			result = match.format(aWith);
+	}
+	result.resize(strlen(result.c_str()));
+	result.erase(std::remove(result.begin(), result.end(), '\r'), result.end());
+	return result;
+}
+
+bool TextEditor::FindNext(bool aBackwards)
+{
+	if (mSearch.mPattern.empty() || mLines.empty())
+		return false;
+
+	Coordinates start, end;
+	bool found;
+	if (aBackwards)
+	{
+		found = FindBackward(SanitizeCoordinates(HasSelection() ? mState.mSelectionStart : mState.mCursorPosition), start, end);
+	}
+	else
+	{
+		auto from = !HasSelection() ? mState.mCursorPosition : mSearch.mFromSelectionStart ? mState.mSelectionStart : mState.mSelectionEnd;
+		from = SanitizeCoordinates(from);
+		found = FindForward(from.mLine, from.mColumn, (int)mLines.size(), start, end) || FindForward(0, 0, from.mLine + 1, start, end);
+	}
+	mSearch.mFromSelectionStart = false;
+
+	if (!found)
+		return false;
+	SetSelection(start, end);
+	SetCursorPosition(end);
+	return true;
+}
+
+bool TextEditor::Replace(const std::string& aWith)
+{
+	if (IsReadOnly() || mSearch.mPattern.empty())
+		return false;
+
+	if (HasSelection() && IsMatch(mState.mSelectionStart, mState.mSelectionEnd))
+	{
+		UndoRecord u;
+		u.mBefore = mState;
+		u.mRemoved = GetSelectedText();
+		u.mRemovedStart = mState.mSelectionStart;
+		u.mRemovedEnd = mState.mSelectionEnd;
+		u.mAdded = FormatReplacement(mState.mSelectionStart, aWith);
+
+		DeleteSelection();
+		u.mAddedStart = GetActualCursorCoordinates();
+		InsertText(u.mAdded);
+		u.mAddedEnd = GetActualCursorCoordinates();
+
+		u.mAfter = mState;
+		AddUndo(u);
+		mSearch.mFromSelectionStart = false;
+	}
+	return FindNext();
+}
+
+int TextEditor::ReplaceAll(const std::string& aWith)
+{
+	if (IsReadOnly() || mSearch.mPattern.empty() || mLines.empty())
+		return 0;
+
+	struct Replacement
+	{
+		Coordinates mStart, mEnd;
+		std::string mText;
+	};
+	std::vector<Replacement> replacements;
+	Coordinates start, end;
+	for (Coordinates from; FindForward(from.mLine, from.mColumn, (int)mLines.size(), start, end); from = end)
+		replacements.push_back({ start, end, FormatReplacement(start, aWith) });
+	if (replacements.empty())
+		return 0;
+
+	// Front to back, moving each match by the lines the replacements before it added and along the line a replacement before it ended on.
+	// The undo step holds one record per match with the text it removed and added, not the text between the matches.
+	UndoRecord u;
+	u.mBefore = mState;
+	u.mGroup.reserve(replacements.size());
+	int lineShift = 0;
+	int previousLine = -1, previousColumn = 0;	// End of the match replaced before, before it got replaced
+	Coordinates where;
+	for (auto& replacement : replacements)
+	{
+		UndoRecord match;
+		match.mRemovedStart = Coordinates(replacement.mStart.mLine + lineShift, replacement.mStart.mColumn);
+		match.mRemovedEnd = Coordinates(replacement.mEnd.mLine + lineShift, replacement.mEnd.mColumn);
+		if (replacement.mStart.mLine == previousLine)
+		{
+			match.mRemovedStart = Coordinates(where.mLine, where.mColumn + replacement.mStart.mColumn - previousColumn);
+			match.mRemovedEnd = Coordinates(where.mLine, where.mColumn + replacement.mEnd.mColumn - previousColumn);
+		}
+		match.mRemoved = GetText(match.mRemovedStart, match.mRemovedEnd);
+		match.mAdded = replacement.mText;
+		match.mAddedStart = where = match.mRemovedStart;
+
+		DeleteRange(match.mRemovedStart, match.mRemovedEnd);
+		InsertTextAt(where, replacement.mText.c_str());
+		match.mAddedEnd = where;
+		lineShift += where.mLine - match.mAddedStart.mLine;
+		previousLine = replacement.mEnd.mLine;
+		previousColumn = replacement.mEnd.mColumn;
+		u.mGroup.push_back(std::move(match));
+	}
+
+	auto first = u.mGroup.front().mAddedStart;
+	SetSelection(where, where);
+	SetCursorPosition(where);
+	Colorize(first.mLine - 1, where.mLine - first.mLine + 2);
+
+	u.mAfter = mState;
+	AddUndo(u);
+	return (int)replacements.size();
+}
+
 const TextEditor::Palette & TextEditor::GetDarkPalette()
 {
 	static Palette p = { 
@@ -1307,6 +2217,7 @@ const TextEditor::Palette & TextEditor::GetDarkPalette()
 		0x40000000, // Current line fill
 		0x40808080, // Current line fill (inactive)
 		0x40a0a0a0, // Current line edge
+		0x6000c0ff, // Search match
 	};
 	return p;
 }
@@ -1335,6 +2246,7 @@ const TextEditor::Palette & TextEditor::GetLightPalette()
 		0x40000000, // Current line fill
 		0x40808080, // Current line fill (inactive)
 		0x40000000, // Current line edge
+		0x6000a0ff, // Search match
 	};
 	return p;
 }
@@ -1363,6 +2275,7 @@ const TextEditor::Palette & TextEditor::GetRetroBluePalette()
 		0x40000000, // Current line fill
 		0x40808080, // Current line fill (inactive)
 		0x40000000, // Current line edge
+		0x6000ffff, // Search match
 	};
 	return p;
 }
@@ -1378,6 +2291,15 @@ std::string TextEditor::GetSelectedText() const
 	return GetText(mState.mSelectionStart, mState.mSelectionEnd);
 }
 
+size_t TextEditor::GetText(char* aBuffer, size_t aBufferSize) const
+{
+	Coordinates start, end((int)mLines.size(), 0);
+	auto size = CopyText(start, end, nullptr);
+	if (aBuffer && size <= aBufferSize)
+		CopyText(start, end, aBuffer);
+	return size;
+}
+
 void TextEditor::ProcessInputs()
 {
 }
@@ -1401,6 +2323,10 @@ void TextEditor::ColorizeRange(int aFromLine, int aToLine)
 	int endLine = std::max(0, std::min((int)mLines.size(), aToLine));
 	for (int i = aFromLine; i < endLine; ++i)
 	{
+		// Lines without glyphs yet get colorized by LoadLine()
+		if (!IsLineLoaded(i))
+			continue;
+
 		bool preproc = false;
 		auto& line = mLines[i];
 		buffer.clear();
@@ -1466,68 +2392,32 @@ void TextEditor::ColorizeInternal()
 	
 	if (mCheckMultilineComments)
 	{
-		auto end = Coordinates((int)mLines.size(), 0);
-		auto commentStart = end;
-		auto withinString = false;
-		for (auto i = Coordinates(0, 0); i < end; Advance(i))
+		// Lines without glyphs yet are scanned in the file, their state is kept for LoadLine()
+		auto& startStr = mLanguageDefinition.mCommentStart;
+		auto& endStr = mLanguageDefinition.mCommentEnd;
+		bool stops[256] = {};
+		stops['\"'] = stops['\\'] = true;
+		if (!startStr.empty() && !endStr.empty())
+			stops[(unsigned char)startStr[0]] = stops[(unsigned char)endStr.back()] = true;
+		bool inComment = false, inString = false, skipFirst = false;
+		for (int i = 0; i < (int)mLines.size(); ++i)
 		{
-			auto& line = mLines[i.mLine];
-			if (!line.empty())
+			if (!mLineSources.empty())
 			{
-				auto g = line[i.mColumn];
-				auto c = g.mChar;
-
-				bool inComment = commentStart <= i;
-
-				if (withinString)
-				{
-					line[i.mColumn].mMultiLineComment = inComment;
-
-					if (c == '\"')
-					{
-						if (i.mColumn + 1 < (int)line.size() && line[i.mColumn + 1].mChar == '\"')
-						{
-							Advance(i);
-							if (i.mColumn < (int)line.size())
-								line[i.mColumn].mMultiLineComment = inComment;
-						}
-						else
-							withinString = false;
-					}
-					else if (c == '\\')
-					{
-						Advance(i);
-						if (i.mColumn < (int)line.size())
-							line[i.mColumn].mMultiLineComment = inComment;
-					}
-				}
-				else
+				auto& source = mLineSources[i];
+				source.mInComment = inComment;
+				source.mInString = inString;
+				source.mSkipFirst = skipFirst;
+				if (source.mLength >= 0)
 				{
-					if (c == '\"')
-					{
-						withinString = true;
-						line[i.mColumn].mMultiLineComment = inComment;
-					}
-					else
-					{
-						auto pred = [](const char& a, const Glyph& b) { return a == b.mChar; };
-						auto from = line.begin() + i.mColumn;
-						auto& startStr = mLanguageDefinition.mCommentStart;
-						if (i.mColumn + startStr.size() <= line.size() &&
-							std::equal(startStr.begin(), startStr.end(), from, from + startStr.size(), pred))
-							commentStart = i;
-
-						inComment = commentStart <= i;
-
-						line[i.mColumn].mMultiLineComment = inComment;
-
-						auto& endStr = mLanguageDefinition.mCommentEnd;
-						if (i.mColumn + 1 >= (int)endStr.size() &&
-							std::equal(endStr.begin(), endStr.end(), from + 1 - endStr.size(), from + 1, pred))
-							commentStart = end;
-					}
+					const char* chars = mFile->mData + source.mOffset;
+					ScanMultiLineComments(source.mLength, [&](int n) { return chars[n]; }, [](int, bool) {}, startStr, endStr, inComment, inString, skipFirst,
+						startStr.empty() || endStr.empty() ? nullptr : stops);
+					continue;
 				}
 			}
+			auto& line = mLines[i];
+			ScanMultiLineComments((int)line.size(), [&](int n) { return line[n].mChar; }, [&](int n, bool c) { line[n].mMultiLineComment = c; }, startStr, endStr, inComment, inString, skipFirst);
 		}
 		mCheckMultilineComments = false;
 		return;
@@ -1550,13 +2440,83 @@ void TextEditor::ColorizeInternal()
 
 int TextEditor::TextDistanceToLineStart(const Coordinates& aFrom) const
 {
-	auto& line = mLines[aFrom.mLine];
+	auto& line = GetLine(aFrom.mLine);
+	if (auto columns = GetLineColumns(aFrom.mLine, line))
+	{
+		int column = std::min(aFrom.mColumn, (int)line.size());
+		size_t tab = std::lower_bound(columns->mTabs.begin(), columns->mTabs.end(), column) - columns->mTabs.begin();
+		return tab == 0 ? column : columns->mTabEnds[tab - 1] + column - columns->mTabs[tab - 1] - 1;
+	}
+
 	auto len = 0;
 	for (size_t it = 0u; it < line.size() && it < (unsigned)aFrom.mColumn; ++it)
 		len = line[it].mChar == '\t' ? (len / mTabSize) * mTabSize + mTabSize : len + 1;
 	return len;
 }
 
+// First column of a line at aVisualColumn or after, or the line size
+int TextEditor::VisualColumnToColumn(int aLine, int aVisualColumn) const
+{
+	auto& line = GetLine(aLine);
+	if (auto columns = GetLineColumns(aLine, line))
+	{
+		if (aVisualColumn <= 0)
+			return 0;
+
+		// Between the tab before the first one ending at aVisualColumn or after, and that one, each glyph takes one column
+		size_t tab = std::lower_bound(columns->mTabEnds.begin(), columns->mTabEnds.end(), aVisualColumn) - columns->mTabEnds.begin();
+		int start = tab == 0 ? 0 : columns->mTabs[tab - 1] + 1;
+		// 64-bit, aVisualColumn can be anything up to INT_MAX
+		long long column = start + (long long)aVisualColumn - (tab == 0 ? 0 : columns->mTabEnds[tab - 1]);
+		if (tab < columns->mTabs.size())
+			column = std::min(column, (long long)columns->mTabs[tab] + 1);
+		return (int)std::min(column, (long long)line.size());
+	}
+
+	int column = 0;
+	auto distance = 0;
+	while (distance < aVisualColumn && column < (int)line.size())
+	{
+		if (line[column].mChar == '\t')
+			distance = (distance / mTabSize) * mTabSize + mTabSize;
+		else
+			++distance;
+		++column;
+	}
+	return column;
+}
+
+// Short lines are cheaper to walk than to look up
+const TextEditor::LineColumns* TextEditor::GetLineColumns(int aIndex, const Line& aLine) const
+{
+	static const int cMinLength = 256;
+	if ((int)aLine.size() < cMinLength)
+		return nullptr;
+
+	auto it = mLineColumns.find(aIndex);
+	if (it != mLineColumns.end())
+		return &it->second;
+
+	// Only the visible lines and the cursor line get measured in a frame, a scroll through a large document doesn't keep them all
+	if (mLineColumns.size() >= 1024)
+		mLineColumns.clear();
+
+	auto& columns = mLineColumns[aIndex];
+	auto distance = 0;
+	for (int i = 0; i < (int)aLine.size(); ++i)
+	{
+		if (aLine[i].mChar == '\t')
+		{
+			distance = (distance / mTabSize) * mTabSize + mTabSize;
+			columns.mTabs.push_back(i);
+			columns.mTabEnds.push_back(distance);
+		}
+		else
+			++distance;
+	}
+	return &columns;
+}
+
 void TextEditor::EnsureCursorVisible()
 {
 	if (!mWithinRender)
@@ -1620,6 +2580,9 @@ TextEditor::UndoRecord::UndoRecord(
 
 void TextEditor::UndoRecord::Undo(TextEditor * aEditor)
 {
+	for (auto it = mGroup.rbegin(); it != mGroup.rend(); ++it)
+		it->Undo(aEditor);
+
 	if (!mAdded.empty())
 	{
 		aEditor->DeleteRange(mAddedStart, mAddedEnd);
@@ -1640,6 +2603,9 @@ void TextEditor::UndoRecord::Undo(TextEditor * aEditor)
 
 void TextEditor::UndoRecord::Redo(TextEditor * aEditor)
 {
+	for (auto& record : mGroup)
+		record.Redo(aEditor);
+
 	if (!mRemoved.empty())
 	{
 		aEditor->DeleteRange(mRemovedStart, mRemovedEnd);
@@ -36,6 +36,7 @@ public:
 		CurrentLineFill,
 		CurrentLineFillInactive,
 		CurrentLineEdge,
+		SearchMatch,
 		Max
 	};
 
@@ -164,13 +165,27 @@ public:
 	const Palette& GetPalette() const { return mPalette; }
 	void SetPalette(const Palette& aValue);
 
-	void SetErrorMarkers(const ErrorMarkers& aMarkers) { mErrorMarkers = aMarkers; }
-	void SetBreakpoints(const Breakpoints& aMarkers) { mBreakpoints = aMarkers; }
+	void SetErrorMarkers(const ErrorMarkers& aMarkers);
+	void SetBreakpoints(const Breakpoints& aMarkers);
+	ErrorMarkers GetErrorMarkers() const;			// As moved by the edits since they were set
+	Breakpoints GetBreakpoints() const;
 
 	void Render(const char* aTitle, const ImVec2& aSize = ImVec2(), bool aBorder = false);
 	void SetText(const std::string& aText);
+	// Map the file and index its lines without copying it, glyphs are only created for the lines that get displayed, edited or read.
+	// aJobsRunner (same contract as ImGuiIO::DrawJobsRunner) may split the line indexing across threads. A '\r' ending a line is dropped, as by SetText().
+	// The file stays open and mapped until ReleaseFile(), SetText() or the next LoadFile(). It is shared for writing and deleting, but the lines
+	// without glyphs would change with it and Windows doesn't truncate a mapped file: call ReleaseFile() before saving over it.
+	bool LoadFile(const char* aPath, void (*aJobsRunner)(int aJobCount, void (*aRunJob)(int aJobIndex, void* aJobs), void* aJobs, void* aUserData) = nullptr, void* aJobsRunnerUserData = nullptr);
+	// Create the glyphs of the lines still read from the file LoadFile() mapped, then close it
+	void ReleaseFile();
 	std::string GetText() const;
 	std::string GetSelectedText() const;
+	// Writes GetText() into aBuffer (not terminated) when it holds aBufferSize bytes or more, returns the size of the text either way
+	size_t GetText(char* aBuffer, size_t aBufferSize) const;
+	// Changes with every edit of the text, callers keeping a copy of it only need to get it again when IsChangedSince() their copy
+	unsigned int GetVersion() const { return mVersion; }
+	bool IsChangedSince(unsigned int aVersion) const { return mVersion != aVersion; }
 
 	int GetTotalLines() const { return (int)mLines.size(); }
 	bool IsOverwrite() const { return mOverwrite; }
@@ -210,11 +225,25 @@ public:
 	void Undo(int aSteps = 1);
 	void Redo(int aSteps = 1);
 
+	// Search within lines, a match never spans lines. Literal patterns are scanned with memchr() over the characters of the lines,
+	// and over the mapped file for the lines LoadFile() hasn't created glyphs for. Matches in the visible lines get PaletteIndex::SearchMatch.
+	// Returns false if aRegex is set and aPattern isn't a valid ECMAScript expression. An empty pattern ends the search.
+	bool SetSearch(const std::string& aPattern, bool aCaseSensitive = true, bool aRegex = false);
+	const std::string& GetSearch() const { return mSearch.mPattern; }
+	// Select the match after the selection or cursor, wrapping around at the end. The search stops at the first match, the document isn't rescanned.
+	// Right after SetSearch() it starts at the selection start, so a match stays selected while its pattern is typed.
+	bool FindNext(bool aBackwards = false);
+	// Replace the selection if it is a match (regex patterns expand $1.. in aWith), then select the next match. Returns false if there is none.
+	bool Replace(const std::string& aWith);
+	int ReplaceAll(const std::string& aWith);			// One undo step, returns the number of replacements
+
 	static const Palette& GetDarkPalette();
 	static const Palette& GetLightPalette();
 	static const Palette& GetRetroBluePalette();
 
 private:
+	friend struct ImGuiHarness;	// Checks the column conversions of long lines against the glyph walk
+
 	typedef std::vector<std::pair<std::regex, PaletteIndex>> RegexList;
 
 	struct EditorState
@@ -255,19 +284,113 @@ private:
 
 		EditorState mBefore;
 		EditorState mAfter;
+
+		std::vector<UndoRecord> mGroup;	// Edits undone and redone as one step, in the order they were made (ReplaceAll())
 	};
 
 	typedef std::vector<UndoRecord> UndoBuffer;
 
+	struct SearchState
+	{
+		std::string mPattern;
+		std::string mLiteral;		// Pattern in lower case when not case sensitive
+		bool mCaseSensitive;
+		bool mRegex;
+		bool mFromSelectionStart;	// Pattern changed since the last FindNext()
+		std::regex mExpression;
+
+		SearchState() : mCaseSensitive(true), mRegex(false), mFromSelectionStart(false) {}
+	};
+
+	// Where a line of a loaded file is, while it has no glyphs yet, and the multi-line comment state at its start (see ColorizeInternal())
+	struct LineSource
+	{
+		size_t mOffset;
+		int mLength;			// -1 once the line holds its glyphs
+		bool mInComment;
+		bool mInString;
+		bool mSkipFirst;
+
+		LineSource() : mOffset(0), mLength(-1), mInComment(false), mInString(false), mSkipFirst(false) {}
+	};
+
+	// Values attached to line numbers, in a treap ordered by line. A subtree carries an offset pending for all its lines,
+	// so moving every marker after an inserted or removed line is a split and a merge, O(log n), instead of a rebuild.
+	template <typename T>
+	class LineMarkers
+	{
+	public:
+		LineMarkers() : mRoot(-1), mSeed(0x9e3779b9u) {}
+
+		void Clear();
+		bool Empty() const { return mRoot < 0; }
+		void Insert(int aLine, const T& aValue);
+		const T* Find(int aLine) const;
+		void Erase(int aFirst, int aLast);				// Markers of the lines [aFirst, aLast)
+		void Shift(int aFirst, int aDelta);				// Markers of aFirst and after, they must not move over the ones before
+		template <typename Fn>
+		void ForEach(int aFirst, int aLast, Fn aFn) const;	// aFn(line, value) for the markers of [aFirst, aLast), in line order
+
+	private:
+		struct Node
+		{
+			int mLine;
+			int mOffset;		// Pending for the node and its subtree
+			unsigned mPriority;
+			int mLeft, mRight;
+			T mValue;
+		};
+
+		void Push(int aNode);
+		void Split(int aNode, int aLine, int& aBefore, int& aAfter);
+		int Merge(int aBefore, int aAfter);
+		template <typename Fn>
+		void Visit(int aNode, int aOffset, int aFirst, int aLast, Fn& aFn) const;
+
+		std::vector<Node> mNodes;
+		std::vector<int> mFreeNodes;
+		int mRoot;
+		unsigned mSeed;
+	};
+
+	// Tabs of a long line with the visual column each one ends at, so that converting between glyph indices and visual columns
+	// is a binary search instead of a walk from the line start. Built on demand, dropped when the line is edited.
+	struct LineColumns
+	{
+		std::vector<int> mTabs;				// Glyph index of each tab
+		std::vector<int> mTabEnds;			// Visual column after each tab
+	};
+
+	struct FileMapping;
+	struct LineIndexJobs;
+
 	void ProcessInputs();
+	Line& GetLine(int aIndex);
+	const Line& GetLine(int aIndex) const;
+	int GetLineLength(int aIndex) const;
+	bool IsLineLoaded(int aIndex) const { return mLineSources.empty() || mLineSources[aIndex].mLength < 0; }
+	void LoadLine(int aIndex);
+	void UnloadFile();
+	static void RunLineIndexJob(int aJobIndex, void* aJobs);
+	const char* GetLineChars(int aIndex, std::string& aBuffer, int& aLength) const;
+	bool FindInLine(const char* aChars, int aLength, int aFromColumn, int& aStart, int& aEnd) const;
+	bool FindForward(int aFromLine, int aFromColumn, int aToLine, Coordinates& aStart, Coordinates& aEnd) const;
+	bool FindBackward(const Coordinates& aBefore, Coordinates& aStart, Coordinates& aEnd) const;
+	bool IsMatch(const Coordinates& aStart, const Coordinates& aEnd) const;
+	std::string FormatReplacement(const Coordinates& aStart, const std::string& aWith) const;
 	void Colorize(int aFromLine = 0, int aCount = -1);
 	void ColorizeRange(int aFromLine = 0, int aToLine = 0);
 	void ColorizeInternal();
 	int TextDistanceToLineStart(const Coordinates& aFrom) const;
+	int VisualColumnToColumn(int aLine, int aVisualColumn) const;
+	const LineColumns* GetLineColumns(int aIndex, const Line& aLine) const;
+	void OnLineChanged(int aIndex) { ++mVersion; mLineColumns.erase(aIndex); }
+	void OnLinesChanged() { ++mVersion; if (!mLineColumns.empty()) mLineColumns.clear(); }
 	void EnsureCursorVisible();
 	int GetPageSize() const;
 	int AppendBuffer(std::string& aBuffer, char chr, int aIndex);
 	std::string GetText(const Coordinates& aStart, const Coordinates& aEnd) const;
+	size_t CopyText(const Coordinates& aStart, const Coordinates& aEnd, char* aBuffer) const;
 	Coordinates GetActualCursorCoordinates() const;
 	Coordinates SanitizeCoordinates(const Coordinates& aValue) const;
 	void Advance(Coordinates& aCoordinates) const;
@@ -278,6 +401,7 @@ private:
 	Coordinates FindWordStart(const Coordinates& aFrom) const;
 	Coordinates FindWordEnd(const Coordinates& aFrom) const;
 	bool IsOnWordBoundary(const Coordinates& aAt) const;
+	void RemoveMarkers(int aStart, int aEnd);
 	void RemoveLine(int aStart, int aEnd);
 	void RemoveLine(int aIndex);
 	Line& InsertLine(int aIndex);
@@ -306,9 +430,16 @@ private:
 	RegexList mRegexList;
 
 	bool mCheckMultilineComments;
-	Breakpoints mBreakpoints;
-	ErrorMarkers mErrorMarkers;
+	LineMarkers<bool> mBreakpoints;
+	LineMarkers<std::string> mErrorMarkers;
 	ImVec2 mCharAdvance;
 	Coordinates mInteractiveStart, mInteractiveEnd;
+
+	std::unique_ptr<FileMapping> mFile;
+	std::vector<LineSource> mLineSources;	// Parallel to mLines while a loaded file is mapped, empty otherwise
+
+	SearchState mSearch;
+	mutable std::unordered_map<int, LineColumns> mLineColumns;	// Of the long lines measured since the last edit, by line index
+	unsigned int mVersion;
 };
 
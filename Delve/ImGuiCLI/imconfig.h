@@ -33,6 +33,16 @@
 //---- Don't implement ImFormatString(), ImFormatStringV() so you can reimplement them yourself.
 //#define IMGUI_DISABLE_FORMAT_STRING_FUNCTIONS
 
+//---- Compile the scoped timers of the built-in profiler (NewFrame, Begin/End, Render, tessellation, text layout..). See GetProfilerPhase() and the Metrics window.
+//#define IMGUI_ENABLE_PROFILER
+
+//---- Don't cache CalcTextSize() and word-wrap results per font, or change the number of strings remembered per font (see ImFontLayoutCache)
+//#define IMGUI_DISABLE_TEXT_LAYOUT_CACHE
+//#define IMGUI_TEXT_LAYOUT_CACHE_SIZE 8192
+
+//---- Don't use SSE2 in text rendering and text filtering (it is never used in managed /clr builds)
+//#define IMGUI_DISABLE_SSE
+
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 //#define IMGUI_INCLUDE_IMGUI_USER_H
 
@@ -670,6 +670,12 @@
 #else
 #include <stdint.h>     // intptr_t
 #endif
+#ifdef IMGUI_ENABLE_PROFILER
+#include <chrono>       // high_resolution_clock
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>     // _BitScanForward, _InterlockedExchangeAdd
+#endif
 
 #define IMGUI_DEBUG_NAV_SCORING     0
 #define IMGUI_DEBUG_NAV_RECTS       0
@@ -730,15 +736,12 @@ static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* wind
 static ImGuiWindowSettings* AddWindowSettings(const char* name);
 
 static void             LoadIniSettingsFromDisk(const char* ini_filename);
-static void             LoadIniSettingsFromMemory(const char* buf);
-static void             SaveIniSettingsToDisk(const char* ini_filename);
-static void             SaveIniSettingsToMemory(ImVector<char>& out_buf);
+static void             SaveIniSettingsToDisk(const char* ini_filename, bool use_ini_save_fn);
 static void             MarkIniSettingsDirty(ImGuiWindow* window);
 
 static void             ClosePopupToLevel(int remaining);
 
 static bool             InputTextFilterCharacter(unsigned int* p_char, ImGuiInputTextFlags flags, ImGuiTextEditCallback callback, void* user_data);
-static int              InputTextCalcTextLenAndLineCount(const char* text_begin, const char** out_text_end);
 static ImVec2           InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining = NULL, ImVec2* out_offset = NULL, bool stop_on_new_line = false);
 
 static inline void      DataTypeFormatString(ImGuiDataType data_type, void* data_ptr, const char* display_format, char* buf, int buf_size);
@@ -803,7 +806,21 @@ static void    FreeWrapper(void* ptr, void* user_data)        { (void)user_data;
 static void*  (*GImAllocatorAllocFunc)(size_t size, void* user_data) = MallocWrapper;
 static void   (*GImAllocatorFreeFunc)(void* ptr, void* user_data) = FreeWrapper;
 static void*    GImAllocatorUserData = NULL;
-static size_t   GImAllocatorActiveAllocationsCount = 0;
+
+// MemAlloc()/MemFree() also run in draw jobs on worker threads (see io.DrawJobsRunner), so the counters are updated atomically.
+// Intrinsics rather than <atomic>, which /clr builds can't include.
+#ifdef _MSC_VER
+static inline long ImAtomicAdd(volatile long* p, long v)        { return _InterlockedExchangeAdd(p, v); }
+static inline long ImAtomicExchange(volatile long* p, long v)   { return _InterlockedExchange(p, v); }
+static inline long ImAtomicLoad(const volatile long* p)         { return *p; }  // Aligned volatile reads are atomic with MSVC
+#else
+static inline long ImAtomicAdd(volatile long* p, long v)        { return __atomic_fetch_add(p, v, __ATOMIC_RELAXED); }
+static inline long ImAtomicExchange(volatile long* p, long v)   { return __atomic_exchange_n(p, v, __ATOMIC_RELAXED); }
+static inline long ImAtomicLoad(const volatile long* p)         { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+#endif
+static volatile long GImAllocatorActiveAllocationsCount = 0;
+static volatile long GImAllocatorFrameAllocationsCount = 0;     // MemAlloc calls since the last NewFrame()
+static volatile long GImAllocatorTotalAllocationsCount = 0;     // Wraps around, only differences are used
 
 //-----------------------------------------------------------------------------
 // User facing structures
@@ -909,6 +926,10 @@ ImGuiIO::ImGuiIO()
     GetClipboardTextFn = GetClipboardTextFn_DefaultImpl;   // Platform dependent default implementations
     SetClipboardTextFn = SetClipboardTextFn_DefaultImpl;
     ClipboardUserData = NULL;
+    DrawJobsRunner = NULL;
+    DrawJobsRunnerUserData = NULL;
+    IniSaveFn = NULL;
+    IniSaveFnUserData = NULL;
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     RenderDrawListsFn = NULL;
@@ -1224,22 +1245,65 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return 0;
 }
 
-int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
+static inline int ImTextCharToUtf8(char* buf, int buf_size, unsigned int c);
+
+// True when none of the 8 bytes has its high bit set or is zero
+static inline bool ImTextIsAscii8(ImU64 v)
+{
+    return ((v | ((v - 0x0101010101010101ULL) & ~v)) & 0x8080808080808080ULL) == 0;
+}
+
+// True when all 4 characters are non-zero and below 0x80
+static inline bool ImTextIsAsciiW4(ImU64 v)
+{
+    return ((v & 0xFF80FF80FF80FF80ULL) | ((v - 0x0001000100010001ULL) & ~v & 0x8000800080008000ULL)) == 0;
+}
+
+// When in_text_end is known, runs of ASCII are widened 8 bytes at a time.
+// out_lossless is set to false if converting back with ImTextStrToUtf8() would not give the exact input bytes (invalid UTF-8, characters above 0xFFFF, truncation).
+int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining, bool* out_lossless)
 {
     ImWchar* buf_out = buf;
     ImWchar* buf_end = buf + buf_size;
+    bool lossless = true;
     while (buf_out < buf_end-1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+        if (in_text_end)
+        {
+            while (in_text_end - in_text >= 8 && buf_end - buf_out > 8)
+            {
+                ImU64 v;
+                memcpy(&v, in_text, 8);
+                if (!ImTextIsAscii8(v))
+                    break;
+                const unsigned char* src = (const unsigned char*)in_text;
+                for (int n = 0; n < 8; n++)
+                    buf_out[n] = (ImWchar)src[n];
+                buf_out += 8;
+                in_text += 8;
+            }
+            if (buf_out >= buf_end-1 || in_text >= in_text_end || !*in_text)
+                break;
+        }
         unsigned int c;
+        const char* in_char = in_text;
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         if (c == 0)
             break;
         if (c < 0x10000)    // FIXME: Losing characters that don't fit in 2 bytes
             *buf_out++ = (ImWchar)c;
+        if (out_lossless && c >= 0x80 && lossless)
+        {
+            char enc[4];
+            const int enc_len = c < 0x10000 ? ImTextCharToUtf8(enc, 4, c) : 0;
+            lossless = enc_len == (int)(in_text - in_char) && memcmp(enc, in_char, enc_len) == 0;
+        }
     }
     *buf_out = 0;
     if (in_text_remaining)
         *in_text_remaining = in_text;
+    if (out_lossless)
+        *out_lossless = lossless && (in_text_end ? in_text == in_text_end : *in_text == 0);
     return (int)(buf_out - buf);
 }
 
@@ -1311,6 +1375,23 @@ int ImTextStrToUtf8(char* buf, int buf_size, const ImWchar* in_text, const ImWch
     const char* buf_end = buf + buf_size;
     while (buf_out < buf_end-1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+        if (in_text_end && sizeof(ImWchar) == 2)
+        {
+            // Runs of ASCII are narrowed 4 characters at a time (8 bytes of 2-byte ImWchar, other sizes take the loop below)
+            while (in_text_end - in_text >= 4 && buf_end - buf_out > 4)
+            {
+                ImU64 v;
+                memcpy(&v, in_text, 8);
+                if (!ImTextIsAsciiW4(v))
+                    break;
+                for (int n = 0; n < 4; n++)
+                    buf_out[n] = (char)in_text[n];
+                buf_out += 4;
+                in_text += 4;
+            }
+            if (buf_out >= buf_end-1 || in_text >= in_text_end || !*in_text)
+                break;
+        }
         unsigned int c = (unsigned int)(*in_text++);
         if (c < 0x80)
             *buf_out++ = (char)c;
@@ -1755,7 +1836,215 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 #define va_copy(dest, src) (dest = src)
 #endif
 
+// Batch filtering. Each term is searched over the whole packed buffer at once instead of string by string: candidates are positions
+// whose first and last bytes match the term (16 positions at a time with SSE2), mapped back to their string and verified there.
+// As in PassFilter(), the first term found in a string decides, so strings already decided by an earlier term are skipped.
+
+#if IMGUI_SSE
+static inline int ImCountTrailingZeros(unsigned int v)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return (int)index;
+#else
+    return __builtin_ctz(v);
+#endif
+}
+#endif
+
+static inline char ImToUpperAscii(char c) { return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c; }
+
+struct ImTextFilterTerm
+{
+    const char*     Needle;         // Upper case. Empty for a lone "-", which goes through ImStristr() to behave exactly as in PassFilter().
+    int             Length;
+    bool            Subtract;
+};
+
+struct ImTextFilterBatch
+{
+    const char*             Buf;
+    const int*              Offsets;
+    int                     Count;
+    int                     StringsPerJob;
+    const ImTextFilterTerm* Terms;
+    int                     TermsCount;
+    unsigned char*                   FirstTerm;  // Per string: index of the first term found in it, 0xFF when none
+};
+
+static void ImTextFilterScanTerm(const ImTextFilterBatch* batch, int term_n, int s_begin, int s_end)
+{
+    const char* buf = batch->Buf;
+    const int* offsets = batch->Offsets;
+    unsigned char* first_term = batch->FirstTerm;
+    const char* needle = batch->Terms[term_n].Needle;
+    const int needle_len = batch->Terms[term_n].Length;
+    const char c_first = needle[0];
+    const char c_last = needle[needle_len - 1];
+#if IMGUI_SSE
+    // OR-ing 0x20 folds letters to lower case, the verification below takes care of the other characters it aliases
+    const bool first_alpha = (c_first >= 'A' && c_first <= 'Z');
+    const bool last_alpha = (c_last >= 'A' && c_last <= 'Z');
+    const __m128i fold_first = _mm_set1_epi8(first_alpha ? 0x20 : 0);
+    const __m128i fold_last = _mm_set1_epi8(last_alpha ? 0x20 : 0);
+    const __m128i want_first = _mm_set1_epi8(first_alpha ? (char)(c_first | 0x20) : c_first);
+    const __m128i want_last = _mm_set1_epi8(last_alpha ? (char)(c_last | 0x20) : c_last);
+#endif
+
+    int s = s_begin;
+    const char* p = buf + offsets[s_begin];
+    const char* end = buf + offsets[s_end];
+    while (end - p >= needle_len)
+    {
+        const char* q;
+#if IMGUI_SSE
+        if (end - p >= needle_len - 1 + 16)
+        {
+            const __m128i v_first = _mm_or_si128(_mm_loadu_si128((const __m128i*)p), fold_first);
+            const __m128i v_last = _mm_or_si128(_mm_loadu_si128((const __m128i*)(p + needle_len - 1)), fold_last);
+            const int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(v_first, want_first), _mm_cmpeq_epi8(v_last, want_last)));
+            if (mask == 0)
+            {
+                p += 16;
+                continue;
+            }
+            q = p + ImCountTrailingZeros((unsigned int)mask);
+        }
+        else
+#endif
+        {
+            if (ImToUpperAscii(p[0]) != c_first || ImToUpperAscii(p[needle_len - 1]) != c_last)
+            {
+                p++;
+                continue;
+            }
+            q = p;
+        }
+
+        const int q_offset = (int)(q - buf);
+        while (offsets[s + 1] <= q_offset)
+            s++;
+        const char* str_end = buf + offsets[s + 1];
+        if (first_term[s] != 0xFF)
+        {
+            p = str_end;
+            continue;
+        }
+        int i = 1;
+        if (q + needle_len <= str_end)
+            while (i < needle_len - 1 && ImToUpperAscii(q[i]) == needle[i])
+                i++;
+        if (q + needle_len <= str_end && i >= needle_len - 1)
+        {
+            first_term[s] = (unsigned char)term_n;
+            p = str_end;
+        }
+        else
+        {
+            p = q + 1;
+        }
+    }
+}
+
+static void ImTextFilterRunJob(int job_index, void* jobs)
+{
+    const ImTextFilterBatch* batch = (const ImTextFilterBatch*)jobs;
+    const int s_begin = job_index * batch->StringsPerJob;
+    const int s_end = ImMin(s_begin + batch->StringsPerJob, batch->Count);
+    memset(batch->FirstTerm + s_begin, 0xFF, (size_t)(s_end - s_begin));
+    for (int term_n = 0; term_n < batch->TermsCount; term_n++)
+    {
+        const ImTextFilterTerm& term = batch->Terms[term_n];
+        if (term.Length > 0)
+        {
+            ImTextFilterScanTerm(batch, term_n, s_begin, s_end);
+            continue;
+        }
+        for (int s = s_begin; s < s_end; s++)
+            if (batch->FirstTerm[s] == 0xFF && ImStristr(batch->Buf + batch->Offsets[s], batch->Buf + batch->Offsets[s + 1], term.Needle, term.Needle) != NULL)
+                batch->FirstTerm[s] = (unsigned char)term_n;
+    }
+}
+
+int ImGuiTextFilter::PassFilterMany(const char* buf, const int* offsets, int count, ImVector<int>* out_indices, void (*jobs_runner)(int job_count, void (*run_job)(int job_index, void* jobs), void* jobs, void* user_data), void* jobs_runner_user_data) const
+{
+    const int out_start = out_indices->Size;
+    if (Filters.empty())
+    {
+        out_indices->resize(out_start + count);
+        for (int s = 0; s < count; s++)
+            (*out_indices)[out_start + s] = s;
+        return count;
+    }
+
+    // Upper case copies of the terms, in filter order. InputBuf bounds their count and total length.
+    char needles[IM_ARRAYSIZE(InputBuf)];
+    ImTextFilterTerm terms[IM_ARRAYSIZE(InputBuf) / 2 + 1];
+    int terms_count = 0;
+    char* needles_end = needles;
+    for (int i = 0; i != Filters.Size; i++)
+    {
+        const TextRange& f = Filters[i];
+        if (f.empty())
+            continue;
+        ImTextFilterTerm& term = terms[terms_count++];
+        term.Subtract = (f.front() == '-');
+        const char* b = term.Subtract ? f.begin() + 1 : f.begin();
+        term.Length = (int)(f.end() - b);
+        term.Needle = term.Length > 0 ? needles_end : b;
+        for (const char* c = b; c < f.end(); c++)
+            *needles_end++ = ImToUpperAscii(*c);
+    }
+    IM_ASSERT(terms_count < 0xFF && needles_end <= needles + IM_ARRAYSIZE(needles));
+
+    ImVector<unsigned char> first_term;
+    first_term.resize(count);
+    ImTextFilterBatch batch;
+    batch.Buf = buf;
+    batch.Offsets = offsets;
+    batch.Count = count;
+    batch.StringsPerJob = 16 * 1024;
+    batch.Terms = terms;
+    batch.TermsCount = terms_count;
+    batch.FirstTerm = first_term.Data;
+    const int job_count = (count + batch.StringsPerJob - 1) / batch.StringsPerJob;
+    if (jobs_runner && job_count > 1)
+        jobs_runner(job_count, ImTextFilterRunJob, &batch, jobs_runner_user_data);
+    else
+        for (int job_n = 0; job_n < job_count; job_n++)
+            ImTextFilterRunJob(job_n, &batch);
+
+    // Strings none of the terms were found in pass when there are only exclusions (implicit * grep)
+    for (int s = 0; s < count; s++)
+    {
+        const int term_n = first_term[s];
+        if (term_n == 0xFF ? CountGrep == 0 : !terms[term_n].Subtract)
+            out_indices->push_back(s);
+    }
+    return out_indices->Size - out_start;
+}
+
 // Helper: Text buffer for logging/accumulating text
+void ImGuiTextBuffer::append(const char* str, const char* str_end)
+{
+    const int len = str_end ? (int)(str_end - str) : (int)strlen(str);
+    if (len <= 0)
+        return;
+
+    const int write_off = Buf.Size;
+    const int needed_sz = write_off + len;
+    if (needed_sz >= Buf.Capacity)
+    {
+        int double_capacity = Buf.Capacity * 2;
+        Buf.reserve(needed_sz > double_capacity ? needed_sz : double_capacity);
+    }
+
+    Buf.resize(needed_sz);
+    memcpy(&Buf[write_off - 1], str, (size_t)len);
+    Buf[needed_sz - 1] = 0;
+}
+
 void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
 {
     va_list args_copy;
@@ -2613,16 +2902,170 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
 
 void* ImGui::MemAlloc(size_t sz)
 {
-    GImAllocatorActiveAllocationsCount++;
+    ImAtomicAdd(&GImAllocatorActiveAllocationsCount, 1);
+    ImAtomicAdd(&GImAllocatorFrameAllocationsCount, 1);
+    ImAtomicAdd(&GImAllocatorTotalAllocationsCount, 1);
     return GImAllocatorAllocFunc(sz, GImAllocatorUserData);
 }
 
 void ImGui::MemFree(void* ptr)
 {
-    if (ptr) GImAllocatorActiveAllocationsCount--;
+    if (ptr) ImAtomicAdd(&GImAllocatorActiveAllocationsCount, -1);
     return GImAllocatorFreeFunc(ptr, GImAllocatorUserData);
 }
 
+void* ImGui::MemAllocFrame(size_t sz)
+{
+    ImGuiContext& g = *GImGui;
+    g.FrameAllocBytes += sz;
+    if (g.FrameAllocFunc)
+        return g.FrameAllocFunc(sz, g.FrameAllocUserData);
+    return g.FrameArena.Alloc(sz);
+}
+
+void ImGui::SetFrameAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*reset_func)(void* user_data), void* user_data)
+{
+    ImGuiContext& g = *GImGui;
+    g.FrameAllocFunc = alloc_func;
+    g.FrameResetFunc = alloc_func ? reset_func : NULL;
+    g.FrameAllocUserData = alloc_func ? user_data : NULL;
+}
+
+void* ImGuiFrameArena::Alloc(size_t sz)
+{
+    sz = (sz + 15) & ~(size_t)15;
+    Requested += sz;
+    if (Used + sz <= Size)
+    {
+        void* ptr = Data + Used;
+        Used += sz;
+        return ptr;
+    }
+    // Doesn't fit, spill to the heap for this frame. Reset() will grow the block to cover it next time.
+    void* ptr = ImGui::MemAlloc(sz);
+    Spilled.push_back(ptr);
+    return ptr;
+}
+
+void ImGuiFrameArena::Reset()
+{
+    for (int n = 0; n < Spilled.Size; n++)
+        ImGui::MemFree(Spilled[n]);
+    Spilled.resize(0);
+
+    // Grow to cover this frame. Shrinking waits for a whole window of smaller frames and a block 4x more than needed, so one large frame
+    // doesn't keep its memory for the rest of the run and sizes going up and down don't reallocate every few frames.
+    size_t new_size = Size;
+    if (Requested > Size)
+        new_size = (Requested + Requested / 2 + 4095) & ~(size_t)4095;
+    if (Requested > PeakRequested)
+        PeakRequested = Requested;
+    if (ShrinkAfter > 0 && ++PeakCount >= ShrinkAfter)
+    {
+        const size_t peak_size = (PeakRequested + PeakRequested / 2 + 4095) & ~(size_t)4095;
+        if (peak_size * 4 <= new_size)
+            new_size = peak_size;
+        PeakRequested = 0;
+        PeakCount = 0;
+    }
+    if (new_size != Size)
+    {
+        ImGui::MemFree(Data);
+        Size = new_size;
+        Data = (Size > 0) ? (char*)ImGui::MemAlloc(Size) : NULL;
+    }
+    Used = Requested = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Profiler
+//-----------------------------------------------------------------------------
+
+static const char* GProfilerPhaseNames[ImGuiProfilePhase_COUNT] = { "NewFrame", "Begin", "End", "Render", "UpdatePlatformWindows", "Tessellation", "TextLayout" };
+
+#ifdef IMGUI_ENABLE_PROFILER
+static ImU64 ProfilerGetTicks()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+ImGuiProfileScope::ImGuiProfileScope(ImGuiProfilePhase_ phase)
+{
+    // Draw lists and fonts may be used without a context, or from draw jobs on worker threads
+    Phase = (GImGui && !GImGui->DrawJobsRunning) ? &GImGui->Profiler.Phases[phase] : NULL;
+    if (!Phase)
+        return;
+    Phase->Calls++;
+    if (Phase->Depth++ == 0)
+    {
+        StartAllocations = (size_t)ImAtomicLoad(&GImAllocatorTotalAllocationsCount);
+        StartTicks = ProfilerGetTicks();
+    }
+}
+
+ImGuiProfileScope::~ImGuiProfileScope()
+{
+    if (Phase && --Phase->Depth == 0)
+    {
+        Phase->Ticks += ProfilerGetTicks() - StartTicks;
+        Phase->Allocations += (int)((unsigned long)ImAtomicLoad(&GImAllocatorTotalAllocationsCount) - (unsigned long)StartAllocations);
+    }
+}
+#endif
+
+static void ProfilerEndFrame(ImGuiProfiler& profiler, int frame_count)
+{
+    for (int n = 0; n < ImGuiProfilePhase_COUNT; n++)
+    {
+        ImGuiProfilerPhaseData& phase = profiler.Phases[n];
+        profiler.LastPhases[n] = phase;
+        phase.Ticks = 0;
+        phase.Calls = phase.Allocations = 0;
+    }
+    profiler.LastFrameCount = frame_count;
+}
+
+int ImGui::GetProfilerPhaseCount()
+{
+    return ImGuiProfilePhase_COUNT;
+}
+
+bool ImGui::GetProfilerPhase(int phase, ImGuiProfilerPhase* out_phase)
+{
+    if (phase < 0 || phase >= ImGuiProfilePhase_COUNT)
+        return false;
+    const ImGuiProfilerPhaseData& data = GImGui->Profiler.LastPhases[phase];
+    out_phase->Name = GProfilerPhaseNames[phase];
+    out_phase->TimeMs = (float)((double)data.Ticks / 1000000.0);
+    out_phase->Calls = data.Calls;
+    out_phase->Allocations = data.Allocations;
+    return true;
+}
+
+void ImGui::ProfilerAppendFrameJson(ImGuiTextBuffer* buf)
+{
+    ImGuiContext& g = *GImGui;
+    buf->appendf("{\"frame\":%d,\"vertices\":%d,\"indices\":%d,\"allocations\":%d,\"phases\":{", g.Profiler.LastFrameCount, g.IO.MetricsRenderVertices, g.IO.MetricsRenderIndices, g.IO.MetricsAllocations);
+    for (int n = 0; n < ImGuiProfilePhase_COUNT; n++)
+    {
+        ImGuiProfilerPhase phase;
+        GetProfilerPhase(n, &phase);
+        buf->appendf("%s\"%s\":{\"ms\":%.4f,\"calls\":%d,\"allocations\":%d}", n > 0 ? "," : "", phase.Name, phase.TimeMs, phase.Calls, phase.Allocations);
+    }
+    buf->appendf("}}");
+}
+
+void ImGuiFrameArena::Clear()
+{
+    for (int n = 0; n < Spilled.Size; n++)
+        ImGui::MemFree(Spilled[n]);
+    Spilled.clear();
+    ImGui::MemFree(Data);
+    Data = NULL;
+    Size = Used = Requested = PeakRequested = 0;
+    PeakCount = 0;
+}
+
 const char* ImGui::GetClipboardText()
 {
     return GImGui->IO.GetClipboardTextFn ? GImGui->IO.GetClipboardTextFn(GImGui->IO.ClipboardUserData) : "";
@@ -3574,6 +4017,7 @@ static void ImGui::UpdateViewports()
 void ImGui::UpdatePlatformWindows()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILE_SCOPE(ImGuiProfilePhase_UpdatePlatformWindows);
     IM_ASSERT(g.FrameCountEnded == g.FrameCount && "Forgot to call Render() or EndFrame() before UpdatePlatformWindows()?");
     IM_ASSERT(g.FrameCountPlatformEnded < g.FrameCount);
     g.FrameCountPlatformEnded = g.FrameCount;
@@ -3833,6 +4277,9 @@ void ImGui::NewFrame()
     IM_ASSERT(GImGui != NULL && "No current context. Did you call ImGui::CreateContext() or ImGui::SetCurrentContext()?");
     ImGuiContext& g = *GImGui;
 
+    ProfilerEndFrame(g.Profiler, g.FrameCount);
+    IMGUI_PROFILE_SCOPE(ImGuiProfilePhase_NewFrame);
+
     // Check user data
     // (We pass an error message in the assert expression to make it visible to programmers who are not using a debugger, as most assert handlers display their argument)
     IM_ASSERT(g.Initialized);
@@ -3880,6 +4327,17 @@ void ImGui::NewFrame()
         }
     }
 
+    // Release transient allocations of the previous frame and publish the allocation counters
+    if (g.FrameResetFunc)
+        g.FrameResetFunc(g.FrameAllocUserData);
+    else
+        g.FrameArena.Reset();
+    g.IO.MetricsAllocations = (int)ImAtomicExchange(&GImAllocatorFrameAllocationsCount, 0);
+    g.IO.MetricsActiveAllocations = (int)ImAtomicLoad(&GImAllocatorActiveAllocationsCount);
+    g.IO.MetricsFrameArenaBytes = (int)g.FrameAllocBytes;
+    g.FrameAllocBytes = 0;
+    g.DrawJobs.resize(0); // Left over when Render() wasn't called, their user data just went away with the arena
+
     // Load settings on first frame
     if (!g.SettingsLoaded)
     {
@@ -3893,7 +4351,7 @@ void ImGui::NewFrame()
     {
         g.SettingsDirtyTimer -= g.IO.DeltaTime;
         if (g.SettingsDirtyTimer <= 0.0f)
-            SaveIniSettingsToDisk(g.IO.IniFilename);
+            SaveIniSettingsToDisk(g.IO.IniFilename, true);
     }
 
     g.Time += g.IO.DeltaTime;
@@ -4061,6 +4519,7 @@ static void* SettingsHandlerWindow_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*
     ImGuiWindowSettings* settings = ImGui::FindWindowSettings(ImHash(name, 0));
     if (!settings)
         settings = AddWindowSettings(name);
+    settings->IniOffset = -1;
     return (void*)settings;
 }
 
@@ -4070,16 +4529,34 @@ static void SettingsHandlerWindow_ReadLine(ImGuiContext*, ImGuiSettingsHandler*,
     float x, y; 
     int i;
     ImU32 u1;
-    if (sscanf(line, "Pos=%f,%f", &x, &y) == 2)                 { settings->Pos = ImVec2(x, y); }
-    else if (sscanf(line, "Size=%f,%f", &x, &y) == 2)           { settings->Size = ImMax(ImVec2(x, y), GImGui->Style.WindowMinSize); }
-    else if (sscanf(line, "ViewportId=0x%08X", &u1) == 1)       { settings->ViewportId = u1; }
-    else if (sscanf(line, "ViewportPos=%f,%f", &x, &y) == 2)    { settings->ViewportPos = ImVec2(x, y); }
-    else if (sscanf(line, "Collapsed=%d", &i) == 1)             { settings->Collapsed = (i != 0); }
+    // Dispatch on the first letters so each line costs a single sscanf() call
+    if (line[0] == 'P')         { if (sscanf(line, "Pos=%f,%f", &x, &y) == 2) settings->Pos = ImVec2(x, y); }
+    else if (line[0] == 'S')    { if (sscanf(line, "Size=%f,%f", &x, &y) == 2) settings->Size = ImMax(ImVec2(x, y), GImGui->Style.WindowMinSize); }
+    else if (line[0] == 'V')    { if (sscanf(line, "ViewportPos=%f,%f", &x, &y) == 2) settings->ViewportPos = ImVec2(x, y); else if (sscanf(line, "ViewportId=0x%08X", &u1) == 1) settings->ViewportId = u1; }
+    else if (line[0] == 'C')    { if (sscanf(line, "Collapsed=%d", &i) == 1) settings->Collapsed = (i != 0); }
+}
+
+static void SettingsHandlerWindow_WriteEntry(ImGuiSettingsHandler* handler, const ImGuiWindowSettings* settings, ImGuiTextBuffer* buf)
+{
+    const char* name = settings->Name;
+    if (const char* p = strstr(name, "###"))  // Skip to the "###" marker if any. We don't skip past to match the behavior of GetID()
+        name = p;
+    buf->appendf("[%s][%s]\n", handler->TypeName, name);
+    if (settings->ViewportId != 0 && settings->ViewportId != ImGui::IMGUI_VIEWPORT_DEFAULT_ID)
+    {
+        buf->appendf("ViewportPos=%d,%d\n", (int)settings->ViewportPos.x, (int)settings->ViewportPos.y);
+        buf->appendf("ViewportId=0x%08X\n", settings->ViewportId);
+    }
+    if (settings->Pos.x != 0.0f || settings->Pos.y != 0.0f || settings->ViewportId == ImGui::IMGUI_VIEWPORT_DEFAULT_ID)
+        buf->appendf("Pos=%d,%d\n", (int)settings->Pos.x, (int)settings->Pos.y);
+    buf->appendf("Size=%d,%d\n", (int)settings->Size.x, (int)settings->Size.y);
+    buf->appendf("Collapsed=%d\n", settings->Collapsed);
+    buf->appendf("\n");
 }
 
 static void SettingsHandlerWindow_WriteAll(ImGuiContext* imgui_ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
 {
-    // Gather data from windows that were active during this session
+    // Gather data from windows that were active during this session, flagging the entries that changed
     ImGuiContext& g = *imgui_ctx;
     for (int i = 0; i != g.Windows.Size; i++)
     {
@@ -4089,34 +4566,46 @@ static void SettingsHandlerWindow_WriteAll(ImGuiContext* imgui_ctx, ImGuiSetting
         ImGuiWindowSettings* settings = ImGui::FindWindowSettings(window->ID);
         if (!settings)
             settings = AddWindowSettings(window->Name);
-        settings->Pos = window->Pos - window->ViewportPos;
-        settings->Size = window->SizeFull;
-        settings->ViewportId = window->ViewportId;
-        settings->ViewportPos = window->ViewportPos;
-        settings->Collapsed = window->Collapsed;
+        const ImVec2 pos = window->Pos - window->ViewportPos;
+        if (settings->Pos.x != pos.x || settings->Pos.y != pos.y || settings->Size.x != window->SizeFull.x || settings->Size.y != window->SizeFull.y ||
+            settings->ViewportId != window->ViewportId || settings->ViewportPos.x != window->ViewportPos.x || settings->ViewportPos.y != window->ViewportPos.y ||
+            settings->Collapsed != window->Collapsed)
+        {
+            settings->Pos = pos;
+            settings->Size = window->SizeFull;
+            settings->ViewportId = window->ViewportId;
+            settings->ViewportPos = window->ViewportPos;
+            settings->Collapsed = window->Collapsed;
+            settings->IniOffset = -1;
+        }
     }
 
     // Write a buffer
-    // If a window wasn't opened in this session we preserve its settings
-    buf->reserve(buf->size() + g.SettingsWindows.Size * 96); // ballpark reserve
+    // If a window wasn't opened in this session we preserve its settings. Entries that didn't change since the last save are copied from g.SettingsWindowsIni instead of being formatted again.
+    int dirty_count = 0;
     for (int i = 0; i != g.SettingsWindows.Size; i++)
-    {
-        const ImGuiWindowSettings* settings = &g.SettingsWindows[i];
-        const char* name = settings->Name;
-        if (const char* p = strstr(name, "###"))  // Skip to the "###" marker if any. We don't skip past to match the behavior of GetID()
-            name = p;
-        buf->appendf("[%s][%s]\n", handler->TypeName, name);
-        if (settings->ViewportId != 0 && settings->ViewportId != ImGui::IMGUI_VIEWPORT_DEFAULT_ID)
-        {
-            buf->appendf("ViewportPos=%d,%d\n", (int)settings->ViewportPos.x, (int)settings->ViewportPos.y);
-            buf->appendf("ViewportId=0x%08X\n", settings->ViewportId);
+        if (g.SettingsWindows[i].IniOffset < 0)
+            dirty_count++;
+    if (dirty_count > 0)
+    {
+        ImGuiTextBuffer text;
+        text.reserve(g.SettingsWindowsIni.Size + dirty_count * 96 + 1); // ballpark reserve
+        for (int i = 0; i != g.SettingsWindows.Size; i++)
+        {
+            ImGuiWindowSettings* settings = &g.SettingsWindows[i];
+            const int offset = text.size();
+            if (settings->IniOffset >= 0)
+                text.append(g.SettingsWindowsIni.Data + settings->IniOffset, g.SettingsWindowsIni.Data + settings->IniOffset + settings->IniLength);
+            else
+                SettingsHandlerWindow_WriteEntry(handler, settings, &text);
+            settings->IniOffset = offset;
+            settings->IniLength = text.size() - offset;
         }
-        if (settings->Pos.x != 0.0f || settings->Pos.y != 0.0f || settings->ViewportId == ImGui::IMGUI_VIEWPORT_DEFAULT_ID)
-            buf->appendf("Pos=%d,%d\n", (int)settings->Pos.x, (int)settings->Pos.y);
-        buf->appendf("Size=%d,%d\n", (int)settings->Size.x, (int)settings->Size.y);
-        buf->appendf("Collapsed=%d\n", settings->Collapsed);
-        buf->appendf("\n");
+        text.Buf.pop_back(); // Remove zero-terminator
+        g.SettingsWindowsIni.swap(text.Buf);
     }
+    if (g.SettingsWindowsIni.Size > 0)
+        buf->append(g.SettingsWindowsIni.begin(), g.SettingsWindowsIni.end());
 }
 
 void ImGui::Initialize(ImGuiContext* context)
@@ -4173,7 +4662,7 @@ void ImGui::Shutdown(ImGuiContext* context)
 
     // Save settings (unless we haven't attempted to load them: CreateContext/DestroyContext without a call to NewFrame shouldn't save an empty file)
     if (g.SettingsLoaded)
-        SaveIniSettingsToDisk(g.IO.IniFilename);
+        SaveIniSettingsToDisk(g.IO.IniFilename, false);
 
     // Destroy platform windows
     ImGuiContext* backup_context = ImGui::GetCurrentContext();
@@ -4186,6 +4675,11 @@ void ImGui::Shutdown(ImGuiContext* context)
         IM_DELETE(g.Windows[i]);
     g.Windows.clear();
     g.WindowsSortBuffer.clear();
+    g.FrameArena.Clear();
+    g.DrawJobs.clear();
+    for (int i = 0; i < g.DrawJobListsPool.Size; i++)
+        IM_DELETE(g.DrawJobListsPool[i]);
+    g.DrawJobListsPool.clear();
     g.CurrentWindow = NULL;
     g.CurrentWindowStack.clear();
     g.WindowsById.Clear();
@@ -4207,10 +4701,15 @@ void ImGui::Shutdown(ImGuiContext* context)
     g.InputTextState.Text.clear();
     g.InputTextState.InitialText.clear();
     g.InputTextState.TempTextBuffer.clear();
+    g.InputTextState.LineStartsW.clear();
+    g.InputTextState.LineStartsA.clear();
 
     for (int i = 0; i < g.SettingsWindows.Size; i++)
         IM_DELETE(g.SettingsWindows[i].Name);
     g.SettingsWindows.clear();
+    g.SettingsWindowsIndex.Clear();
+    g.SettingsWindowsIni.clear();
+    g.SettingsIniData.clear();
     g.SettingsHandlers.clear();
 
     if (g.LogFile && g.LogFile != stdout)
@@ -4228,10 +4727,8 @@ void ImGui::Shutdown(ImGuiContext* context)
 ImGuiWindowSettings* ImGui::FindWindowSettings(ImGuiID id)
 {
     ImGuiContext& g = *GImGui;
-    for (int i = 0; i != g.SettingsWindows.Size; i++)
-        if (g.SettingsWindows[i].Id == id)
-            return &g.SettingsWindows[i];
-    return NULL;
+    const int index = g.SettingsWindowsIndex.GetInt(id, -1);
+    return index >= 0 ? &g.SettingsWindows[index] : NULL;
 }
 
 static ImGuiWindowSettings* AddWindowSettings(const char* name)
@@ -4241,6 +4738,7 @@ static ImGuiWindowSettings* AddWindowSettings(const char* name)
     ImGuiWindowSettings* settings = &g.SettingsWindows.back();
     settings->Name = ImStrdup(name);
     settings->Id = ImHash(name, 0);
+    g.SettingsWindowsIndex.SetInt(settings->Id, g.SettingsWindows.Size - 1);
     return settings;
 }
 
@@ -4251,7 +4749,7 @@ static void LoadIniSettingsFromDisk(const char* ini_filename)
     char* file_data = (char*)ImFileLoadToMemory(ini_filename, "rb", NULL, +1);
     if (!file_data)
         return;
-    LoadIniSettingsFromMemory(file_data);
+    ImGui::LoadIniSettingsFromMemory(file_data);
     ImGui::MemFree(file_data);
 }
 
@@ -4266,7 +4764,7 @@ ImGuiSettingsHandler* ImGui::FindSettingsHandler(const char* type_name)
 }
 
 // Zero-tolerance, no error reporting, cheap .ini parsing
-static void LoadIniSettingsFromMemory(const char* buf_readonly)
+void ImGui::LoadIniSettingsFromMemory(const char* buf_readonly)
 {
     // For convenience and to make the code simpler, we'll write zero terminators inside the buffer. So let's create a writable copy.
     char* buf = ImStrdup(buf_readonly);
@@ -4305,7 +4803,7 @@ static void LoadIniSettingsFromMemory(const char* buf_readonly)
                 *type_end = 0; // Overwrite first ']' 
                 name_start++;  // Skip second '['
             }
-            entry_handler = ImGui::FindSettingsHandler(type_start);
+            entry_handler = FindSettingsHandler(type_start);
             entry_data = entry_handler ? entry_handler->ReadOpenFn(&g, entry_handler, name_start) : NULL;
         }
         else if (entry_handler != NULL && entry_data != NULL)
@@ -4319,37 +4817,48 @@ static void LoadIniSettingsFromMemory(const char* buf_readonly)
     g.SettingsLoaded = true;
 }
 
-static void SaveIniSettingsToDisk(const char* ini_filename)
+static void SaveIniSettingsToDisk(const char* ini_filename, bool use_ini_save_fn)
 {
     ImGuiContext& g = *GImGui;
     g.SettingsDirtyTimer = 0.0f;
     if (!ini_filename)
         return;
 
-    ImVector<char> buf;
-    SaveIniSettingsToMemory(buf);
+    size_t ini_size;
+    const char* ini_data = ImGui::SaveIniSettingsToMemory(&ini_size);
+    if (use_ini_save_fn && g.IO.IniSaveFn)
+    {
+        g.IO.IniSaveFn(ini_filename, ini_data, ini_size, g.IO.IniSaveFnUserData);
+        return;
+    }
 
     FILE* f = ImFileOpen(ini_filename, "wt");
     if (!f)
         return;
-    fwrite(buf.Data, sizeof(char), (size_t)buf.Size, f);
+    fwrite(ini_data, sizeof(char), ini_size, f);
     fclose(f);
 }
 
-static void SaveIniSettingsToMemory(ImVector<char>& out_buf)
+// The text is built into g.SettingsIniData, whose memory is reused from one save to the next
+const char* ImGui::SaveIniSettingsToMemory(size_t* out_ini_size)
 {
     ImGuiContext& g = *GImGui;
     g.SettingsDirtyTimer = 0.0f;
 
     ImGuiTextBuffer buf;
+    buf.Buf.swap(g.SettingsIniData);
+    buf.Buf.resize(0);
+    buf.Buf.push_back(0);
     for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
     {
         ImGuiSettingsHandler* handler = &g.SettingsHandlers[handler_n];
         handler->WriteAllFn(&g, handler, &buf);
     }
+    g.SettingsIniData.swap(buf.Buf);
 
-    buf.Buf.pop_back(); // Remove extra zero-terminator used by ImGuiTextBuffer
-    out_buf.swap(buf.Buf);
+    if (out_ini_size)
+        *out_ini_size = (size_t)g.SettingsIniData.Size - 1;
+    return g.SettingsIniData.Data;
 }
 
 void ImGui::MarkIniSettingsDirty()
@@ -4432,6 +4941,8 @@ static void AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* d
 static void AddWindowToDrawData(ImGuiWindow* window, int layer)
 {
     AddDrawListToDrawData(&window->Viewport->DrawDataBuilder.Layers[layer], window->DrawList);
+    for (int i = 0; i < window->DrawJobLists.Size; i++)
+        AddDrawListToDrawData(&window->Viewport->DrawDataBuilder.Layers[layer], window->DrawJobLists[i]);
     for (int i = 0; i < window->DC.ChildWindows.Size; i++)
     {
         ImGuiWindow* child = window->DC.ChildWindows[i];
@@ -4608,14 +5119,51 @@ void ImGui::EndFrame()
     g.FrameCountEnded = g.FrameCount;
 }
 
+static void RunDrawJob(int job_index, void* jobs)
+{
+    const ImGuiDrawJob& job = ((const ImGuiDrawJob*)jobs)[job_index];
+    ImDrawList* draw_list = job.DrawList;
+    draw_list->Clear();
+    draw_list->Flags = job.Flags;
+    draw_list->PushTextureID(job.TextureId);
+    draw_list->PushClipRect(ImVec2(job.ClipRect.x, job.ClipRect.y), ImVec2(job.ClipRect.z, job.ClipRect.w));
+    job.Fn(draw_list, job.UserData);
+}
+
+// Each job only writes to its own draw list, so the output doesn't depend on how io.DrawJobsRunner spreads them over threads
+static void RunDrawJobs()
+{
+    ImGuiContext& g = *GImGui;
+    if (g.DrawJobs.Size == 0)
+        return;
+
+    ImVector<ImFont*>& fonts = g.IO.Fonts->Fonts;
+    for (int n = 0; n < fonts.Size; n++)
+        if (fonts[n]->LayoutCache)
+            fonts[n]->LayoutCache->Frozen = true;
+    g.DrawJobsRunning = true;
+    if (g.IO.DrawJobsRunner)
+        g.IO.DrawJobsRunner(g.DrawJobs.Size, RunDrawJob, g.DrawJobs.Data, g.IO.DrawJobsRunnerUserData);
+    else
+        for (int n = 0; n < g.DrawJobs.Size; n++)
+            RunDrawJob(n, g.DrawJobs.Data);
+    g.DrawJobsRunning = false;
+    for (int n = 0; n < fonts.Size; n++)
+        if (fonts[n]->LayoutCache)
+            fonts[n]->LayoutCache->Frozen = false;
+    g.DrawJobs.resize(0);
+}
+
 void ImGui::Render()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILE_SCOPE(ImGuiProfilePhase_Render);
     IM_ASSERT(g.Initialized);   // Forgot to call ImGui::NewFrame()
 
     if (g.FrameCountEnded != g.FrameCount)
         ImGui::EndFrame();
     g.FrameCountRendered = g.FrameCount;
+    RunDrawJobs();
 
     // Gather windows to render
     g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = g.IO.MetricsActiveWindows = 0;
@@ -6456,6 +7004,7 @@ static inline void ClampWindowRect(ImGuiWindow* window, const ImRect& rect, cons
 bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILE_SCOPE(ImGuiProfilePhase_Begin);
     const ImGuiStyle& style = g.Style;
     IM_ASSERT(name != NULL);                        // Window name required
     IM_ASSERT(g.Initialized);                       // Forgot to call ImGui::NewFrame()
@@ -6837,6 +7386,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 
         // Setup draw list and outer clipping rectangle
         window->DrawList->Clear();
+        window->DrawJobLists.resize(0);
         window->DrawList->Flags = (g.Style.AntiAliasedLines ? ImDrawListFlags_AntiAliasedLines : 0) | (g.Style.AntiAliasedFill ? ImDrawListFlags_AntiAliasedFill : 0);
         window->DrawList->PushTextureID(g.Font->ContainerAtlas->TexID);
         if ((flags & ImGuiWindowFlags_ChildWindow) && !(flags & ImGuiWindowFlags_Popup) && !window_is_child_tooltip)
@@ -7161,6 +7711,7 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_first_use,
 void ImGui::End()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILE_SCOPE(ImGuiProfilePhase_End);
     ImGuiWindow* window = g.CurrentWindow;
 
     if (window->DC.ColumnsSet != NULL)
@@ -8044,6 +8595,26 @@ ImDrawList* ImGui::GetWindowDrawList()
     return window->DrawList;
 }
 
+void ImGui::AddDrawJob(ImGuiDrawJobFn fn, const void* user_data, size_t user_data_size)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = GetCurrentWindow();
+    IM_ASSERT(fn != NULL);
+    if (g.DrawJobs.Size == g.DrawJobListsPool.Size)
+        g.DrawJobListsPool.push_back(IM_NEW(ImDrawList)(&g.DrawListSharedData));
+
+    ImGuiDrawJob job;
+    job.Fn = fn;
+    job.UserData = (user_data_size > 0) ? memcpy(MemAllocFrame(user_data_size), user_data, user_data_size) : (void*)user_data;
+    job.DrawList = g.DrawJobListsPool[g.DrawJobs.Size];
+    job.DrawList->_OwnerName = window->Name;
+    job.ClipRect = window->DrawList->_ClipRectStack.back();
+    job.TextureId = window->DrawList->_TextureIdStack.back();
+    job.Flags = window->DrawList->Flags;
+    g.DrawJobs.push_back(job);
+    window->DrawJobLists.push_back(job.DrawList);
+}
+
 ImFont* ImGui::GetFont()
 {
     return GImGui->Font;
@@ -10548,18 +11119,76 @@ bool ImGui::RadioButton(const char* label, int* v, int v_button)
     return pressed;
 }
 
-static int InputTextCalcTextLenAndLineCount(const char* text_begin, const char** out_text_end)
+// Rebuild the line index of the active text from 'first_line' onward, over Text and over the UTF-8 buffer displayed for it
+static void InputTextUpdateLineStarts(ImGuiTextEditState* state, const char* buf_display, int first_line = 0)
 {
-    int line_count = 0;
-    const char* s = text_begin;
-    while (char c = *s++) // We are only matching for \n so we can ignore UTF-8 decoding
-        if (c == '\n')
-            line_count++;
-    s--;
-    if (s[0] != '\n' && s[0] != '\r')
-        line_count++;
-    *out_text_end = s;
-    return line_count;
+    state->LineStartsW.resize(first_line + 1);
+    state->LineStartsA.resize(first_line + 1);
+    if (first_line == 0)
+        state->LineStartsW[0] = state->LineStartsA[0] = 0;
+
+    // Skip 4 characters at a time while none of them is a new line (2-byte ImWchar only)
+    const ImWchar* text = state->Text.Data;
+    for (int n = state->LineStartsW[first_line]; n < state->CurLenW; )
+    {
+        if (sizeof(ImWchar) == 2 && state->CurLenW - n >= 4)
+        {
+            ImU64 v;
+            memcpy(&v, text + n, 8);
+            v ^= 0x000A000A000A000AULL;
+            if (((v - 0x0001000100010001ULL) & ~v & 0x8000800080008000ULL) == 0)
+            {
+                n += 4;
+                continue;
+            }
+        }
+        if (text[n++] == '\n')
+            state->LineStartsW.push_back(n);
+    }
+
+    const char* buf_end = buf_display + state->CurLenA;
+    for (const char* s = buf_display + state->LineStartsA[first_line]; (s = (const char*)memchr(s, '\n', (size_t)(buf_end - s))) != NULL; )
+        state->LineStartsA.push_back((int)(++s - buf_display));
+    state->LineStartsDirty = false;
+}
+
+// Offset of the first byte where 'a' and 'b' differ, -1 when they are equal up to the zero terminator of 'a'. Reads up to 'size' bytes of both.
+static int InputTextFindFirstDifference(const char* a, const char* b, int size)
+{
+    int n = 0;
+    while (size - n >= 256 && memcmp(a + n, b + n, 256) == 0 && memchr(a + n, 0, 256) == NULL)
+        n += 256;
+    for (; n < size; n++)
+    {
+        if (a[n] != b[n])
+            return n;
+        if (a[n] == 0)
+            break;
+    }
+    return -1;
+}
+
+// Number of lines starting at or before 'pos', which is the 1-based line number of 'pos'
+static int InputTextFindLine(const ImVector<int>& line_starts, int pos)
+{
+    int lo = 0, hi = line_starts.Size;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) / 2;
+        if (line_starts[mid] <= pos)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Lines overlapping clip_rect when the first line is at pos_y, with one extra line on each side (RenderText() does the exact clipping)
+static void InputTextCalcVisibleLines(float pos_y, const ImVec4& clip_rect, int* out_line_first, int* out_line_last)
+{
+    const float line_height = GImGui->FontSize;
+    *out_line_first = ImMax((int)((clip_rect.y - pos_y) / line_height) - 1, 0);
+    *out_line_last = ImMax((int)((clip_rect.w - pos_y) / line_height) + 1, *out_line_first);
 }
 
 static ImVec2 InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining, ImVec2* out_offset, bool stop_on_new_line)
@@ -10649,6 +11278,7 @@ static void STB_TEXTEDIT_DELETECHARS(STB_TEXTEDIT_STRING* obj, int pos, int n)
     // We maintain our buffer length in both UTF-8 and wchar formats
     obj->CurLenA -= ImTextCountUtf8BytesFromStr(dst, dst + n);
     obj->CurLenW -= n;
+    obj->OnTextChanged();
 
     // Offset remaining text
     const ImWchar* src = obj->Text.Data + pos + n;
@@ -10676,6 +11306,7 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
     obj->CurLenW += new_text_len;
     obj->CurLenA += new_text_len_utf8;
     obj->Text[obj->CurLenW] = '\0';
+    obj->OnTextChanged();
 
     return true;
 }
@@ -10899,10 +11530,24 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             const int prev_len_w = edit_state.CurLenW;
             edit_state.Text.resize(buf_size+1);        // wchar count <= UTF-8 count. we use +1 to make sure that .Data isn't NULL so it doesn't crash.
             edit_state.InitialText.resize(buf_size+1); // UTF-8. we use +1 to make sure that .Data isn't NULL so it doesn't crash.
-            ImStrncpy(edit_state.InitialText.Data, buf, edit_state.InitialText.Size);
-            const char* buf_end = NULL;
-            edit_state.CurLenW = ImTextStrFromUtf8(edit_state.Text.Data, edit_state.Text.Size, buf, NULL, &buf_end);
+            const char* buf_end = (const char*)memchr(buf, 0, (size_t)buf_size);
+            if (buf_end == NULL)
+                buf_end = buf + buf_size;
+            memcpy(edit_state.InitialText.Data, buf, (size_t)(buf_end - buf));
+            edit_state.InitialText[(int)(buf_end - buf)] = 0;
+            bool lossless = false;
+            edit_state.CurLenW = ImTextStrFromUtf8(edit_state.Text.Data, edit_state.Text.Size, buf, buf_end, &buf_end, &lossless);
             edit_state.CurLenA = (int)(buf_end - buf); // We can't get the result from ImFormatString() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+            edit_state.OnTextChanged();
+            if (is_editable && lossless)
+            {
+                // Converting Text back would give buf again, copy it instead
+                edit_state.TempTextBuffer.resize(edit_state.Text.Size * 4);
+                memcpy(edit_state.TempTextBuffer.Data, buf, (size_t)edit_state.CurLenA);
+                edit_state.TempTextBuffer[edit_state.CurLenA] = 0;
+                edit_state.TempTextBufferDirty = false;
+            }
+            edit_state.TextFromInitialText = !is_editable || lossless;
             edit_state.CursorAnimReset();
 
             // Preserve cursor position and undo/redo stack if we come back to same widget
@@ -10944,13 +11589,30 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
 
     if (g.ActiveId == id)
     {
-        if (!is_editable && !g.ActiveIdIsJustActivated)
-        {
-            // When read-only we always use the live data passed to the function
+        const int changed_at = (is_editable || g.ActiveIdIsJustActivated) ? -1 : (edit_state.InitialText.Size < buf_size+1) ? 0 : InputTextFindFirstDifference(edit_state.InitialText.Data, buf, buf_size);
+        if (changed_at >= 0)
+        {
+            // When read-only we always use the live data passed to the function. InitialText (unused when read-only) tracks it so unchanged data isn't converted again.
+            // While Text was converted from it, only the lines from the one holding the first changed byte are converted and indexed again (e.g. a log being appended to).
+            // Decoding a character reads up to 3 bytes ahead, so conversion starts from the line holding the byte 3 bytes before the change.
+            int first_line = 0;
+            if (edit_state.TextFromInitialText && !edit_state.LineStartsDirty && edit_state.LineStartsW.Size == edit_state.LineStartsA.Size)
+                first_line = InputTextFindLine(edit_state.LineStartsA, ImMax(changed_at - 3, 0)) - 1;
+            const int first_a = first_line > 0 ? edit_state.LineStartsA[first_line] : 0;
+            const int first_w = first_line > 0 ? edit_state.LineStartsW[first_line] : 0;
             edit_state.Text.resize(buf_size+1);
-            const char* buf_end = NULL;
-            edit_state.CurLenW = ImTextStrFromUtf8(edit_state.Text.Data, edit_state.Text.Size, buf, NULL, &buf_end);
+            edit_state.InitialText.resize(buf_size+1);
+            const char* buf_end = (const char*)memchr(buf + changed_at, 0, (size_t)(buf_size - changed_at));
+            if (buf_end == NULL)
+                buf_end = buf + buf_size;
+            memcpy(edit_state.InitialText.Data + changed_at, buf + changed_at, (size_t)(buf_end - buf - changed_at));
+            edit_state.InitialText[(int)(buf_end - buf)] = 0;
+            edit_state.CurLenW = first_w + ImTextStrFromUtf8(edit_state.Text.Data + first_w, edit_state.Text.Size - first_w, buf + first_a, buf_end, &buf_end);
             edit_state.CurLenA = (int)(buf_end - buf);
+            edit_state.OnTextChanged();
+            if (first_line > 0)
+                InputTextUpdateLineStarts(&edit_state, buf, first_line);
+            edit_state.TextFromInitialText = true;
             edit_state.CursorClamp();
         }
 
@@ -11092,6 +11754,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
                 edit_state.TempTextBuffer.resize((ie-ib) * 4 + 1);
                 ImTextStrToUtf8(edit_state.TempTextBuffer.Data, edit_state.TempTextBuffer.Size, edit_state.Text.Data+ib, edit_state.Text.Data+ie);
                 SetClipboardText(edit_state.TempTextBuffer.Data);
+                edit_state.TempTextBufferDirty = true;
             }
             if (is_cut)
             {
@@ -11107,7 +11770,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)strlen(clipboard);
-                ImWchar* clipboard_filtered = (ImWchar*)ImGui::MemAlloc((clipboard_len+1) * sizeof(ImWchar));
+                ImWchar* clipboard_filtered = (ImWchar*)ImGui::MemAllocFrame((clipboard_len+1) * sizeof(ImWchar));
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard; *s; )
                 {
@@ -11125,7 +11788,6 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
                     stb_textedit_paste(&edit_state, &edit_state.StbState, clipboard_filtered, clipboard_filtered_len);
                     edit_state.CursorFollow = true;
                 }
-                ImGui::MemFree(clipboard_filtered);
             }
         }
     }
@@ -11150,11 +11812,12 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             // Apply new value immediately - copy modified buffer back
             // Note that as soon as the input box is active, the in-widget value gets priority over any underlying modification of the input buffer
             // FIXME: We actually always render 'buf' when calling DrawList->AddText, making the comment above incorrect.
-            // FIXME-OPT: CPU waste to do this every time the widget is active, should mark dirty state from the stb_textedit callbacks.
-            if (is_editable)
+            // TempTextBuffer is only converted again after the text changed (see OnTextChanged(), called by the stb_textedit callbacks).
+            if (is_editable && edit_state.TempTextBufferDirty)
             {
                 edit_state.TempTextBuffer.resize(edit_state.Text.Size * 4);
-                ImTextStrToUtf8(edit_state.TempTextBuffer.Data, edit_state.TempTextBuffer.Size, edit_state.Text.Data, NULL);
+                ImTextStrToUtf8(edit_state.TempTextBuffer.Data, edit_state.TempTextBuffer.Size, edit_state.Text.Data, edit_state.Text.Data + edit_state.CurLenW);
+                edit_state.TempTextBufferDirty = false;
             }
 
             // User callback
@@ -11219,6 +11882,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
                         IM_ASSERT(callback_data.BufTextLen == (int)strlen(callback_data.Buf)); // You need to maintain BufTextLen if you change the text!
                         edit_state.CurLenW = ImTextStrFromUtf8(edit_state.Text.Data, edit_state.Text.Size, callback_data.Buf, NULL);
                         edit_state.CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        edit_state.OnTextChanged();
                         edit_state.CursorAnimReset();
                     }
                 }
@@ -11261,48 +11925,29 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
         // FIXME: This should occur on buf_display but we'd need to maintain cursor/select_start/select_end for UTF-8.
         const ImWchar* text_begin = edit_state.Text.Data;
         ImVec2 cursor_offset, select_start_offset;
+        int select_start_line = 0;
 
         {
-            // Count lines + find lines numbers straddling 'cursor' and 'select_start' position.
-            const ImWchar* searches_input_ptr[2];
-            searches_input_ptr[0] = text_begin + edit_state.StbState.cursor;
-            searches_input_ptr[1] = NULL;
-            int searches_remaining = 1;
-            int searches_result_line_number[2] = { -1, -999 };
-            if (edit_state.StbState.select_start != edit_state.StbState.select_end)
-            {
-                searches_input_ptr[1] = text_begin + ImMin(edit_state.StbState.select_start, edit_state.StbState.select_end);
-                searches_result_line_number[1] = -1;
-                searches_remaining++;
-            }
+            // Find the lines of 'cursor' and 'select_start' in the line index, which is only rebuilt after the text changed.
+            if (edit_state.LineStartsDirty)
+                InputTextUpdateLineStarts(&edit_state, buf_display);
+            const ImVector<int>& line_starts = edit_state.LineStartsW;
+            const int cursor_line = InputTextFindLine(line_starts, edit_state.StbState.cursor);
 
-            // Iterate all lines to find our line numbers
-            // In multi-line mode, we never exit the loop until all lines are counted, so add one extra to the searches_remaining counter.
-            searches_remaining += is_multiline ? 1 : 0;
-            int line_count = 0;
-            for (const ImWchar* s = text_begin; *s != 0; s++)
-                if (*s == '\n')
-                {
-                    line_count++;
-                    if (searches_result_line_number[0] == -1 && s >= searches_input_ptr[0]) { searches_result_line_number[0] = line_count; if (--searches_remaining <= 0) break; }
-                    if (searches_result_line_number[1] == -1 && s >= searches_input_ptr[1]) { searches_result_line_number[1] = line_count; if (--searches_remaining <= 0) break; }
-                }
-            line_count++;
-            if (searches_result_line_number[0] == -1) searches_result_line_number[0] = line_count;
-            if (searches_result_line_number[1] == -1) searches_result_line_number[1] = line_count;
-
-            // Calculate 2d position by finding the beginning of the line and measuring distance
-            cursor_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[0], text_begin), searches_input_ptr[0]).x;
-            cursor_offset.y = searches_result_line_number[0] * g.FontSize;
-            if (searches_result_line_number[1] >= 0)
+            // Calculate 2d position by measuring the distance from the beginning of the line
+            cursor_offset.x = InputTextCalcTextSizeW(text_begin + line_starts[cursor_line - 1], text_begin + edit_state.StbState.cursor).x;
+            cursor_offset.y = cursor_line * g.FontSize;
+            if (edit_state.StbState.select_start != edit_state.StbState.select_end)
             {
-                select_start_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[1], text_begin), searches_input_ptr[1]).x;
-                select_start_offset.y = searches_result_line_number[1] * g.FontSize;
+                const int select_start = ImMin(edit_state.StbState.select_start, edit_state.StbState.select_end);
+                select_start_line = InputTextFindLine(line_starts, select_start);
+                select_start_offset.x = InputTextCalcTextSizeW(text_begin + line_starts[select_start_line - 1], text_begin + select_start).x;
+                select_start_offset.y = select_start_line * g.FontSize;
             }
 
             // Store text height (note that we haven't calculated text width at all, see GitHub issues #383, #1224)
             if (is_multiline)
-                text_size = ImVec2(size.x, line_count * g.FontSize);
+                text_size = ImVec2(size.x, line_starts.Size * g.FontSize);
         }
 
         // Scroll
@@ -11348,15 +11993,15 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
             ImU32 bg_color = GetColorU32(ImGuiCol_TextSelectedBg);
             ImVec2 rect_pos = render_pos + select_start_offset - render_scroll;
-            for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
+            int line = select_start_line; // Index of the line after the one being drawn
+            for (const ImWchar* p = text_selected_begin; p < text_selected_end; line++)
             {
                 if (rect_pos.y > clip_rect.w + g.FontSize)
                     break;
                 if (rect_pos.y < clip_rect.y)
                 {
-                    while (p < text_selected_end)
-                        if (*p++ == '\n')
-                            break;
+                    // Skip to the next line through the index
+                    p = (line < edit_state.LineStartsW.Size && text_begin + edit_state.LineStartsW[line] < text_selected_end) ? text_begin + edit_state.LineStartsW[line] : text_selected_end;
                 }
                 else
                 {
@@ -11372,7 +12017,23 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             }
         }
 
-        draw_window->DrawList->AddText(g.Font, g.FontSize, render_pos - render_scroll, GetColorU32(ImGuiCol_Text), buf_display, buf_display + edit_state.CurLenA, 0.0f, is_multiline ? NULL : &clip_rect);
+        const char* buf_display_begin = buf_display;
+        const char* buf_display_end = buf_display + edit_state.CurLenA;
+        ImVec2 text_pos = render_pos - render_scroll;
+        if (is_multiline && edit_state.LineStartsA.Size == edit_state.LineStartsW.Size)
+        {
+            // Only submit the visible lines, RenderText() would otherwise walk every line above them and reserve vertices for every character below them.
+            // The position is rounded by RenderText() once the offset of the first line is added, as drawing the whole text rounds the position of its first line.
+            const ImVector<int>& line_starts = edit_state.LineStartsA;
+            int line_first, line_last;
+            InputTextCalcVisibleLines(text_pos.y, draw_window->DrawList->_ClipRectStack.back(), &line_first, &line_last);
+            line_first = ImMin(line_first, line_starts.Size - 1);
+            buf_display_begin = buf_display + line_starts[line_first];
+            if (line_last + 1 < line_starts.Size)
+                buf_display_end = buf_display + line_starts[line_last + 1];
+            text_pos.y += line_first * g.FontSize;
+        }
+        draw_window->DrawList->AddText(g.Font, g.FontSize, text_pos, GetColorU32(ImGuiCol_Text), buf_display_begin, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
 
         // Draw blinking cursor
         bool cursor_is_visible = (!g.IO.OptCursorBlink) || (g.InputTextState.CursorAnim <= 0.0f) || fmodf(g.InputTextState.CursorAnim, 1.20f) <= 0.80f;
@@ -11391,10 +12052,31 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
     else
     {
         // Render text only
-        const char* buf_end = NULL;
         if (is_multiline)
-            text_size = ImVec2(size.x, InputTextCalcTextLenAndLineCount(buf_display, &buf_end) * g.FontSize); // We don't need width
-        draw_window->DrawList->AddText(g.Font, g.FontSize, render_pos, GetColorU32(ImGuiCol_Text), buf_display, buf_end, 0.0f, is_multiline ? NULL : &clip_rect);
+        {
+            // One pass over the text counts the lines (we don't need width) and finds the visible ones, the others are skipped with memchr()
+            int line_first, line_last;
+            InputTextCalcVisibleLines(render_pos.y, draw_window->DrawList->_ClipRectStack.back(), &line_first, &line_last);
+            const char* buf_end = buf_display + strlen(buf_display);
+            const char* visible_begin = (line_first == 0) ? buf_display : NULL;
+            const char* visible_end = buf_end;
+            int line_count = 1;
+            for (const char* s = buf_display; (s = (const char*)memchr(s, '\n', (size_t)(buf_end - s))) != NULL; line_count++)
+            {
+                s++;
+                if (line_count == line_first)
+                    visible_begin = s;
+                else if (line_count == line_last + 1)
+                    visible_end = s;
+            }
+            text_size = ImVec2(size.x, line_count * g.FontSize);
+            if (visible_begin)
+                draw_window->DrawList->AddText(g.Font, g.FontSize, ImVec2(render_pos.x, render_pos.y + line_first * g.FontSize), GetColorU32(ImGuiCol_Text), visible_begin, visible_end, 0.0f, NULL);
+        }
+        else
+        {
+            draw_window->DrawList->AddText(g.Font, g.FontSize, render_pos, GetColorU32(ImGuiCol_Text), buf_display, NULL, 0.0f, &clip_rect);
+        }
     }
 
     if (is_multiline)
@@ -13881,7 +14563,9 @@ bool ImGui::SetDragDropPayload(const char* type, const void* data, size_t data_s
     IM_ASSERT(cond == ImGuiCond_Always || cond == ImGuiCond_Once);
     IM_ASSERT(payload.SourceId != 0);                               // Not called between BeginDragDropSource() and EndDragDropSource()
 
-    if (cond == ImGuiCond_Always || payload.DataFrameCount == -1)
+    // Sources resubmit the same data every frame of the drag, keep the buffer and DataVersion when nothing changed
+    const bool unchanged = payload.DataFrameCount != -1 && payload.DataSize == (int)data_size && strcmp(payload.DataType, type) == 0 && (data_size == 0 || memcmp(payload.Data, data, data_size) == 0);
+    if (!unchanged && (cond == ImGuiCond_Always || payload.DataFrameCount == -1))
     {
         // Copy payload
         ImStrncpy(payload.DataType, type, IM_ARRAYSIZE(payload.DataType));
@@ -13905,6 +14589,7 @@ bool ImGui::SetDragDropPayload(const char* type, const void* data, size_t data_s
             payload.Data = NULL;
         }
         payload.DataSize = (int)data_size;
+        payload.DataVersion++;
     }
     payload.DataFrameCount = g.FrameCount;
 
@@ -14162,7 +14847,8 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         ImGui::Text("Dear ImGui %s", ImGui::GetVersion());
         ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
         ImGui::Text("%d vertices, %d indices (%d triangles)", ImGui::GetIO().MetricsRenderVertices, ImGui::GetIO().MetricsRenderIndices, ImGui::GetIO().MetricsRenderIndices / 3);
-        ImGui::Text("%d allocations", (int)GImAllocatorActiveAllocationsCount);
+        ImGui::Text("%d allocations", (int)ImAtomicLoad(&GImAllocatorActiveAllocationsCount));
+        ImGui::Text("%d heap allocations last frame, %d bytes from the frame arena", ImGui::GetIO().MetricsAllocations, ImGui::GetIO().MetricsFrameArenaBytes);
         static bool show_clip_rects = true;
         static bool show_window_begin_order = false;
         ImGui::Checkbox("Show clipping rectangles when hovering draw commands", &show_clip_rects);
@@ -14255,6 +14941,8 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                     return;
                 ImGuiWindowFlags flags = window->Flags;
                 NodeDrawList(window, window->Viewport, window->DrawList, "DrawList");
+                for (int i = 0; i < window->DrawJobLists.Size; i++)
+                    NodeDrawList(window, window->Viewport, window->DrawJobLists[i], "DrawJobList");
                 ImGui::BulletText("Pos: (%.1f,%.1f), Size: (%.1f,%.1f), SizeContents (%.1f,%.1f)", window->Pos.x, window->Pos.y, window->Size.x, window->Size.y, window->SizeContents.x, window->SizeContents.y);
                 ImGui::BulletText("Flags: 0x%08X (%s%s%s%s%s%s..)", flags, 
                     (flags & ImGuiWindowFlags_ChildWindow) ? "Child " : "", (flags & ImGuiWindowFlags_Tooltip)   ? "Tooltip "   : "", (flags & ImGuiWindowFlags_Popup) ? "Popup " : "",
@@ -14337,6 +15025,52 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                 Funcs::NodeViewport(g.Viewports[i]);
             ImGui::TreePop();
         }
+        if (g.DockMetricsFn && ImGui::TreeNode("Docking"))
+        {
+            g.DockMetricsFn();
+            ImGui::TreePop();
+        }
+        if (ImGui::TreeNode("Profiler"))
+        {
+#ifndef IMGUI_ENABLE_PROFILER
+            ImGui::TextDisabled("Define IMGUI_ENABLE_PROFILER in imconfig.h to collect timings.");
+#endif
+            ImGui::Columns(4, "##profiler", false);
+            ImGui::Text("Phase"); ImGui::NextColumn();
+            ImGui::Text("ms"); ImGui::NextColumn();
+            ImGui::Text("Calls"); ImGui::NextColumn();
+            ImGui::Text("Allocs"); ImGui::NextColumn();
+            ImGui::Separator();
+            for (int n = 0; n < ImGui::GetProfilerPhaseCount(); n++)
+            {
+                ImGuiProfilerPhase phase;
+                ImGui::GetProfilerPhase(n, &phase);
+                ImGui::TextUnformatted(phase.Name); ImGui::NextColumn();
+                ImGui::Text("%.3f", phase.TimeMs); ImGui::NextColumn();
+                ImGui::Text("%d", phase.Calls); ImGui::NextColumn();
+                ImGui::Text("%d", phase.Allocations); ImGui::NextColumn();
+            }
+            ImGui::Columns(1);
+            ImGui::TreePop();
+        }
+        if (ImGui::TreeNode("Text layout cache"))
+        {
+            for (int i = 0; i < g.IO.Fonts->Fonts.Size; i++)
+            {
+                ImFont* font = g.IO.Fonts->Fonts[i];
+                if (const ImFontLayoutCache* cache = font->LayoutCache)
+                {
+                    const int lookups = cache->Hits + cache->Misses;
+                    ImGui::BulletText("Font '%s' %.0fpx: %d/%d strings, %d wrap breaks, %d hits, %d misses (%.1f%%), %d evictions", font->GetDebugName(), font->FontSize,
+                        cache->GetUsedCount(), cache->Entries.Size, cache->WrapBreaks.Size, cache->Hits, cache->Misses, lookups > 0 ? 100.0f * cache->Hits / lookups : 0.0f, cache->Evictions);
+                }
+                else
+                {
+                    ImGui::BulletText("Font '%s' %.0fpx: no cache", font->GetDebugName(), font->FontSize);
+                }
+            }
+            ImGui::TreePop();
+        }
         if (ImGui::TreeNode("Popups", "Open Popups Stack (%d)", g.OpenPopupStack.Size))
         {
             for (int i = 0; i < g.OpenPopupStack.Size; i++)
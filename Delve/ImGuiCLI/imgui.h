@@ -60,6 +60,7 @@ struct ImDrawListSharedData;        // Data shared among multiple draw lists (ty
 struct ImDrawVert;                  // A single vertex (20 bytes by default, override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
+struct ImFontLayoutCache;           // Measured text sizes and word-wrap positions of a font (imgui_internal.h)
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
@@ -68,6 +69,7 @@ struct ImGuiStorage;                // Simple custom key value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTextFilter;             // Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 struct ImGuiTextBuffer;             // Text buffer for logging/accumulating text
+struct ImGuiProfilerPhase;          // Timing and allocation count of one profiler phase over the last frame
 struct ImGuiTextEditCallbackData;   // Shared state of ImGui::InputText() when using custom ImGuiTextEditCallback (rare/advanced use)
 struct ImGuiSizeCallbackData;       // Structure used to constraint window size in custom ways when using custom ImGuiSizeCallback (rare/advanced use)
 struct ImGuiListClipper;            // Helper to manually clip large list of items
@@ -109,6 +111,7 @@ typedef int ImGuiViewportFlags;     // flags: for ImGuiViewport
 typedef int ImGuiWindowFlags;       // flags: for Begin*()                      // enum ImGuiWindowFlags_
 typedef int (*ImGuiTextEditCallback)(ImGuiTextEditCallbackData *data);
 typedef void (*ImGuiSizeCallback)(ImGuiSizeCallbackData* data);
+typedef void (*ImGuiDrawJobFn)(ImDrawList* draw_list, void* user_data);  // See AddDrawJob(). May run on any thread: only use the draw list (and fonts) passed in, never ImGui:: functions.
 #if defined(_MSC_VER) && !defined(__clang__)
 typedef unsigned __int64 ImU64;     // 64-bit unsigned integer
 #else
@@ -165,6 +168,13 @@ namespace ImGui
     IMGUI_API void          ShowUserGuide();                            // add basic help/info block (not a window): how to manipulate ImGui as a end-user (mouse/keyboard controls).
     IMGUI_API const char*   GetVersion();                               // get a version string e.g. "1.23"
 
+    // Profiler
+    // Scoped timers are only compiled in when IMGUI_ENABLE_PROFILER is defined in imconfig.h, otherwise phases report zeroes.
+    // A frame goes from one NewFrame() to the next, so UpdatePlatformWindows()/RenderPlatformWindowsDefault() are included.
+    IMGUI_API int           GetProfilerPhaseCount();
+    IMGUI_API bool          GetProfilerPhase(int phase, ImGuiProfilerPhase* out_phase);  // last complete frame. Times are inclusive, nested phases (e.g. TextLayout inside Begin) are counted in both.
+    IMGUI_API void          ProfilerAppendFrameJson(ImGuiTextBuffer* buf);              // append the last complete frame as a JSON object, call once per frame to build a trace
+
     // Styles
     IMGUI_API void          StyleColorsDark(ImGuiStyle* dst = NULL);    // new, recommended style (default)
     IMGUI_API void          StyleColorsClassic(ImGuiStyle* dst = NULL); // classic imgui style
@@ -188,6 +198,7 @@ namespace ImGui
     IMGUI_API bool          IsWindowFocused(ImGuiFocusedFlags flags=0); // is current window focused? or its root/child, depending on flags. see flags for options.
     IMGUI_API bool          IsWindowHovered(ImGuiHoveredFlags flags=0); // is current window hovered (and typically: not blocked by a popup/modal)? see flags for options. NB: If you are trying to check whether your mouse should be dispatched to imgui or to your app, you should use the 'io.WantCaptureMouse' boolean for that! Please read the FAQ!
     IMGUI_API ImDrawList*   GetWindowDrawList();                        // get draw list associated to the window, to append your own drawing primitives
+    IMGUI_API void          AddDrawJob(ImGuiDrawJobFn fn, const void* user_data = NULL, size_t user_data_size = 0); // defer heavy custom drawing: 'fn' fills a private draw list during Render(), possibly on a worker thread (see io.DrawJobsRunner). it is layered above the window contents and below its child windows, clipped like the window draw list is now. user_data is copied when user_data_size > 0.
     IMGUI_API ImVec2        GetWindowPos();                             // get current window position in screen space (useful if you want to do your own drawing via the DrawList API)
     IMGUI_API ImVec2        GetWindowSize();                            // get current window size
     IMGUI_API float         GetWindowWidth();                           // get current window width (shortcut for GetWindowSize().x)
@@ -470,7 +481,7 @@ namespace ImGui
     // Drag and Drop
     // [BETA API] Missing Demo code. API may evolve.
     IMGUI_API bool          BeginDragDropSource(ImGuiDragDropFlags flags = 0);                                      // call when the current item is active. If this return true, you can call SetDragDropPayload() + EndDragDropSource()
-    IMGUI_API bool          SetDragDropPayload(const char* type, const void* data, size_t size, ImGuiCond cond = 0);// type is a user defined string of maximum 32 characters. Strings starting with '_' are reserved for dear imgui internal types. Data is copied and held by imgui.
+    IMGUI_API bool          SetDragDropPayload(const char* type, const void* data, size_t size, ImGuiCond cond = 0);// type is a user defined string of maximum 32 characters. Strings starting with '_' are reserved for dear imgui internal types. Data is copied and held by imgui (only when it differs from the current payload).
     IMGUI_API void          EndDragDropSource();                                                                    // only call EndDragDropSource() if BeginDragDropSource() returns true!
     IMGUI_API bool          BeginDragDropTarget();                                                                  // call after submitting an item that may receive an item. If this returns true, you can call AcceptDragDropPayload() + EndDragDropTarget()
     IMGUI_API const ImGuiPayload* AcceptDragDropPayload(const char* type, ImGuiDragDropFlags flags = 0);            // accept contents of a given type. If ImGuiDragDropFlags_AcceptBeforeDelivery is set you can peek into the payload before the mouse button is released.
@@ -559,6 +570,9 @@ namespace ImGui
     IMGUI_API void          SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void(*free_func)(void* ptr, void* user_data), void* user_data = NULL);
     IMGUI_API void*         MemAlloc(size_t size);
     IMGUI_API void          MemFree(void* ptr);
+    // Transient memory for the current context, valid until the next NewFrame(). Never free it. Unlike the functions above this needs a current context.
+    IMGUI_API void*         MemAllocFrame(size_t size);
+    IMGUI_API void          SetFrameAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*reset_func)(void* user_data), void* user_data = NULL);  // replace the built-in frame arena of the current context, pass NULL to restore it. reset_func is called from NewFrame().
 
 } // namespace ImGui
 
@@ -1058,6 +1072,18 @@ struct ImGuiIO
     void        (*SetClipboardTextFn)(void* user_data, const char* text);
     void*       ClipboardUserData;
 
+    // Optional: run the draw jobs queued by AddDrawJob() on worker threads
+    // Call run_job(job_index, jobs) for every index in [0, job_count), in any order and from any threads, and return once they all completed.
+    // (default to NULL: Render() runs the jobs one after the other on the calling thread)
+    void        (*DrawJobsRunner)(int job_count, void (*run_job)(int job_index, void* jobs), void* jobs, void* user_data);
+    void*       DrawJobsRunnerUserData;
+
+    // Optional: write the .ini file from another thread so saving never blocks a frame
+    // ini_data is only valid during the call, copy it. The final save made by DestroyContext() always writes the file directly.
+    // (default to NULL: the file is written by NewFrame() when io.IniSavingRate expires)
+    void        (*IniSaveFn)(const char* filename, const char* ini_data, size_t ini_size, void* user_data);
+    void*       IniSaveFnUserData;
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     // [OBSOLETE] Rendering function, will be automatically called in Render(). Please call your rendering function yourself now! You can obtain the ImDrawData* by calling ImGui::GetDrawData() after Render().
     // See example applications if you are unsure of how to implement this.
@@ -1102,6 +1128,9 @@ struct ImGuiIO
     int         MetricsRenderVertices;      // Vertices output during last call to Render()
     int         MetricsRenderIndices;       // Indices output during last call to Render() = number of triangles * 3
     int         MetricsActiveWindows;       // Number of visible root windows (exclude child windows)
+    int         MetricsAllocations;         // Heap allocations (MemAlloc calls) made between the last two calls to NewFrame(). Should stay at 0 in steady state. Counted across all contexts.
+    int         MetricsActiveAllocations;   // Live heap allocations made through MemAlloc()
+    int         MetricsFrameArenaBytes;     // Bytes requested from MemAllocFrame() during the last frame, including those of a SetFrameAllocatorFunctions() allocator
     ImVec2      MouseDelta;                 // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
 
     //------------------------------------------------------------------
@@ -1273,6 +1302,7 @@ struct ImGuiTextFilter
     IMGUI_API           ImGuiTextFilter(const char* default_filter = "");
     IMGUI_API bool      Draw(const char* label = "Filter (inc,-exc)", float width = 0.0f);    // Helper calling InputText+Build
     IMGUI_API bool      PassFilter(const char* text, const char* text_end = NULL) const;
+    IMGUI_API int       PassFilterMany(const char* buf, const int* offsets, int count, ImVector<int>* out_indices, void (*jobs_runner)(int job_count, void (*run_job)(int job_index, void* jobs), void* jobs, void* user_data) = NULL, void* jobs_runner_user_data = NULL) const; // Filter 'count' strings packed in 'buf', string n being [buf+offsets[n], buf+offsets[n+1]). Appends the indices of those passing PassFilter() to out_indices and returns how many. jobs_runner (same contract as io.DrawJobsRunner) may split the work across threads.
     IMGUI_API void      Build();
     void                Clear() { InputBuf[0] = 0; Build(); }
     bool                IsActive() const { return !Filters.empty(); }
@@ -1292,10 +1322,20 @@ struct ImGuiTextBuffer
     void                clear() { Buf.clear(); Buf.push_back(0); }
     void                reserve(int capacity) { Buf.reserve(capacity); }
     const char*         c_str() const { return Buf.Data; }
+    IMGUI_API void      append(const char* str, const char* str_end = NULL);
     IMGUI_API void      appendf(const char* fmt, ...) IM_FMTARGS(2);
     IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
 };
 
+// Helper: Profiler output for one phase, see GetProfilerPhase()
+struct ImGuiProfilerPhase
+{
+    const char*         Name;
+    float               TimeMs;         // Inclusive time spent in the phase during the last frame
+    int                 Calls;
+    int                 Allocations;    // MemAlloc calls made while inside the phase
+};
+
 // Helper: Simple Key->value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
@@ -1389,6 +1429,7 @@ struct ImGuiPayload
     // Members
     const void*     Data;               // Data (copied and owned by dear imgui)
     int             DataSize;           // Data size
+    unsigned int    DataVersion;        // Incremented when the data is copied in. Resubmitting identical data each frame keeps it, so targets can cache what they decode.
 
     // [Internal]
     ImGuiID         SourceId;           // Source item id
@@ -1398,7 +1439,7 @@ struct ImGuiPayload
     bool            Preview;            // Set when AcceptDragDropPayload() was called and mouse has been hovering the target item (nb: handle overlapping drag targets)
     bool            Delivery;           // Set when AcceptDragDropPayload() was called and mouse button is released over the target item.
 
-    ImGuiPayload()  { Clear(); }
+    ImGuiPayload()  { DataVersion = 0; Clear(); }
     void Clear()    { SourceId = SourceParentId = 0; Data = NULL; DataSize = 0; memset(DataType, 0, sizeof(DataType)); DataFrameCount = -1; Preview = Delivery = false; }
     bool IsDataType(const char* type) const { return DataFrameCount != -1 && strcmp(type, DataType) == 0; }
     bool IsPreview() const                  { return Preview; }
@@ -1830,6 +1871,7 @@ struct ImFont
     float                       Ascent, Descent;    //              // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     bool                        DirtyLookupTables;
     int                         MetricsTotalSurface;//              // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
+    ImFontLayoutCache*          LayoutCache;        //              // Created by BuildLookupTable(), NULL with IMGUI_DISABLE_TEXT_LAYOUT_CACHE
 
     // Methods
     IMGUI_API ImFont();
@@ -1854,6 +1896,7 @@ struct ImFont
     IMGUI_API void              GrowIndex(int new_size);
     IMGUI_API void              AddGlyph(ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
+    IMGUI_API ImVec2            CalcTextSizeEx(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining, ImVector<int>* out_wrap_breaks) const; // Uncached CalcTextSizeA(), optionally records the word-wrap positions
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     typedef ImFontGlyph Glyph; // OBSOLETE 1.52+
@@ -213,13 +213,60 @@ struct DockContext
 	};
 
 
+	// Snapshot of a single dock inside a layout preset, links are indices into the preset
+	struct LayoutEntry
+	{
+		ImU32 id;
+		int label_offset;
+		ImVec2 pos;
+		ImVec2 size;
+		Status_ status;
+		bool active;
+		bool opened;
+		bool noTabs;
+		bool noPad;
+		int children[2];
+		int prev_tab;
+		int next_tab;
+		int parent;
+		char location[16];
+
+		bool isContainer() const { return children[0] >= 0; }
+	};
+
+
+	struct LayoutPreset
+	{
+		ImU32 id;
+		char* name;
+		ImVector<LayoutEntry> entries;
+		ImVector<char> labels;
+
+		~LayoutPreset() { MemFree(name); }
+	};
+
+
 	ImVector<Dock*> m_docks;
+	ImVector<Dock*> m_container_pool;
+	ImVector<LayoutPreset*> m_presets;
+	ImVector<Dock*> m_layout_map;
+	ImVector<Dock*> m_layout_scratch;
 	ImVec2 m_drag_offset;
 	Dock* m_current = nullptr;
 	int m_last_frame = 0;
 	EndAction_ m_end_action;
     ImRect m_dockspace_rect;
 
+	// cached tree layout, see rootDock()
+	bool m_layout_dirty = true;
+	Dock* m_layout_root = nullptr;
+	ImVec2 m_layout_pos;
+	ImVec2 m_layout_size;
+	float m_layout_line_height = 0.0f;
+	int m_layout_recomputes = 0;
+	int m_stats_frame = -1;
+	ImGuiDockStats m_stats;
+
 	~DockContext() {}
 
 
@@ -269,6 +316,34 @@ struct DockContext
 	}
 
 
+	// Containers are recycled through a pool instead of being freed, layout switches churn them constantly
+	Dock* acquireContainer()
+	{
+		if (m_container_pool.empty())
+		{
+			Dock* container = (Dock*)MemAlloc(sizeof(Dock));
+			IM_PLACEMENT_NEW(container) Dock();
+			container->label = ImStrdup("");
+			return container;
+		}
+
+		Dock* container = m_container_pool.back();
+		m_container_pool.pop_back();
+		char* label = container->label;
+		IM_PLACEMENT_NEW(container) Dock();
+		container->label = label;
+		return container;
+	}
+
+
+	void releaseContainer(Dock* container)
+	{
+		container->children[0] = container->children[1] = nullptr;
+		container->parent = container->prev_tab = container->next_tab = nullptr;
+		m_container_pool.push_back(container);
+	}
+
+
 	void putInBackground()
 	{
 		ImGuiWindow* win = GetCurrentWindow();
@@ -343,11 +418,16 @@ struct DockContext
 				dsize.y = -ImMin(-dsize.y, dock.children[0]->size.y - min_size0.y);
 				dsize.y = ImMin(dsize.y, dock.children[1]->size.y - min_size1.y);
 			}
-			ImVec2 new_size0 = dock.children[0]->size + dsize;
-			ImVec2 new_size1 = dock.children[1]->size - dsize;
-			ImVec2 new_pos1 = dock.children[1]->pos + dsize;
-			dock.children[0]->setPosSize(dock.children[0]->pos, new_size0);
-			dock.children[1]->setPosSize(new_pos1, new_size1);
+			if (dsize.x != 0 || dsize.y != 0)
+			{
+				ImVec2 new_size0 = dock.children[0]->size + dsize;
+				ImVec2 new_size1 = dock.children[1]->size - dsize;
+				ImVec2 new_pos1 = dock.children[1]->pos + dsize;
+				dock.children[0]->setPosSize(dock.children[0]->pos, new_size0);
+				dock.children[1]->setPosSize(new_pos1, new_size1);
+				countLayoutRecompute();
+				invalidateLayout();
+			}
 
             auto cursorType = dock.isHorizontal() ? ImGuiMouseCursor_ResizeEW : ImGuiMouseCursor_ResizeNS;
             if (IsItemHovered() && IsMouseClicked(0))
@@ -600,6 +680,7 @@ struct DockContext
 
 	void doUndock(Dock& dock)
 	{
+		invalidateLayout();
 		if (dock.prev_tab)
 			dock.prev_tab->setActive();
 		else if (dock.next_tab)
@@ -653,8 +734,7 @@ struct DockContext
 						break;
 					}
 				}
-				container->~Dock();
-				MemFree(container);
+				releaseContainer(container);
 			}
 		}
 		if (dock.prev_tab) dock.prev_tab->next_tab = dock.next_tab;
@@ -866,6 +946,7 @@ struct DockContext
 
 	void doDock(Dock& dock, Dock* dest, Slot_ dock_slot)
 	{
+		invalidateLayout();
 		IM_ASSERT(!dock.parent);
 		if (!dest)
 		{
@@ -893,8 +974,7 @@ struct DockContext
 		}
 		else
 		{
-			Dock* container = (Dock*)MemAlloc(sizeof(Dock));
-			IM_PLACEMENT_NEW(container) Dock();
+			Dock* container = acquireContainer();
 			m_docks.push_back(container);
 			container->children[0] = &dest->getFirstTab();
 			container->children[1] = &dock;
@@ -904,7 +984,6 @@ struct DockContext
 			container->size = dest->size;
 			container->pos = dest->pos;
 			container->status = Status_Docked;
-			container->label = ImStrdup("");
 
 			if (!dest->parent)
 			{
@@ -930,12 +1009,47 @@ struct DockContext
 
 	void rootDock(const ImVec2& pos, const ImVec2& size)
 	{
+		int frame = GetFrameCount();
+		if (frame != m_stats_frame)
+		{
+			m_stats.LayoutRecomputes = m_layout_recomputes;
+			m_layout_recomputes = 0;
+			m_stats_frame = frame;
+		}
+
 		Dock* root = getRootDock();
 		if (!root) return;
 
+		// the tree only needs laying out again if something invalidated it, the root rect moved or the font changed
+		float line_height = GetTextLineHeightWithSpacing();
+		if (!m_layout_dirty && root == m_layout_root && line_height == m_layout_line_height &&
+			pos.x == m_layout_pos.x && pos.y == m_layout_pos.y &&
+			size.x == m_layout_size.x && size.y == m_layout_size.y)
+		{
+			++m_stats.LayoutCacheHits;
+			return;
+		}
+
 		ImVec2 min_size = root->getMinSize();
 		ImVec2 requested_size = size;
 		root->setPosSize(pos, ImMax(min_size, requested_size));
+		countLayoutRecompute();
+
+		m_layout_dirty = false;
+		m_layout_root = root;
+		m_layout_pos = pos;
+		m_layout_size = size;
+		m_layout_line_height = line_height;
+	}
+
+
+	void invalidateLayout() { m_layout_dirty = true; }
+
+
+	void countLayoutRecompute()
+	{
+		++m_layout_recomputes;
+		++m_stats.LayoutRecomputesTotal;
 	}
 
 
@@ -1201,6 +1315,7 @@ struct DockContext
 
 	void load()
 	{
+		invalidateLayout();
 		for (int i = 0; i < m_docks.size(); ++i)
 		{
 			m_docks[i]->~Dock();
@@ -1270,6 +1385,203 @@ struct DockContext
 		printf("done\n"); fflush(stdout);
 
 	}
+
+
+	LayoutPreset* findPreset(const char* name)
+	{
+		ImU32 id = ImHash(name, 0);
+		for (int i = 0; i < m_presets.size(); ++i)
+		{
+			if (m_presets[i]->id == id) return m_presets[i];
+		}
+		return nullptr;
+	}
+
+
+	Dock* findDock(ImU32 id)
+	{
+		for (int i = 0; i < m_docks.size(); ++i)
+		{
+			if (m_docks[i]->id == id && !m_docks[i]->isContainer()) return m_docks[i];
+		}
+		return nullptr;
+	}
+
+
+	void savePreset(const char* name)
+	{
+		LayoutPreset* preset = findPreset(name);
+		if (!preset)
+		{
+			preset = (LayoutPreset*)MemAlloc(sizeof(LayoutPreset));
+			IM_PLACEMENT_NEW(preset) LayoutPreset();
+			preset->id = ImHash(name, 0);
+			preset->name = ImStrdup(name);
+			m_presets.push_back(preset);
+		}
+
+		preset->entries.resize(m_docks.size());
+		preset->labels.resize(0);
+		for (int i = 0; i < m_docks.size(); ++i)
+		{
+			Dock& dock = *m_docks[i];
+			LayoutEntry& entry = preset->entries[i];
+
+			int label_len = (int)strlen(dock.label) + 1;
+			entry.label_offset = preset->labels.size();
+			preset->labels.resize(entry.label_offset + label_len);
+			memcpy(preset->labels.Data + entry.label_offset, dock.label, label_len);
+
+			fillLocation(dock);
+			entry.id = dock.id;
+			entry.pos = dock.pos;
+			entry.size = dock.size;
+			entry.status = dock.status == Status_Dragged ? Status_Float : dock.status;
+			entry.active = dock.active;
+			entry.opened = dock.opened;
+			entry.noTabs = dock.noTabs;
+			entry.noPad = dock.noPad;
+			entry.children[0] = getDockIndex(dock.children[0]);
+			entry.children[1] = getDockIndex(dock.children[1]);
+			entry.prev_tab = getDockIndex(dock.prev_tab);
+			entry.next_tab = getDockIndex(dock.next_tab);
+			entry.parent = getDockIndex(dock.parent);
+			memcpy(entry.location, dock.location, sizeof(entry.location));
+		}
+	}
+
+
+	static bool samePosSize(const Dock& dock, const LayoutEntry& entry)
+	{
+		return dock.pos.x == entry.pos.x && dock.pos.y == entry.pos.y &&
+			   dock.size.x == entry.size.x && dock.size.y == entry.size.y;
+	}
+
+
+	// Reuses the live Dock objects: leaves are matched by id and containers are recycled, only
+	// docks whose links or rectangles differ from the preset are touched. Returns the number
+	// of docks changed or -1 if the preset doesn't exist.
+	int loadPreset(const char* name)
+	{
+		IM_ASSERT(!m_current); // can't switch layouts between BeginDock/EndDock
+		LayoutPreset* preset = findPreset(name);
+		if (!preset) return -1;
+
+		const int count = preset->entries.size();
+		m_layout_scratch.resize(0);
+		for (int i = 0; i < m_docks.size(); ++i)
+		{
+			if (m_docks[i]->isContainer()) m_layout_scratch.push_back(m_docks[i]);
+		}
+
+		int next_container = 0;
+		m_layout_map.resize(count);
+		for (int i = 0; i < count; ++i)
+		{
+			const LayoutEntry& entry = preset->entries[i];
+			if (entry.isContainer())
+			{
+				m_layout_map[i] = next_container < m_layout_scratch.size()
+									  ? m_layout_scratch[next_container++]
+									  : acquireContainer();
+				continue;
+			}
+
+			Dock* dock = findDock(entry.id);
+			if (!dock)
+			{
+				dock = (Dock*)MemAlloc(sizeof(Dock));
+				IM_PLACEMENT_NEW(dock) Dock();
+				dock->label = ImStrdup(preset->labels.Data + entry.label_offset);
+				dock->id = entry.id;
+				dock->first = false;
+				dock->last_frame = 0;
+				dock->invalid_frames = 0;
+				m_docks.push_back(dock);
+			}
+			m_layout_map[i] = dock;
+		}
+		for (; next_container < m_layout_scratch.size(); ++next_container)
+			releaseContainer(m_layout_scratch[next_container]);
+
+		// docks that aren't part of the preset float on their own
+		int changed = 0;
+		m_layout_scratch.resize(0);
+		for (int i = 0; i < m_docks.size(); ++i)
+		{
+			Dock* dock = m_docks[i];
+			if (dock->isContainer()) continue;
+			bool mapped = false;
+			for (int j = 0; j < count && !mapped; ++j)
+				mapped = m_layout_map[j] == dock;
+			if (mapped) continue;
+
+			if (dock->parent || dock->prev_tab || dock->next_tab || dock->status != Status_Float)
+			{
+				dock->parent = dock->prev_tab = dock->next_tab = nullptr;
+				dock->status = Status_Float;
+				dock->location[0] = 0;
+				++changed;
+			}
+			m_layout_scratch.push_back(dock);
+		}
+
+		for (int i = 0; i < count; ++i)
+		{
+			const LayoutEntry& entry = preset->entries[i];
+			Dock& dock = *m_layout_map[i];
+			Dock* children0 = entry.children[0] >= 0 ? m_layout_map[entry.children[0]] : nullptr;
+			Dock* children1 = entry.children[1] >= 0 ? m_layout_map[entry.children[1]] : nullptr;
+			Dock* prev_tab = entry.prev_tab >= 0 ? m_layout_map[entry.prev_tab] : nullptr;
+			Dock* next_tab = entry.next_tab >= 0 ? m_layout_map[entry.next_tab] : nullptr;
+			Dock* parent = entry.parent >= 0 ? m_layout_map[entry.parent] : nullptr;
+
+			bool same = samePosSize(dock, entry) && dock.status == entry.status &&
+						dock.active == entry.active && dock.opened == entry.opened &&
+						dock.noTabs == entry.noTabs && dock.noPad == entry.noPad &&
+						strcmp(dock.location, entry.location) == 0 &&
+						dock.children[0] == children0 && dock.children[1] == children1 &&
+						dock.prev_tab == prev_tab && dock.next_tab == next_tab && dock.parent == parent;
+			if (same) continue;
+
+			dock.pos = entry.pos;
+			dock.size = entry.size;
+			dock.status = entry.status;
+			dock.active = entry.active;
+			dock.opened = entry.opened;
+			dock.noTabs = entry.noTabs;
+			dock.noPad = entry.noPad;
+			dock.children[0] = children0;
+			dock.children[1] = children1;
+			dock.prev_tab = prev_tab;
+			dock.next_tab = next_tab;
+			dock.parent = parent;
+			memcpy(dock.location, entry.location, sizeof(dock.location));
+			++changed;
+		}
+
+		// preset order first so getRootDock() resolves the same root as when it was captured
+		for (int i = 0; i < m_layout_scratch.size(); ++i)
+			m_layout_map.push_back(m_layout_scratch[i]);
+		m_docks.swap(m_layout_map);
+		if (changed) invalidateLayout();
+		return changed;
+	}
+
+
+	void removePreset(const char* name)
+	{
+		for (int i = 0; i < m_presets.size(); ++i)
+		{
+			if (m_presets[i]->id == ImHash(name, 0))
+			{
+				m_presets[i]->~LayoutPreset();
+				MemFree(m_presets[i]);
+				m_presets.erase(m_presets.begin() + i);
+				return;
+			}
+		}
+	}
 };
 
 
@@ -1307,12 +1619,29 @@ void ShutdownDock()
 		MemFree(g_dock.m_docks[i]);
 	}
 	g_dock.m_docks.clear();
+	for (int i = 0; i < g_dock.m_container_pool.size(); ++i)
+	{
+		g_dock.m_container_pool[i]->~Dock();
+		MemFree(g_dock.m_container_pool[i]);
+	}
+	g_dock.m_container_pool.clear();
+	for (int i = 0; i < g_dock.m_presets.size(); ++i)
+	{
+		g_dock.m_presets[i]->~LayoutPreset();
+		MemFree(g_dock.m_presets[i]);
+	}
+	g_dock.m_presets.clear();
+	g_dock.m_layout_root = nullptr;
+	g_dock.invalidateLayout();
+	if (GImGui)
+		GImGui->DockMetricsFn = nullptr;
 }
 
 
 void RootDock(const ImVec2& pos, const ImVec2& size)
 {
     g_dock.m_dockspace_rect = ImRect(pos, pos + size);
+	GImGui->DockMetricsFn = ShowDockMetrics;
 	g_dock.rootDock(pos, size);
 }
 
@@ -1350,4 +1679,49 @@ void LoadDock()
 }
 
 
+const ImGuiDockStats& GetDockStats()
+{
+	return g_dock.m_stats;
+}
+
+
+void ShowDockMetrics()
+{
+	const ImGuiDockStats& stats = g_dock.m_stats;
+	int containers = 0;
+	for (int i = 0; i < g_dock.m_docks.size(); ++i)
+		containers += g_dock.m_docks[i]->isContainer() ? 1 : 0;
+	Text("%d docks, %d containers, %d pooled", g_dock.m_docks.size() - containers, containers, g_dock.m_container_pool.size());
+	Text("Layout recomputes: %d last frame, %d total", stats.LayoutRecomputes, stats.LayoutRecomputesTotal);
+	Text("Layout cache hits: %d", stats.LayoutCacheHits);
+	Text("Presets: %d", g_dock.m_presets.size());
+}
+
+
+void SaveDockPreset(const char* name)
+{
+	g_dock.savePreset(name);
+}
+
+
+bool LoadDockPreset(const char* name, int* changed_count)
+{
+	int changed = g_dock.loadPreset(name);
+	if (changed_count) *changed_count = ImMax(changed, 0);
+	return changed >= 0;
+}
+
+
+void RemoveDockPreset(const char* name)
+{
+	g_dock.removePreset(name);
+}
+
+
+bool HasDockPreset(const char* name)
+{
+	return g_dock.findPreset(name) != nullptr;
+}
+
+
 } // namespace ImGui
@@ -3,6 +3,13 @@
 #include "imgui.h"
 
 
+struct ImGuiDockStats
+{
+    int LayoutRecomputes = 0;       // dock tree layout passes run during the last frame (root or splitter)
+    int LayoutRecomputesTotal = 0;
+    int LayoutCacheHits = 0;        // RootDock() calls that reused the cached layout
+};
+
 namespace ImGui
 {
 
@@ -15,7 +22,14 @@ IMGUI_API void EndDock();
 IMGUI_API void SetDockActive();
 IMGUI_API void LoadDock();
 IMGUI_API void SaveDock();
+// In-memory layout presets, switching between them reuses the existing docks and never touches the disk
+IMGUI_API void SaveDockPreset(const char* name);
+IMGUI_API bool LoadDockPreset(const char* name, int* changed_count = nullptr);
+IMGUI_API void RemoveDockPreset(const char* name);
+IMGUI_API bool HasDockPreset(const char* name);
 IMGUI_API void Print();
+IMGUI_API const ImGuiDockStats& GetDockStats();
+IMGUI_API void ShowDockMetrics();   // Contents of the "Docking" node of the metrics window, which calls it through ImGuiContext::DockMetricsFn once RootDock() ran
 
 } // namespace ImGui
 
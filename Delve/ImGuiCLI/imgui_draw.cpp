@@ -617,6 +617,7 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
 {
+    IMGUI_PROFILE_SCOPE(ImGuiProfilePhase_Tessellation);
     if (points_count < 2)
         return;
 
@@ -796,6 +797,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
 
 void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
 {
+    IMGUI_PROFILE_SCOPE(ImGuiProfilePhase_Tessellation);
     const ImVec2 uv = _Data->TexUvWhitePixel;
 
     if (Flags & ImDrawListFlags_AntiAliasedFill)
@@ -2154,6 +2156,7 @@ ImFont::ImFont()
     Scale = 1.0f;
     FallbackChar = (ImWchar)'?';
     DisplayOffset = ImVec2(0.0f, 0.0f);
+    LayoutCache = NULL;
     ClearOutputData();
 }
 
@@ -2184,6 +2187,8 @@ void    ImFont::ClearOutputData()
     Ascent = Descent = 0.0f;
     DirtyLookupTables = true;
     MetricsTotalSurface = 0;
+    IM_DELETE(LayoutCache);
+    LayoutCache = NULL;
 }
 
 void ImFont::BuildLookupTable()
@@ -2223,6 +2228,12 @@ void ImFont::BuildLookupTable()
     for (int i = 0; i < max_codepoint + 1; i++)
         if (IndexAdvanceX[i] < 0.0f)
             IndexAdvanceX[i] = FallbackAdvanceX;
+
+#ifndef IMGUI_DISABLE_TEXT_LAYOUT_CACHE
+    if (!LayoutCache)
+        LayoutCache = IM_NEW(ImFontLayoutCache)();
+    LayoutCache->Clear();
+#endif
 }
 
 void ImFont::SetFallbackChar(ImWchar c)
@@ -2276,6 +2287,8 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     GrowIndex(dst + 1);
     IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (unsigned short)-1;
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    if (LayoutCache)
+        LayoutCache->Clear();
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
@@ -2402,9 +2415,19 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
 
 ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
 {
+    IMGUI_PROFILE_SCOPE(ImGuiProfilePhase_TextLayout);
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
 
+    // Only whole strings are cached, callers passing 'max_width' or 'remaining' want a prefix
+    if (LayoutCache && max_width == FLT_MAX && remaining == NULL && (wrap_width > 0.0f || text_end - text_begin >= IMGUI_TEXT_LAYOUT_CACHE_MIN_LENGTH))
+        if (const ImFontLayoutCacheEntry* entry = LayoutCache->FindOrAdd(this, size, wrap_width, text_begin, text_end))
+            return entry->TextSize;
+    return CalcTextSizeEx(size, max_width, wrap_width, text_begin, text_end, remaining, NULL);
+}
+
+ImVec2 ImFont::CalcTextSizeEx(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining, ImVector<int>* out_wrap_breaks) const
+{
     const float line_height = size;
     const float scale = size / FontSize;
 
@@ -2428,6 +2451,8 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - line_width);
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
                     word_wrap_eol++;    // +1 may not be a character start point in UTF-8 but it's ok because we use s >= word_wrap_eol below
+                if (out_wrap_breaks)
+                    out_wrap_breaks->push_back((int)(word_wrap_eol - text_begin));
             }
 
             if (s >= word_wrap_eol)
@@ -2497,6 +2522,110 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     return text_size;
 }
 
+//-----------------------------------------------------------------------------
+// ImFontLayoutCache
+//-----------------------------------------------------------------------------
+
+// 8 bytes per step, the point is to be several times cheaper than decoding and measuring the string
+static ImU64 ImHashTextLayout(const char* text, const char* text_end)
+{
+    const ImU64 k = 0x9E3779B97F4A7C15ULL;
+    ImU64 h = (ImU64)(text_end - text) * k;
+    ImU64 v;
+    for (; text + 8 <= text_end; text += 8)
+    {
+        memcpy(&v, text, 8);
+        h = (h ^ v) * k;
+        h ^= h >> 29;
+    }
+    v = 0;
+    memcpy(&v, text, (size_t)(text_end - text));
+    h = (h ^ v) * k;
+    h ^= h >> 33; h *= 0xFF51AFD7ED558CCDULL; h ^= h >> 33; // Products only carry upward, mix the high bits back down
+    return h | 1; // 0 marks unused slots
+}
+
+// Marks every slot unused, the entry holds an ImVec2 so it gets assigned rather than memset
+static void ImFontLayoutCacheResetEntries(ImVector<ImFontLayoutCacheEntry>& entries)
+{
+    const ImFontLayoutCacheEntry unused = ImFontLayoutCacheEntry();
+    for (int n = 0; n < entries.Size; n++)
+        entries[n] = unused;
+}
+
+void ImFontLayoutCache::Clear()
+{
+    ImFontLayoutCacheResetEntries(Entries);
+    WrapBreaks.resize(0);
+    Clock = 0;
+    Hits = Misses = Evictions = 0;
+}
+
+int ImFontLayoutCache::GetUsedCount() const
+{
+    int count = 0;
+    for (int n = 0; n < Entries.Size; n++)
+        if (Entries[n].Hash != 0)
+            count++;
+    return count;
+}
+
+const ImFontLayoutCacheEntry* ImFontLayoutCache::FindOrAdd(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end)
+{
+    const int sets_count = IMGUI_TEXT_LAYOUT_CACHE_SIZE / IMGUI_TEXT_LAYOUT_CACHE_WAYS;
+    if (Entries.Size == 0)
+    {
+        if (Frozen)
+            return NULL;
+        Entries.resize(IMGUI_TEXT_LAYOUT_CACHE_SIZE);
+        ImFontLayoutCacheResetEntries(Entries);
+    }
+
+    const ImU64 hash = ImHashTextLayout(text_begin, text_end);
+    const int text_length = (int)(text_end - text_begin);
+    ImFontLayoutCacheEntry* set = &Entries[(int)((hash >> 1) % (ImU64)sets_count) * IMGUI_TEXT_LAYOUT_CACHE_WAYS];
+    ImFontLayoutCacheEntry* victim = &set[0];
+    for (int n = 0; n < IMGUI_TEXT_LAYOUT_CACHE_WAYS; n++)
+    {
+        ImFontLayoutCacheEntry* entry = &set[n];
+        if (entry->Hash == hash && entry->TextLength == text_length && entry->Size == size && entry->WrapWidth == wrap_width)
+        {
+            if (!Frozen)
+            {
+                entry->LastUse = ++Clock;
+                Hits++;
+            }
+            return entry;
+        }
+        if (victim->Hash != 0 && (entry->Hash == 0 || entry->LastUse < victim->LastUse)) // Prefer an unused slot, then the least recently used one
+            victim = entry;
+    }
+
+    if (Frozen)
+        return NULL;
+
+    // Break positions of evicted entries are never reclaimed, start over once they dominate the cache
+    if (WrapBreaks.Size > IMGUI_TEXT_LAYOUT_CACHE_SIZE * 16)
+    {
+        ImFontLayoutCacheResetEntries(Entries);
+        WrapBreaks.resize(0);
+        victim = &set[0];
+    }
+
+    Misses++;
+    if (victim->Hash != 0)
+        Evictions++;
+    victim->Hash = hash;
+    victim->TextLength = text_length;
+    victim->Size = size;
+    victim->WrapWidth = wrap_width;
+    victim->LastUse = ++Clock;
+    victim->WrapBreaksOffset = WrapBreaks.Size;
+    victim->TextSize = font->CalcTextSizeEx(size, FLT_MAX, wrap_width, text_begin, text_end, NULL, wrap_width > 0.0f ? &WrapBreaks : NULL);
+    victim->WrapBreaksCount = WrapBreaks.Size - victim->WrapBreaksOffset;
+    return victim;
+}
+
 void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, unsigned short c) const
 {
     if (c == ' ' || c == '\t' || c == '\n' || c == '\r') // Match behavior of RenderText(), those 4 codepoints are hard-coded.
@@ -2511,8 +2640,31 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     }
 }
 
+// Returns the end of the run of printable ASCII starting at 's': stops at control characters, UTF-8 sequences and '^' color codes
+static const char* ImTextFindAsciiRun(const char* s, const char* s_end)
+{
+#if IMGUI_SSE
+    const __m128i space_minus_one = _mm_set1_epi8(0x1F);
+    const __m128i del = _mm_set1_epi8(0x7F);
+    const __m128i caret = _mm_set1_epi8('^');
+    while (s_end - s >= 16)
+    {
+        // Signed compares, bytes >= 0x80 are negative and fail the first test
+        const __m128i v = _mm_loadu_si128((const __m128i*)s);
+        const __m128i printable = _mm_andnot_si128(_mm_cmpeq_epi8(v, caret), _mm_and_si128(_mm_cmpgt_epi8(v, space_minus_one), _mm_cmplt_epi8(v, del)));
+        if (_mm_movemask_epi8(printable) != 0xFFFF)
+            break;
+        s += 16;
+    }
+#endif
+    while (s < s_end && (unsigned char)(*s - 0x20) < 0x5F && *s != '^')
+        s++;
+    return s;
+}
+
 void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
 {
+    IMGUI_PROFILE_SCOPE(ImGuiProfilePhase_TextLayout);
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // ImGui functions generally already provides a valid text_end, so this is merely to handle direct calls.
 
@@ -2529,6 +2681,18 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
 
+    // Wrapped text replays the break positions CalcTextSize() already found for it instead of scanning every line twice
+    const int* wrap_breaks = NULL;
+    int wrap_breaks_count = 0, wrap_breaks_n = 0;
+    if (word_wrap_enabled && LayoutCache)
+    {
+        if (const ImFontLayoutCacheEntry* entry = LayoutCache->FindOrAdd(this, size, wrap_width, text_begin, text_end))
+        {
+            wrap_breaks = LayoutCache->WrapBreaks.Data + entry->WrapBreaksOffset;
+            wrap_breaks_count = entry->WrapBreaksCount;
+        }
+    }
+
     // Skip non-visible lines
     const char* s = text_begin;
     if (!word_wrap_enabled && y + line_height < clip_rect.y)
@@ -2560,6 +2724,10 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         ImColor(255,   128,   0, alpha), // orange     9
     };
 
+    // Printable ASCII runs skip UTF-8 decoding, color codes and newline handling and index the glyphs directly.
+    // Produces the same vertices as the generic loop below, which still handles everything else.
+    const bool ascii_fast_path = !cpu_fine_clip && IndexLookup.Size >= 0x80;
+
     while (s < text_end)
     {
         if (*s == '^' && *(s + 1) && *(s + 1) != '^')
@@ -2572,7 +2740,11 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         if (word_wrap_enabled)
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
-            if (!word_wrap_eol)
+            if (!word_wrap_eol && wrap_breaks_n < wrap_breaks_count)
+            {
+                word_wrap_eol = text_begin + wrap_breaks[wrap_breaks_n++];
+            }
+            else if (!word_wrap_eol)
             {
                 word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - pos.x));
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
@@ -2595,6 +2767,43 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             }
         }
 
+        if (ascii_fast_path)
+        {
+            const char* run_end = ImTextFindAsciiRun(s, (word_wrap_enabled && word_wrap_eol < text_end) ? word_wrap_eol : text_end);
+            if (run_end > s)
+            {
+                for (; s < run_end; s++)
+                {
+                    const unsigned short glyph_index = IndexLookup.Data[(unsigned char)*s];
+                    const ImFontGlyph* glyph = (glyph_index != (unsigned short)-1) ? &Glyphs.Data[glyph_index] : FallbackGlyph;
+                    if (!glyph)
+                        continue;
+                    const float char_width = glyph->AdvanceX * scale;
+                    if (*s != ' ')
+                    {
+                        const float x1 = x + glyph->X0 * scale;
+                        const float x2 = x + glyph->X1 * scale;
+                        if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+                        {
+                            const float y1 = y + glyph->Y0 * scale;
+                            const float y2 = y + glyph->Y1 * scale;
+                            idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+                            idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+                            vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = glyph->U0; vtx_write[0].uv.y = glyph->V0;
+                            vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = glyph->U1; vtx_write[1].uv.y = glyph->V0;
+                            vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = glyph->U1; vtx_write[2].uv.y = glyph->V1;
+                            vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = glyph->U0; vtx_write[3].uv.y = glyph->V1;
+                            vtx_write += 4;
+                            vtx_current_idx += 4;
+                            idx_write += 6;
+                        }
+                    }
+                    x += char_width;
+                }
+                continue;
+            }
+        }
+
         // Decode and advance source
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
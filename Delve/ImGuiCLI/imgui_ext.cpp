@@ -341,4 +341,535 @@ namespace ImGui
         return value_changed;
     }
 
-}
\ No newline at end of file
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiPlotStream
+//-----------------------------------------------------------------------------
+
+ImGuiPlotStream::ImGuiPlotStream(int capacity)
+{
+    LeafCount = Capacity = Count = Head = 0;
+    SetCapacity(capacity);
+}
+
+void ImGuiPlotStream::SetCapacity(int capacity)
+{
+    IM_ASSERT(capacity >= 0);
+    Capacity = capacity;
+    LeafCount = 1;
+    while (LeafCount < Capacity)
+        LeafCount <<= 1;
+    Min.resize(LeafCount * 2);
+    Max.resize(LeafCount * 2);
+    Clear();
+}
+
+void ImGuiPlotStream::Clear()
+{
+    // empty slots never win a min/max, so a partially filled stream needs no special casing
+    for (int n = 0; n < Min.Size; n++)
+    {
+        Min[n] = FLT_MAX;
+        Max[n] = -FLT_MAX;
+    }
+    Count = Head = 0;
+}
+
+void ImGuiPlotStream::UpdateSlot(int slot)
+{
+    for (int n = (LeafCount + slot) >> 1; n >= 1; n >>= 1)
+    {
+        const float v_min = ImMin(Min[n * 2], Min[n * 2 + 1]);
+        const float v_max = ImMax(Max[n * 2], Max[n * 2 + 1]);
+        if (v_min == Min[n] && v_max == Max[n])
+            break;  // ancestors only depend on this node
+        Min[n] = v_min;
+        Max[n] = v_max;
+    }
+}
+
+void ImGuiPlotStream::RebuildNodes()
+{
+    for (int n = LeafCount - 1; n >= 1; n--)
+    {
+        Min[n] = ImMin(Min[n * 2], Min[n * 2 + 1]);
+        Max[n] = ImMax(Max[n * 2], Max[n * 2 + 1]);
+    }
+}
+
+void ImGuiPlotStream::Append(float v)
+{
+    if (Capacity == 0)
+        return;
+    Min[LeafCount + Head] = Max[LeafCount + Head] = v;
+    UpdateSlot(Head);
+    if (++Head == Capacity)
+        Head = 0;
+    if (Count < Capacity)
+        Count++;
+}
+
+void ImGuiPlotStream::Append(const float* values, int values_count)
+{
+    if (Capacity == 0 || values_count <= 0)
+        return;
+    if (values_count > Capacity)
+    {
+        values += values_count - Capacity;
+        values_count = Capacity;
+    }
+
+    // Small batches walk up from each leaf, large ones are cheaper as a single bottom-up rebuild
+    if (values_count * 4 < Capacity)
+    {
+        for (int n = 0; n < values_count; n++)
+            Append(values[n]);
+        return;
+    }
+
+    for (int n = 0; n < values_count; n++)
+    {
+        Min[LeafCount + Head] = Max[LeafCount + Head] = values[n];
+        if (++Head == Capacity)
+            Head = 0;
+    }
+    Count = ImMin(Count + values_count, Capacity);
+    RebuildNodes();
+}
+
+float ImGuiPlotStream::Get(int idx) const
+{
+    IM_ASSERT(idx >= 0 && idx < Count);
+    int slot = Head - Count + idx;
+    if (slot < 0)
+        slot += Capacity;
+    return Min[LeafCount + slot];
+}
+
+void ImGuiPlotStream::QuerySlots(int slot_begin, int slot_end, float* io_min, float* io_max) const
+{
+    for (int l = slot_begin + LeafCount, r = slot_end + LeafCount; l < r; l >>= 1, r >>= 1)
+    {
+        if (l & 1)
+        {
+            *io_min = ImMin(*io_min, Min[l]);
+            *io_max = ImMax(*io_max, Max[l]);
+            l++;
+        }
+        if (r & 1)
+        {
+            r--;
+            *io_min = ImMin(*io_min, Min[r]);
+            *io_max = ImMax(*io_max, Max[r]);
+        }
+    }
+}
+
+void ImGuiPlotStream::GetMinMax(int idx_begin, int idx_end, float* out_min, float* out_max) const
+{
+    idx_begin = ImMax(idx_begin, 0);
+    idx_end = ImMin(idx_end, Count);
+    if (idx_begin >= idx_end)
+    {
+        *out_min = *out_max = 0.0f;
+        return;
+    }
+
+    float v_min = FLT_MAX;
+    float v_max = -FLT_MAX;
+    int slot_begin = Head - Count + idx_begin;
+    if (slot_begin < 0)
+        slot_begin += Capacity;
+    const int slot_end = slot_begin + (idx_end - idx_begin);
+    if (slot_end <= Capacity)
+    {
+        QuerySlots(slot_begin, slot_end, &v_min, &v_max);
+    }
+    else
+    {
+        // range wraps around the end of the ring
+        QuerySlots(slot_begin, Capacity, &v_min, &v_max);
+        QuerySlots(0, slot_end - Capacity, &v_min, &v_max);
+    }
+    *out_min = v_min;
+    *out_max = v_max;
+}
+
+namespace ImGui
+{
+
+    // Same layout and behavior as PlotEx, but each pixel column draws the min/max of the samples it covers
+    static void PlotStreamEx(ImGuiPlotType plot_type, const char* label, const ImGuiPlotStream* stream, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+    {
+        ImGuiWindow* window = GetCurrentWindow();
+        if (window->SkipItems)
+            return;
+
+        ImGuiContext& g = *GImGui;
+        const ImGuiStyle& style = g.Style;
+
+        const ImVec2 label_size = CalcTextSize(label, NULL, true);
+        if (graph_size.x == 0.0f)
+            graph_size.x = CalcItemWidth();
+        if (graph_size.y == 0.0f)
+            graph_size.y = label_size.y + (style.FramePadding.y * 2);
+
+        const ImRect frame_bb(window->DC.CursorPos, ImVec2(window->DC.CursorPos.x + graph_size.x, window->DC.CursorPos.y + graph_size.y));
+        const ImRect inner_bb(ImVec2(frame_bb.Min.x + style.FramePadding.x, frame_bb.Min.y + style.FramePadding.y), ImVec2(frame_bb.Max.x - style.FramePadding.x, frame_bb.Max.y - style.FramePadding.y));
+        const ImRect total_bb(frame_bb.Min, ImVec2(frame_bb.Max.x + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), frame_bb.Max.y));
+        ItemSize(total_bb, style.FramePadding.y);
+        if (!ItemAdd(total_bb, 0, &frame_bb))
+            return;
+        const bool hovered = ItemHoverable(inner_bb, 0);
+
+        // Scale comes straight from the pyramid root
+        if (scale_min == FLT_MAX)
+            scale_min = stream->GetMin();
+        if (scale_max == FLT_MAX)
+            scale_max = stream->GetMax();
+
+        RenderFrame(frame_bb.Min, frame_bb.Max, GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
+
+        const int values_count = stream->Count;
+        if (values_count > 0)
+        {
+            const float inner_w = inner_bb.GetWidth();
+            const int res_w = ImMax(ImMin((int)inner_w, values_count), 1);
+            const float col_w = inner_w / (float)res_w;
+            const bool single_samples = values_count <= res_w;
+
+            // Tooltip on hover
+            int v_hovered = -1;
+            if (hovered)
+            {
+                const float t = ImClamp((g.IO.MousePos.x - inner_bb.Min.x) / inner_w, 0.0f, 0.9999f);
+                const int col = (int)(t * res_w);
+                const int idx_begin = (int)((double)col * values_count / res_w);
+                const int idx_end = (int)((double)(col + 1) * values_count / res_w);
+                if (idx_end - idx_begin <= 1)
+                {
+                    SetTooltip("%d: %8.4g", idx_begin, stream->Get(idx_begin));
+                }
+                else
+                {
+                    float v_min, v_max;
+                    stream->GetMinMax(idx_begin, idx_end, &v_min, &v_max);
+                    SetTooltip("%d - %d\nmin: %8.4g\nmax: %8.4g", idx_begin, idx_end - 1, v_min, v_max);
+                }
+                v_hovered = col;
+            }
+
+            const float inv_scale = (scale_min == scale_max) ? 0.0f : (1.0f / (scale_max - scale_min));
+            const float histogram_zero_line_t = (scale_min * scale_max < 0.0f) ? (-scale_min * inv_scale) : (scale_min < 0.0f ? 0.0f : 1.0f);
+            const float zero_y = ImLerp(inner_bb.Min.y, inner_bb.Max.y, histogram_zero_line_t);
+
+            const ImU32 col_base = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLines : ImGuiCol_PlotHistogram);
+            const ImU32 col_hovered = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotHistogramHovered);
+
+            float prev_top = 0.0f, prev_bottom = 0.0f;
+            for (int n = 0; n < res_w; n++)
+            {
+                const int idx_begin = (int)((double)n * values_count / res_w);
+                const int idx_end = (int)((double)(n + 1) * values_count / res_w);
+                float v_min, v_max;
+                stream->GetMinMax(idx_begin, idx_end, &v_min, &v_max);
+
+                const float top = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_max - scale_min) * inv_scale));
+                const float bottom = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_min - scale_min) * inv_scale));
+                const float x0 = inner_bb.Min.x + n * col_w;
+                const ImU32 col = (v_hovered == n) ? col_hovered : col_base;
+
+                if (plot_type == ImGuiPlotType_Lines)
+                {
+                    if (single_samples)
+                    {
+                        // Not enough samples to fill the width, connect the points like PlotEx
+                        if (n > 0)
+                            window->DrawList->AddLine(ImVec2(x0 - col_w * 0.5f, prev_top), ImVec2(x0 + col_w * 0.5f, top), col);
+                    }
+                    else
+                    {
+                        // Stretch the envelope so it touches the previous column and reads as a continuous line
+                        const float y0 = (n > 0) ? ImMin(top, prev_bottom) : top;
+                        const float y1 = (n > 0) ? ImMax(bottom, prev_top) : bottom;
+                        window->DrawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x0 + col_w, ImMax(y1, y0 + 1.0f)), col);
+                    }
+                }
+                else if (plot_type == ImGuiPlotType_Histogram)
+                {
+                    const float x1 = (col_w >= 3.0f) ? x0 + col_w - 1.0f : x0 + col_w;
+                    window->DrawList->AddRectFilled(ImVec2(x0, ImMin(top, zero_y)), ImVec2(x1, ImMax(bottom, zero_y)), col);
+                }
+
+                prev_top = top;
+                prev_bottom = bottom;
+            }
+        }
+
+        // Text overlay
+        if (overlay_text)
+            RenderTextClipped(ImVec2(frame_bb.Min.x, frame_bb.Min.y + style.FramePadding.y), frame_bb.Max, overlay_text, NULL, NULL, ImVec2(0.5f, 0.0f));
+
+        if (label_size.x > 0.0f)
+            RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, inner_bb.Min.y), label);
+    }
+
+    void PlotStreamLines(const char* label, const ImGuiPlotStream* stream, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+    {
+        PlotStreamEx(ImGuiPlotType_Lines, label, stream, overlay_text, scale_min, scale_max, graph_size);
+    }
+
+    void PlotStreamHistogram(const char* label, const ImGuiPlotStream* stream, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+    {
+        PlotStreamEx(ImGuiPlotType_Histogram, label, stream, overlay_text, scale_min, scale_max, graph_size);
+    }
+
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiTextList
+//-----------------------------------------------------------------------------
+
+int ImGuiTextList::Add(const char* text, const char* text_end)
+{
+    if (!text_end)
+        text_end = text + strlen(text);
+    const int len = (int)(text_end - text);
+    const int offset = Buf.Size;
+    if (offset + len > Buf.Capacity)
+        Buf.reserve(ImMax(offset + len, Buf.Capacity * 2));
+    Buf.resize(offset + len);
+    memcpy(Buf.Data + offset, text, (size_t)len);
+    Offsets.push_back(Buf.Size);
+    return Offsets.Size - 2;
+}
+
+int ImGuiTextList::Filter(const ImGuiTextFilter& filter, ImVector<int>* out_indices, void (*jobs_runner)(int, void (*)(int, void*), void*, void*), void* jobs_runner_user_data) const
+{
+    return filter.PassFilterMany(Buf.Data, Offsets.Data, Size(), out_indices, jobs_runner, jobs_runner_user_data);
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiFuzzyIndex
+//-----------------------------------------------------------------------------
+
+// a-z, 0-9, one of 27 buckets for the other ASCII characters, one bit for all non-ASCII bytes. Inputs are lower-cased.
+static inline ImU64 ImFuzzyCharBit(unsigned char c)
+{
+    if (c >= 'a' && c <= 'z')
+        return (ImU64)1 << (c - 'a');
+    if (c >= '0' && c <= '9')
+        return (ImU64)1 << (26 + c - '0');
+    if (c < 0x80)
+        return (ImU64)1 << (36 + c % 27);
+    return (ImU64)1 << 63;
+}
+
+static inline unsigned char ImFuzzyToLower(unsigned char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + 'a' - 'A') : c;
+}
+
+static inline bool ImFuzzyIsLowerOrDigit(unsigned char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+}
+
+void ImGuiFuzzyIndex::Clear()
+{
+    Lower.resize(0);
+    Bonus.resize(0);
+    Offsets.resize(1);
+    Masks.resize(0);
+    LastValid = false;
+}
+
+int ImGuiFuzzyIndex::Add(const char* text, const char* text_end)
+{
+    if (!text_end)
+        text_end = text + strlen(text);
+    const int len = (int)(text_end - text);
+    const int offset = Lower.Size;
+    if (offset + len > Lower.Capacity)
+    {
+        Lower.reserve(ImMax(offset + len, Lower.Capacity * 2));
+        Bonus.reserve(Lower.Capacity);
+    }
+    Lower.resize(offset + len);
+    Bonus.resize(offset + len);
+    ImU64 mask = 0;
+    unsigned char prev = 0;
+    for (int n = 0; n < len; n++)
+    {
+        const unsigned char c = (unsigned char)text[n];
+        const unsigned char lower = ImFuzzyToLower(c);
+        unsigned char bonus = 0;
+        if (n == 0 || prev == '/' || prev == '\\')
+            bonus = 10;
+        else if (prev == '_' || prev == '-' || prev == '.' || prev == ' ' || prev == ':')
+            bonus = 8;
+        else if (c >= 'A' && c <= 'Z' && ImFuzzyIsLowerOrDigit(prev))
+            bonus = 7;
+        Lower[offset + n] = (char)lower;
+        Bonus[offset + n] = bonus;
+        mask |= ImFuzzyCharBit(lower);
+        prev = c;
+    }
+    Offsets.push_back(Lower.Size);
+    Masks.push_back(mask);
+    LastValid = false;
+    return Offsets.Size - 2;
+}
+
+// Score of the match of pattern in [str, str + len), -1 if pattern is not a subsequence of it.
+// The match is the shortest one ending at the end of the leftmost match (scanned forward then backward), scored once:
+// every matched byte is worth 16 plus its word start bonus, which carries over consecutive matches, gaps cost 3 then 1 per byte.
+static int ImFuzzyScore(const char* pattern, int pattern_len, const char* str, const unsigned char* bonus, int len)
+{
+    int end = 0;
+    for (int p = 0; p < pattern_len; p++, end++)
+    {
+        const char* found = (const char*)memchr(str + end, pattern[p], (size_t)(len - end));
+        if (!found)
+            return -1;
+        end = (int)(found - str);
+    }
+    int start = end;
+    for (int p = pattern_len - 1; p >= 0; start--)
+        if (str[start - 1] == pattern[p])
+            p--;
+
+    int score = 0;
+    int run_bonus = 0;
+    bool in_run = false;
+    for (int n = start, p = 0; p < pattern_len; n++)
+    {
+        if (str[n] == pattern[p])
+        {
+            run_bonus = in_run ? ImMax(run_bonus, (int)bonus[n]) : bonus[n];
+            score += 16 + run_bonus + (in_run ? 4 : 0) + (p == 0 ? bonus[n] : 0);
+            in_run = true;
+            p++;
+        }
+        else
+        {
+            score -= in_run ? 3 : 1;
+            in_run = false;
+        }
+    }
+    return score;
+}
+
+// Heap order: a sorts before b when it is the worse match. Ties go to the shorter candidate, then to the first added.
+static inline bool ImFuzzyIsWorse(const ImGuiFuzzyMatch& a, const ImGuiFuzzyMatch& b, const int* offsets)
+{
+    if (a.Score != b.Score)
+        return a.Score < b.Score;
+    const int a_len = offsets[a.Index + 1] - offsets[a.Index];
+    const int b_len = offsets[b.Index + 1] - offsets[b.Index];
+    if (a_len != b_len)
+        return a_len > b_len;
+    return a.Index > b.Index;
+}
+
+static void ImFuzzyHeapSiftDown(ImGuiFuzzyMatch* heap, int count, int n, const int* offsets)
+{
+    for (;;)
+    {
+        int worst = n;
+        const int child = n * 2 + 1;
+        if (child < count && ImFuzzyIsWorse(heap[child], heap[worst], offsets))
+            worst = child;
+        if (child + 1 < count && ImFuzzyIsWorse(heap[child + 1], heap[worst], offsets))
+            worst = child + 1;
+        if (worst == n)
+            return;
+        ImGuiFuzzyMatch tmp = heap[n]; heap[n] = heap[worst]; heap[worst] = tmp;
+        n = worst;
+    }
+}
+
+int ImGuiFuzzyIndex::Search(const char* pattern_src, ImGuiFuzzyMatch* out_matches, int max_matches)
+{
+    if (max_matches <= 0)
+        return 0;
+
+    char pattern_local[256];
+    int pattern_len = 0;
+    for (const char* p = pattern_src; *p && pattern_len < IM_ARRAYSIZE(pattern_local); p++)
+        if (*p != ' ')
+            pattern_local[pattern_len++] = (char)ImFuzzyToLower((unsigned char)*p);
+    const char* pattern = pattern_local;
+
+    const int candidate_count = Size();
+    if (pattern_len == 0)
+    {
+        const int count = ImMin(max_matches, candidate_count);
+        for (int n = 0; n < count; n++)
+        {
+            out_matches[n].Index = n;
+            out_matches[n].Score = 0;
+        }
+        return count;
+    }
+
+    ImU64 pattern_mask = 0;
+    for (int p = 0; p < pattern_len; p++)
+        pattern_mask |= ImFuzzyCharBit((unsigned char)pattern[p]);
+
+    // Typing extends the pattern, so only the previous matches need to be scanned again
+    const bool narrow = LastValid && LastPattern.Size <= pattern_len && memcmp(LastPattern.Data, pattern, (size_t)LastPattern.Size) == 0;
+    const int scan_count = narrow ? LastMatches.Size : candidate_count;
+    TempMatches.resize(0);
+
+    int count = 0;
+    for (int scan_n = 0; scan_n < scan_count; scan_n++)
+    {
+        const int idx = narrow ? LastMatches[scan_n] : scan_n;
+        if ((Masks[idx] & pattern_mask) != pattern_mask)
+            continue;
+        const int offset = Offsets[idx];
+        const int len = Offsets[idx + 1] - offset;
+        if (len < pattern_len)
+            continue;
+        const int score = ImFuzzyScore(pattern, pattern_len, Lower.Data + offset, Bonus.Data + offset, len);
+        if (score < 0)
+            continue;
+        TempMatches.push_back(idx);
+
+        ImGuiFuzzyMatch match;
+        match.Index = idx;
+        match.Score = score;
+        if (count < max_matches)
+        {
+            // Sift up
+            int n = count++;
+            out_matches[n] = match;
+            while (n > 0 && ImFuzzyIsWorse(out_matches[n], out_matches[(n - 1) / 2], Offsets.Data))
+            {
+                const int parent = (n - 1) / 2;
+                ImGuiFuzzyMatch tmp = out_matches[n]; out_matches[n] = out_matches[parent]; out_matches[parent] = tmp;
+                n = parent;
+            }
+        }
+        else if (ImFuzzyIsWorse(out_matches[0], match, Offsets.Data))
+        {
+            out_matches[0] = match;
+            ImFuzzyHeapSiftDown(out_matches, count, 0, Offsets.Data);
+        }
+    }
+
+    LastPattern.resize(pattern_len);
+    memcpy(LastPattern.Data, pattern, (size_t)pattern_len);
+    LastMatches.swap(TempMatches);
+    LastValid = true;
+
+    // Heap sort, popping the worst match to the back leaves the best one first
+    for (int n = count - 1; n > 0; n--)
+    {
+        ImGuiFuzzyMatch tmp = out_matches[0]; out_matches[0] = out_matches[n]; out_matches[n] = tmp;
+        ImFuzzyHeapSiftDown(out_matches, n, 0, Offsets.Data);
+    }
+    return count;
+}
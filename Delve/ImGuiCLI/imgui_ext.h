@@ -9,4 +9,79 @@ namespace ImGui
 
     IMGUI_API bool BitField(const char* label, unsigned* bits, unsigned* hoverIndex = 0x0);
     IMGUI_API bool DragFloatN_Colored(const char* label, float* v, int components, float v_speed = 1.0f, float v_min = 0.0f, float v_max = 0.0f, const char* display_format = "%.3f", float power = 1.0f);
-}
\ No newline at end of file
+}
+
+// Fixed capacity ring buffer of samples with a min/max pyramid over it, for plotting very long histories (frame times, etc).
+// Appending is O(log capacity), plotting costs one range query per pixel column instead of a pass over every sample.
+struct ImGuiPlotStream
+{
+    ImVector<float> Min;        // pyramid nodes, 1 is the root, leaves at [LeafCount, LeafCount + Capacity) hold the samples
+    ImVector<float> Max;
+    int             LeafCount;  // capacity rounded up to a power of two
+    int             Capacity;
+    int             Count;
+    int             Head;       // slot that receives the next sample
+
+    IMGUI_API ImGuiPlotStream(int capacity = 0);
+    IMGUI_API void  SetCapacity(int capacity);                          // also clears
+    IMGUI_API void  Clear();
+    IMGUI_API void  Append(float v);
+    IMGUI_API void  Append(const float* values, int values_count);
+    IMGUI_API float Get(int idx) const;                                 // 0 is the oldest sample
+    IMGUI_API void  GetMinMax(int idx_begin, int idx_end, float* out_min, float* out_max) const;   // over [idx_begin, idx_end)
+    float           GetMin() const { return Count > 0 ? Min[1] : 0.0f; }
+    float           GetMax() const { return Count > 0 ? Max[1] : 0.0f; }
+
+private:
+    void            UpdateSlot(int slot);
+    void            RebuildNodes();
+    void            QuerySlots(int slot_begin, int slot_end, float* io_min, float* io_max) const;
+};
+
+namespace ImGui
+{
+    // Plot a stream as per-pixel min/max envelopes. Autoscaling (FLT_MAX) reads the pyramid root and never walks the samples.
+    IMGUI_API void PlotStreamLines(const char* label, const ImGuiPlotStream* stream, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0));
+    IMGUI_API void PlotStreamHistogram(const char* label, const ImGuiPlotStream* stream, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0));
+}
+
+// UTF-8 strings packed back to back, encoded once and then filtered as many times as needed with ImGuiTextFilter::PassFilterMany()
+struct ImGuiTextList
+{
+    ImVector<char>  Buf;
+    ImVector<int>   Offsets;    // String n is [Buf.Data + Offsets[n], Buf.Data + Offsets[n + 1])
+
+    ImGuiTextList()                 { Offsets.push_back(0); }
+    int             Size() const    { return Offsets.Size - 1; }
+    void            Clear()         { Buf.resize(0); Offsets.resize(1); }
+    IMGUI_API int   Add(const char* text, const char* text_end = NULL);    // Returns the index of the string
+    IMGUI_API int   Filter(const ImGuiTextFilter& filter, ImVector<int>* out_indices, void (*jobs_runner)(int, void (*)(int, void*), void*, void*) = NULL, void* jobs_runner_user_data = NULL) const;
+};
+
+// Fuzzy (subsequence) search over a fixed set of candidates, for command palettes and asset pickers.
+// Candidates are lower-cased once on Add() along with a per-byte word start bonus and a mask of the characters they contain,
+// so most candidates are rejected on the mask alone. Search() keeps the best max_matches with a heap instead of sorting everything.
+struct ImGuiFuzzyMatch
+{
+    int             Index;
+    int             Score;
+};
+
+struct ImGuiFuzzyIndex
+{
+    ImVector<char>          Lower;          // Candidate n is [Lower.Data + Offsets[n], Lower.Data + Offsets[n + 1]), ASCII lower-cased
+    ImVector<unsigned char> Bonus;          // Score bonus of a match at each byte of Lower (path segment, word or camel case start)
+    ImVector<int>           Offsets;
+    ImVector<ImU64>         Masks;          // Characters present in each candidate
+    ImVector<char>          LastPattern;    // Search() cache: every candidate matching LastPattern, only those can match a pattern extending it
+    ImVector<int>           LastMatches;
+    ImVector<int>           TempMatches;
+    bool                    LastValid;
+
+    ImGuiFuzzyIndex()               { Offsets.push_back(0); LastValid = false; }
+    int             Size() const    { return Offsets.Size - 1; }
+    IMGUI_API void  Clear();
+    IMGUI_API int   Add(const char* text, const char* text_end = NULL);    // Returns the index of the candidate
+    // Fill out_matches with the best candidates for pattern (spaces ignored), best first, and return how many. An empty pattern returns the first candidates with a score of 0.
+    IMGUI_API int   Search(const char* pattern, ImGuiFuzzyMatch* out_matches, int max_matches);
+};
\ No newline at end of file
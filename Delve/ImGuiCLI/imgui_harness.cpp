@@ -0,0 +1,3173 @@
+#include "imgui_harness.h"
+#include "imgui_internal.h"
+#include "imgui_dock.h"
+#include "imgui_tabs.h"
+#include "imgui_tabs_internal.h"
+#include "imgui_ext.h"
+#include "TextEditor.h"
+#include "ImGuizmo.h"
+#include "ImGuizmo_internal.h"
+#ifdef _MSC_VER
+#include "ImSequencer.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <atomic>
+#include <thread>
+
+//-----------------------------------------------------------------------------
+// ImGuiHarness
+//-----------------------------------------------------------------------------
+
+ImGuiHarness::ImGuiHarness(const ImVec2& display_size)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    Context = ImGui::CreateContext();
+    RunCount = 0;
+    CheckFailures = 0;
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = display_size;
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    for (int n = 0; n < ImGuiKey_COUNT; n++)
+        io.KeyMap[n] = n;
+
+    // Default font only, the pixels are never uploaded anywhere
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    io.Fonts->TexID = (ImTextureID)(intptr_t)1;
+    io.Fonts->ClearTexData();
+
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+}
+
+ImGuiHarness::~ImGuiHarness()
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGui::DestroyContext(Context);
+    if (backup_context != Context)
+        ImGui::SetCurrentContext(backup_context);
+}
+
+void ImGuiHarness::RecordInput(const ImGuiIO& io)
+{
+    ImGuiHarnessInput input = ImGuiHarnessInput();
+    input.MousePos = io.MousePos;
+    for (int n = 0; n < IM_ARRAYSIZE(io.MouseDown); n++)
+        if (io.MouseDown[n])
+            input.MouseButtons |= 1 << n;
+    input.MouseWheel = io.MouseWheel;
+    input.KeyCtrl = io.KeyCtrl;
+    input.KeyShift = io.KeyShift;
+    input.KeyAlt = io.KeyAlt;
+
+    int keys_count = 0;
+    for (int n = 0; n < IM_ARRAYSIZE(io.KeysDown) && keys_count < IM_ARRAYSIZE(input.KeysDown) - 1; n++)
+        if (io.KeysDown[n])
+            input.KeysDown[keys_count++] = (short)n;
+    input.KeysDown[keys_count] = -1;
+
+    int text_count = 0;
+    for (int n = 0; io.InputCharacters[n] != 0 && text_count < IM_ARRAYSIZE(input.Text) - 1; n++)
+        input.Text[text_count++] = io.InputCharacters[n];
+    input.Text[text_count] = 0;
+
+    Input.push_back(input);
+}
+
+// One frame per line: "mouse_x mouse_y buttons wheel ctrl shift alt keys text"
+// keys and text are comma separated lists (key indices, hexadecimal code points) or '-' when empty.
+bool ImGuiHarness::SaveInput(const char* filename) const
+{
+    FILE* f = ImFileOpen(filename, "wt");
+    if (!f)
+        return false;
+    fprintf(f, "# mouse_x mouse_y buttons wheel ctrl shift alt keys text\n");
+    for (int i = 0; i < Input.Size; i++)
+    {
+        const ImGuiHarnessInput& input = Input[i];
+        fprintf(f, "%.1f %.1f %d %.2f %d %d %d ", input.MousePos.x, input.MousePos.y, input.MouseButtons, input.MouseWheel, input.KeyCtrl, input.KeyShift, input.KeyAlt);
+        if (input.KeysDown[0] < 0)
+            fputc('-', f);
+        for (int n = 0; input.KeysDown[n] >= 0; n++)
+            fprintf(f, n > 0 ? ",%d" : "%d", input.KeysDown[n]);
+        fputc(' ', f);
+        if (input.Text[0] == 0)
+            fputc('-', f);
+        for (int n = 0; input.Text[n] != 0; n++)
+            fprintf(f, n > 0 ? ",%x" : "%x", (unsigned)input.Text[n]);
+        fputc('\n', f);
+    }
+    fclose(f);
+    return true;
+}
+
+bool ImGuiHarness::LoadInput(const char* filename)
+{
+    int file_size;
+    char* file_data = (char*)ImFileLoadToMemory(filename, "rb", &file_size, 1);
+    if (!file_data)
+        return false;
+
+    Input.resize(0);
+    for (char* line = file_data; line < file_data + file_size; )
+    {
+        char* line_end = line;
+        while (line_end < file_data + file_size && *line_end != '\n' && *line_end != '\r')
+            line_end++;
+        *line_end = 0;
+
+        ImGuiHarnessInput input = ImGuiHarnessInput();
+        int ctrl, shift, alt, consumed = 0;
+        if (line[0] != '#' && sscanf(line, "%f %f %d %f %d %d %d %n", &input.MousePos.x, &input.MousePos.y, &input.MouseButtons, &input.MouseWheel, &ctrl, &shift, &alt, &consumed) == 7)
+        {
+            input.KeyCtrl = ctrl != 0;
+            input.KeyShift = shift != 0;
+            input.KeyAlt = alt != 0;
+
+            const char* p = line + consumed;
+            int keys_count = 0;
+            for (int key; *p != '-' && keys_count < IM_ARRAYSIZE(input.KeysDown) - 1 && sscanf(p, "%d", &key) == 1; )
+            {
+                input.KeysDown[keys_count++] = (short)key;
+                while (*p && *p != ',' && *p != ' ') p++;
+                if (*p == ',') p++; else break;
+            }
+            input.KeysDown[keys_count] = -1;
+
+            while (*p && *p != ' ') p++;
+            while (*p == ' ') p++;
+            int text_count = 0;
+            for (unsigned c; *p != '-' && text_count < IM_ARRAYSIZE(input.Text) - 1 && sscanf(p, "%x", &c) == 1; )
+            {
+                input.Text[text_count++] = (ImWchar)c;
+                while (*p && *p != ',') p++;
+                if (*p == ',') p++; else break;
+            }
+            input.Text[text_count] = 0;
+            Input.push_back(input);
+        }
+        line = line_end + 1;
+    }
+    ImGui::MemFree(file_data);
+    return true;
+}
+
+bool ImGuiHarness::Check(const char* what, bool passed)
+{
+    if (!passed)
+    {
+        fprintf(stderr, "check failed: %s\n", what);
+        CheckFailures++;
+    }
+    return passed;
+}
+
+static void HarnessApplyInput(ImGuiIO& io, const ImGuiHarnessInput& input)
+{
+    io.MousePos = input.MousePos;
+    for (int n = 0; n < IM_ARRAYSIZE(io.MouseDown); n++)
+        io.MouseDown[n] = (input.MouseButtons & (1 << n)) != 0;
+    io.MouseWheel = input.MouseWheel;
+    io.KeyCtrl = input.KeyCtrl;
+    io.KeyShift = input.KeyShift;
+    io.KeyAlt = input.KeyAlt;
+    memset(io.KeysDown, 0, sizeof(io.KeysDown));
+    for (int n = 0; input.KeysDown[n] >= 0 && n < IM_ARRAYSIZE(input.KeysDown); n++)
+        io.KeysDown[input.KeysDown[n]] = true;
+    for (int n = 0; input.Text[n] != 0 && n < IM_ARRAYSIZE(input.Text); n++)
+        io.AddInputCharacter(input.Text[n]);
+}
+
+static void HarnessSumLayoutCacheStats(const ImFontAtlas* atlas, int* hits, int* misses)
+{
+    for (int n = 0; n < atlas->Fonts.Size; n++)
+        if (const ImFontLayoutCache* cache = atlas->Fonts[n]->LayoutCache)
+        {
+            *hits += cache->Hits;
+            *misses += cache->Misses;
+        }
+}
+
+void ImGuiHarness::Run(const char* name, ImGuiHarnessSceneFn scene, void* user_data, int frame_count)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(Context);
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    if (frame_count <= 0)
+        frame_count = ImMax(Input.Size, 1);
+
+    int layout_hits = 0, layout_misses = 0;
+    HarnessSumLayoutCacheStats(io.Fonts, &layout_hits, &layout_misses);
+    const int upload_recreations = UploadRing.Recreations;
+
+    Frames.resize(0);
+    for (int frame = 0; frame < frame_count; frame++)
+    {
+        if (Input.Size > 0)
+            HarnessApplyInput(io, Input[frame % Input.Size]);
+
+        const std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        ImGui::NewFrame();
+        if (frame > 0)
+            Frames.back().Allocations = io.MetricsAllocations;
+        scene(user_data);
+        ImGui::Render();
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        size_t idx_offset;
+        const ImGuiUploadPlan plan = UploadRing.Plan(ImGui::CalcDrawDataUploadSize(draw_data, &idx_offset));
+        if (plan.Recreate)
+            UploadBuffer.resize((int)plan.BufferSize);
+        const bool rebase_indices = ImGui::CanRebaseDrawDataIndices(draw_data);
+        ImGui::PackDrawData(draw_data, UploadBuffer.Data + plan.Offset, idx_offset, rebase_indices);
+        const int draw_calls_saved = ImGui::BuildDrawBatches(draw_data, rebase_indices, &DrawBatches);
+        const std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+        ImGuiHarnessFrameStats stats;
+        stats.CpuMs = (float)std::chrono::duration<double, std::milli>(t1 - t0).count();
+        stats.Vertices = io.MetricsRenderVertices;
+        stats.Indices = io.MetricsRenderIndices;
+        stats.Allocations = 0;
+        stats.DrawCalls = DrawBatches.Size;
+        stats.DrawCallsSaved = draw_calls_saved;
+        Frames.push_back(stats);
+    }
+
+    // Allocation counters are published by NewFrame(), close the last frame to read them
+    ImGui::NewFrame();
+    Frames.back().Allocations = io.MetricsAllocations;
+    ImGui::EndFrame();
+
+    float cpu_total = 0.0f, cpu_max = 0.0f;
+    int allocations_total = 0, draw_calls_total = 0, draw_calls_saved_total = 0;
+    for (int n = 0; n < Frames.Size; n++)
+    {
+        cpu_total += Frames[n].CpuMs;
+        cpu_max = ImMax(cpu_max, Frames[n].CpuMs);
+        allocations_total += Frames[n].Allocations;
+        draw_calls_total += Frames[n].DrawCalls;
+        draw_calls_saved_total += Frames[n].DrawCallsSaved;
+    }
+
+    int layout_hits_end = 0, layout_misses_end = 0;
+    HarnessSumLayoutCacheStats(io.Fonts, &layout_hits_end, &layout_misses_end);
+
+    Report.appendf("%s{\"name\":\"%s\",\"frames\":%d,\"cpu_ms_avg\":%.4f,\"cpu_ms_max\":%.4f,\"allocations\":%d,\"layout_cache_hits\":%d,\"layout_cache_misses\":%d,\"upload_buffer_recreations\":%d,\"draw_calls\":%d,\"draw_calls_saved\":%d,\"per_frame\":[",
+        RunCount > 0 ? ",\n" : "", name, Frames.Size, cpu_total / Frames.Size, cpu_max, allocations_total, layout_hits_end - layout_hits, layout_misses_end - layout_misses, UploadRing.Recreations - upload_recreations, draw_calls_total, draw_calls_saved_total);
+    for (int n = 0; n < Frames.Size; n++)
+        Report.appendf("%s[%.4f,%d,%d,%d,%d,%d]", n > 0 ? "," : "", Frames[n].CpuMs, Frames[n].Vertices, Frames[n].Indices, Frames[n].Allocations, Frames[n].DrawCalls, Frames[n].DrawCallsSaved);
+    Report.appendf("]}");
+    RunCount++;
+
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+}
+
+static double HarnessElapsedMs(const std::chrono::high_resolution_clock::time_point& t0)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+void ImGuiHarness::RunProfiler(const char* name, ImGuiHarnessSceneFn scene, void* user_data, int frame_count, ImGuiTextBuffer* trace)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(Context);
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    if (frame_count <= 0)
+        frame_count = ImMax(Input.Size, 1);
+
+    // A profiler frame goes from one NewFrame() to the next, it is published by the second one. The phases every frame goes through must be timed,
+    // the scopes closed by the end of the frame, and the inclusive times of the top-level phases (nested ones are counted in them) fit in the frame.
+    trace->appendf("%s{\"name\":\"%s\",\"frames\":[", trace->empty() ? "" : ",\n", name);
+    static const int every_frame_phases[] = { ImGuiProfilePhase_NewFrame, ImGuiProfilePhase_Begin, ImGuiProfilePhase_End, ImGuiProfilePhase_Render };
+    int calls[ImGuiProfilePhase_COUNT] = {};
+    bool timed = true, closed = true, nested = true;
+    std::chrono::high_resolution_clock::time_point frame_start;
+    for (int frame = 0; frame <= frame_count; frame++)
+    {
+        if (Input.Size > 0)
+            HarnessApplyInput(io, Input[frame % Input.Size]);
+        const std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        ImGui::NewFrame();
+        if (frame > 0)
+        {
+            const float frame_ms = (float)std::chrono::duration<double, std::milli>(t0 - frame_start).count();
+            if (frame > 1)
+                trace->append(",");
+            ImGui::ProfilerAppendFrameJson(trace);
+            ImGuiProfilerPhase phases[ImGuiProfilePhase_COUNT];
+            for (int n = 0; n < ImGuiProfilePhase_COUNT; n++)
+            {
+                ImGui::GetProfilerPhase(n, &phases[n]);
+                calls[n] += phases[n].Calls;
+                nested &= phases[n].TimeMs <= frame_ms;
+            }
+            for (int n = 0; n < IM_ARRAYSIZE(every_frame_phases); n++)
+                timed &= phases[every_frame_phases[n]].Calls > 0 && phases[every_frame_phases[n]].TimeMs > 0.0f;
+            nested &= phases[ImGuiProfilePhase_NewFrame].TimeMs + phases[ImGuiProfilePhase_Begin].TimeMs + phases[ImGuiProfilePhase_End].TimeMs + phases[ImGuiProfilePhase_Render].TimeMs <= frame_ms;
+        }
+        frame_start = t0;
+        if (frame == frame_count)
+            break;
+        scene(user_data);
+        ImGui::Render();
+        for (int n = 0; n < ImGuiProfilePhase_COUNT; n++)
+            closed &= GImGui->Profiler.Phases[n].Depth == 0;
+    }
+    ImGui::EndFrame();
+    trace->append("]}");
+
+    char what[128];
+    ImFormatString(what, IM_ARRAYSIZE(what), "profiler: %s times NewFrame, Begin, End and Render every frame", name);
+    bool passed = Check(what, timed);
+    ImFormatString(what, IM_ARRAYSIZE(what), "profiler: %s times text layout and tessellation", name);
+    passed &= Check(what, calls[ImGuiProfilePhase_TextLayout] > 0 && calls[ImGuiProfilePhase_Tessellation] > 0);
+    ImFormatString(what, IM_ARRAYSIZE(what), "profiler: %s closes every scope by the end of the frame", name);
+    passed &= Check(what, closed);
+    ImFormatString(what, IM_ARRAYSIZE(what), "profiler: %s phases fit in their frame", name);
+    passed &= Check(what, nested);
+
+    Report.appendf("%s{\"name\":\"profiler_%s\",\"frames\":%d,\"passed\":%s}", RunCount > 0 ? ",\n" : "", name, frame_count, passed ? "true" : "false");
+    RunCount++;
+
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+}
+
+// Byte comparison, for vectors of plain values
+template<typename T>
+static bool HarnessSameVector(const ImVector<T>& a, const ImVector<T>& b)
+{
+    return a.Size == b.Size && (a.Size == 0 || memcmp(a.Data, b.Data, (size_t)a.Size * sizeof(T)) == 0);
+}
+
+// Private context sharing the fonts of the main one, made current. ImGui::CreateContext() only does that when there is no current context.
+static ImGuiContext* HarnessCreateContext(ImGuiContext* main_context)
+{
+    ImGuiContext* ctx = ImGui::CreateContext(main_context->IO.Fonts);
+    ImGui::SetCurrentContext(ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = main_context->IO.DisplaySize;
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DeltaTime = 1.0f / 60.0f;
+    return ctx;
+}
+
+void ImGuiHarness::RunInputRoundTrip(int frame_count)
+{
+    ImVector<ImGuiHarnessInput> input;
+    unsigned int seed = 12345;
+    for (int n = 0; n < frame_count; n++)
+    {
+        ImGuiHarnessInput frame = ImGuiHarnessInput();
+        seed = seed * 1664525u + 1013904223u;
+        frame.MousePos = ImVec2((float)(seed % 1280) + 0.5f, (float)((seed >> 8) % 720));
+        frame.MouseButtons = (int)(seed >> 20) & 7;
+        frame.MouseWheel = (float)((int)(seed >> 24) % 5 - 2) * 0.25f;
+        frame.KeyCtrl = (seed & (1 << 3)) != 0;
+        frame.KeyShift = (seed & (1 << 4)) != 0;
+        frame.KeyAlt = (seed & (1 << 5)) != 0;
+        const int keys_count = (int)(seed >> 6) % IM_ARRAYSIZE(frame.KeysDown);
+        for (int k = 0; k < keys_count; k++)
+            frame.KeysDown[k] = (short)((seed >> k) % 512);
+        frame.KeysDown[keys_count] = -1;
+        const int text_count = (int)(seed >> 9) % IM_ARRAYSIZE(frame.Text);
+        for (int c = 0; c < text_count; c++)
+            frame.Text[c] = (ImWchar)(0x20 + (seed >> c) % 0x4E00);
+        frame.Text[text_count] = 0;
+        input.push_back(frame);
+    }
+
+    const char* filename = "imgui_harness_input.txt";
+    ImVector<ImGuiHarnessInput> backup_input;
+    backup_input.swap(Input);
+    Input.swap(input);
+    const bool saved = SaveInput(filename);
+    Input.swap(input);
+    const bool loaded = LoadInput(filename);
+    remove(filename);
+
+    bool same = saved && loaded && Input.Size == input.Size;
+    for (int n = 0; same && n < Input.Size; n++)
+    {
+        const ImGuiHarnessInput& a = Input[n];
+        const ImGuiHarnessInput& b = input[n];
+        same = a.MousePos.x == b.MousePos.x && a.MousePos.y == b.MousePos.y && a.MouseButtons == b.MouseButtons && a.MouseWheel == b.MouseWheel &&
+            a.KeyCtrl == b.KeyCtrl && a.KeyShift == b.KeyShift && a.KeyAlt == b.KeyAlt;
+        for (int k = 0; same && (k == 0 || a.KeysDown[k - 1] >= 0); k++)
+            same = a.KeysDown[k] == b.KeysDown[k];
+        for (int c = 0; same && (c == 0 || a.Text[c - 1] != 0); c++)
+            same = a.Text[c] == b.Text[c];
+    }
+    Input.swap(backup_input);
+    Check("input_round_trip: LoadInput() reads back the saved frames", same);
+
+    Report.appendf("%s{\"name\":\"input_round_trip\",\"frames\":%d,\"passed\":%s}", RunCount > 0 ? ",\n" : "", frame_count, same ? "true" : "false");
+    RunCount++;
+}
+
+// Windows "Window 0", "Window 97", ... and "Added 0", "Added 1", ... which aren't in the loaded .ini, the first one moves every frame
+static void HarnessIniSettingsFrame(int frame, int window_count, int added_count = 0)
+{
+    ImGui::NewFrame();
+    for (int n = 0; n < window_count + added_count; n++)
+    {
+        char name[32];
+        if (n < window_count)
+            ImFormatString(name, IM_ARRAYSIZE(name), "Window %d", n * 97);
+        else
+            ImFormatString(name, IM_ARRAYSIZE(name), "Added %d", n - window_count);
+        ImGui::Begin(name);
+        if (n == 0)
+            ImGui::SetWindowPos(ImVec2(40.0f + frame, 40.0f));
+        ImGui::End();
+    }
+    ImGui::Render();
+}
+
+// Saves with the entries cached from the previous save, then again with every entry formatted from scratch
+static bool HarnessIniSaveMatchesFullRewrite()
+{
+    ImGuiContext& g = *GImGui;
+    size_t size = 0;
+    const char* ini = ImGui::SaveIniSettingsToMemory(&size);
+    ImVector<char> incremental;
+    incremental.resize((int)size);
+    memcpy(incremental.Data, ini, size);
+    for (int n = 0; n < g.SettingsWindows.Size; n++)
+        g.SettingsWindows[n].IniOffset = -1;
+    ini = ImGui::SaveIniSettingsToMemory(&size);
+    return size == (size_t)incremental.Size && memcmp(ini, incremental.Data, size) == 0;
+}
+
+void ImGuiHarness::RunIniSettings(int entry_count)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = HarnessCreateContext(Context);
+
+    ImGuiTextBuffer ini;
+    for (int n = 0; n < entry_count; n++)
+        ini.appendf("[Window][Window %d]\nPos=%d,%d\nSize=%d,%d\nCollapsed=%d\n\n", n, 60 + n % 700, 60 + n % 400, 200 + n % 300, 100 + n % 200, (n % 5) == 0);
+
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    ImGui::LoadIniSettingsFromMemory(ini.c_str());
+    const double load_ms = HarnessElapsedMs(t0);
+
+    // Some live windows among the loaded entries, as in an application that opened a few of them this session
+    const int window_count = ImMin(entry_count / 97, 20);
+    HarnessIniSettingsFrame(0, window_count);
+    size_t ini_size = 0;
+    t0 = std::chrono::high_resolution_clock::now();
+    ImGui::SaveIniSettingsToMemory(&ini_size);
+    const double save_full_ms = HarnessElapsedMs(t0);
+    t0 = std::chrono::high_resolution_clock::now();
+    ImGui::SaveIniSettingsToMemory();
+    const double save_unchanged_ms = HarnessElapsedMs(t0);
+    HarnessIniSettingsFrame(1, window_count);
+    t0 = std::chrono::high_resolution_clock::now();
+    ImGui::SaveIniSettingsToMemory();
+    const double save_moved_ms = HarnessElapsedMs(t0);
+
+    // Incremental saves against full rewrites, after windows got moved, added, stopped being submitted, and after another .ini got loaded over the entries
+    HarnessIniSettingsFrame(2, window_count);
+    bool same = Check("ini_settings: incremental save after a move matches a full rewrite", HarnessIniSaveMatchesFullRewrite());
+    HarnessIniSettingsFrame(3, window_count, 3);
+    same &= Check("ini_settings: incremental save with added windows matches a full rewrite", HarnessIniSaveMatchesFullRewrite());
+    HarnessIniSettingsFrame(4, window_count / 2, 1);
+    same &= Check("ini_settings: incremental save with removed windows matches a full rewrite", HarnessIniSaveMatchesFullRewrite());
+    same &= Check("ini_settings: unchanged incremental save matches a full rewrite", HarnessIniSaveMatchesFullRewrite());
+    ImGuiTextBuffer reload;
+    for (int n = 0; n < entry_count; n += 3)
+        reload.appendf("[Window][Window %d]\nPos=%d,%d\nCollapsed=%d\n\n", n, 10 + n % 300, 20 + n % 200, (n % 2) == 0);
+    reload.appendf("[Window][Loaded later]\nPos=5,5\nSize=320,240\n\n");
+    ImGui::LoadIniSettingsFromMemory(reload.c_str());
+    same &= Check("ini_settings: incremental save after LoadIniSettingsFromMemory() matches a full rewrite", HarnessIniSaveMatchesFullRewrite());
+    HarnessIniSettingsFrame(5, window_count, 3);
+    same &= Check("ini_settings: incremental save after loading and moving matches a full rewrite", HarnessIniSaveMatchesFullRewrite());
+
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Report.appendf("%s{\"name\":\"ini_settings\",\"entries\":%d,\"ini_bytes\":%d,\"load_ms\":%.4f,\"save_full_ms\":%.4f,\"save_unchanged_ms\":%.4f,\"save_one_moved_ms\":%.4f,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", entry_count, (int)ini_size, load_ms, save_full_ms, save_unchanged_ms, save_moved_ms, same ? "true" : "false");
+    RunCount++;
+}
+
+ImGuiHarnessInputText::ImGuiHarnessInputText(int text_size)
+{
+    static const char* levels[] = { "INFO", "WARN", "ERROR", "DEBUG" };
+    static const char* subsystems[] = { "render", "physics", "audio", "scene", "assets" };
+    ImGuiTextBuffer text;
+    for (int line = 0; text.size() < text_size; line++)
+        text.appendf("[%07d] %-5s %-8s frame %d: processed %d items in %.3f ms\n", line, levels[line % IM_ARRAYSIZE(levels)], subsystems[(line / 3) % IM_ARRAYSIZE(subsystems)], line / 40, (line * 7919) % 1000, (line % 97) * 0.125f);
+    Buf.resize(text.size() + 4096);
+    memcpy(Buf.Data, text.begin(), (size_t)text.size() + 1);
+    Activate = false;
+    ScrollY = 0.0f;
+}
+
+static double HarnessInputTextFrame(ImGuiHarnessInputText* input, ImGuiInputTextFlags flags)
+{
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Text", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+    if (input->Activate && !ImGui::IsAnyItemActive())
+        ImGui::SetKeyboardFocusHere();
+    ImGui::InputTextMultiline("##text", input->Buf.Data, (size_t)input->Buf.Size, ImVec2(-1.0f, -1.0f), flags);
+    ImGui::End();
+    ImGui::Render();
+    return HarnessElapsedMs(t0);
+}
+
+// Time of the frame in which the widget gets activated, the frame focus is requested in doesn't activate it yet
+static double HarnessInputTextActivate(ImGuiHarnessInputText* input, ImGuiInputTextFlags flags)
+{
+    ImGui::ClearActiveID();
+    input->Activate = false;
+    HarnessInputTextFrame(input, flags);
+    input->Activate = true;
+    double ms = 0.0;
+    for (int n = 0; n < 3 && !ImGui::IsAnyItemActive(); n++)
+        ms = HarnessInputTextFrame(input, flags);
+    return ms;
+}
+
+// Text and line starts of the active InputText against converting buf and indexing it again, the byte line starts are those of buf_display which
+// an editable InputText writes its text back to. The text is lossless when converting it back gives buf, then an editable activation copies buf
+// into TempTextBuffer instead of converting the text back: both have to be the same.
+static bool HarnessInputTextMatchesFullConversion(const char* buf, const char* buf_display)
+{
+    const ImGuiTextEditState& state = GImGui->InputTextState;
+    const int len_a = (int)strlen(buf);
+    ImVector<ImWchar> text;
+    text.resize(len_a + 1);
+    const char* buf_end = NULL;
+    bool lossless = false;
+    const int len_w = ImTextStrFromUtf8(text.Data, text.Size, buf, buf + len_a, &buf_end, &lossless);
+    bool same = state.CurLenW == len_w && state.CurLenA == (int)(buf_end - buf) && memcmp(state.Text.Data, text.Data, (size_t)(len_w + 1) * sizeof(ImWchar)) == 0;
+
+    ImVector<int> line_starts_w, line_starts_a;
+    line_starts_w.push_back(0);
+    line_starts_a.push_back(0);
+    for (int n = 0; n < len_w; n++)
+        if (text[n] == '\n')
+            line_starts_w.push_back(n + 1);
+    for (int n = 0; n < (int)(buf_end - buf); n++)
+        if (buf_display[n] == '\n')
+            line_starts_a.push_back(n + 1);
+    same &= !state.LineStartsDirty && HarnessSameVector(state.LineStartsW, line_starts_w) && HarnessSameVector(state.LineStartsA, line_starts_a);
+
+    ImVector<char> text_a;
+    text_a.resize(len_w * 3 + 1);
+    const int text_a_len = ImTextStrToUtf8(text_a.Data, text_a.Size, text.Data, text.Data + len_w);
+    same &= lossless == (text_a_len == len_a && memcmp(text_a.Data, buf, (size_t)len_a) == 0);
+    if (!state.TempTextBufferDirty)
+        same &= strcmp(state.TempTextBuffer.Data, text_a.Data) == 0;
+    return same;
+}
+
+// Child window holding the text of the InputTextMultiline submitted by HarnessInputTextFrame()
+static ImGuiWindow* HarnessInputTextChild()
+{
+    ImGuiWindow* window = ImGui::FindWindowByName("Text");
+    if (!window)
+        return NULL;
+    char child_name[64];
+    ImFormatString(child_name, IM_ARRAYSIZE(child_name), "%s/%08X", window->Name, window->GetIDNoKeepAlive("##text"));
+    return ImGui::FindWindowByName(child_name);
+}
+
+// Vertices of the visible lines the multi-line InputText draws against drawing the whole of buf_display at the same position. RenderText() rounds
+// the position of the first line it draws only: the positions are the same with an integral font size and within a pixel otherwise.
+static bool HarnessInputTextMatchesWholeDraw(const char* buf_display)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* child = HarnessInputTextChild();
+    if (!child)
+        return false;
+    const float font_size = child->CalcFontSize();
+    const float scroll_x = (g.ActiveId != 0 && g.ActiveId == g.InputTextState.Id) ? g.InputTextState.ScrollX : 0.0f;
+    ImDrawList whole(&g.DrawListSharedData);
+    whole.PushTextureID(g.Font->ContainerAtlas->TexID);
+    whole.PushClipRect(child->InnerClipRect.Min, child->InnerClipRect.Max);
+    whole.AddText(g.Font, font_size, ImVec2(child->DC.CursorStartPos.x - scroll_x, child->DC.CursorStartPos.y), ImGui::GetColorU32(ImGuiCol_Text), buf_display);
+    if (whole.VtxBuffer.Size == 0)
+        return false;
+
+    const bool exact = font_size == (float)(int)font_size;
+    const ImVector<ImDrawVert>& vtx = child->DrawList->VtxBuffer;
+    for (int start = 0; start + whole.VtxBuffer.Size <= vtx.Size; start++)
+    {
+        int n = 0;
+        for (; n < whole.VtxBuffer.Size; n++)
+        {
+            const ImDrawVert& a = vtx[start + n];
+            const ImDrawVert& b = whole.VtxBuffer[n];
+            if (a.pos.x != b.pos.x || a.uv.x != b.uv.x || a.uv.y != b.uv.y || a.col != b.col || (exact ? a.pos.y != b.pos.y : fabsf(a.pos.y - b.pos.y) >= 1.0f))
+                break;
+        }
+        if (n == whole.VtxBuffer.Size)
+            return true;
+    }
+    return false;
+}
+
+void ImGuiHarness::RunInputTextActivation(int max_text_size)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = HarnessCreateContext(Context);
+
+    ImGuiTextBuffer sizes;
+    static const int text_sizes[] = { 64 << 10, 1 << 20, 10 << 20 };
+    for (int n = 0; n < IM_ARRAYSIZE(text_sizes) && text_sizes[n] <= max_text_size; n++)
+    {
+        ImGuiHarnessInputText input(text_sizes[n]);
+        const int text_len = (int)strlen(input.Buf.Data);
+        const double activate_ms = HarnessInputTextActivate(&input, 0);
+        const double active_ms = HarnessInputTextFrame(&input, 0);
+
+        // A read-only log view keeps focus while lines get appended to it
+        const double activate_read_only_ms = HarnessInputTextActivate(&input, ImGuiInputTextFlags_ReadOnly);
+        HarnessInputTextFrame(&input, ImGuiInputTextFlags_ReadOnly);
+        ImFormatString(input.Buf.Data + text_len, (size_t)(input.Buf.Size - text_len), "[%07d] INFO  render   appended line\n", n);
+        const double append_read_only_ms = HarnessInputTextFrame(&input, ImGuiInputTextFlags_ReadOnly);
+        ImGui::ClearActiveID();
+
+        sizes.appendf("%s{\"bytes\":%d,\"activate_ms\":%.4f,\"active_ms\":%.4f,\"activate_read_only_ms\":%.4f,\"append_read_only_ms\":%.4f}",
+            n > 0 ? "," : "", text_len, activate_ms, active_ms, activate_read_only_ms, append_read_only_ms);
+    }
+
+    // Read-only updates of a log getting edited: multi-byte characters across the 8 byte ASCII chunks of ImTextStrFromUtf8() and the 256 byte ones of
+    // InputTextFindFirstDifference(), characters completed by the next update, invalid sequences (one eating the new line before the changed line),
+    // characters above 0xFFFF, and bytes which stop the conversion.
+    struct HarnessUtf8Edit { const char* Name; int Offset; const char* Bytes; };   // Offset < 0 appends
+    static const HarnessUtf8Edit edits[] =
+    {
+        { "append ASCII", -1, "[0000042] INFO  render   appended line\n" },
+        { "append across an 8 byte chunk", -1, "abcdefg\xC3\xA9xyz \xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\n" },
+        { "append an incomplete character", -1, "tail \xE2\x82" },
+        { "complete the character", -1, "\xAC done\n" },
+        { "append an incomplete character before a new line", -1, "x\xE2\n" },
+        { "append a line the incomplete character eats the new line of", -1, "cd\n" },
+        { "replace across a 256 byte chunk", 255, "\xE2\x82\xAC" },
+        { "replace with a 2 byte character", 1000, "\xC3\xA9" },
+        { "byte stopping the conversion", 300, "\xFF" },
+        { "byte stopping the conversion replaced", 300, "x" },
+        { "overlong sequence", 400, "\xC0\xAF" },
+        { "character above 0xFFFF", -1, "smile \xF0\x9F\x98\x80 end\n" },
+        { "append after a change in the middle", -1, "more\n" },
+        { "lone continuation byte", 520, "\x80" },
+    };
+    ImGuiHarnessInputText input(2000);
+    bool same = true;
+    HarnessInputTextActivate(&input, ImGuiInputTextFlags_ReadOnly);
+    same &= Check("input_text_activation: read-only activation matches a whole conversion", HarnessInputTextMatchesFullConversion(input.Buf.Data, input.Buf.Data));
+    for (int n = 0; n < IM_ARRAYSIZE(edits); n++)
+    {
+        const int text_len = (int)strlen(input.Buf.Data);
+        const int bytes_len = (int)strlen(edits[n].Bytes);
+        const int offset = edits[n].Offset < 0 ? text_len : edits[n].Offset;
+        IM_ASSERT(offset + bytes_len < input.Buf.Size);
+        memcpy(input.Buf.Data + offset, edits[n].Bytes, (size_t)bytes_len);
+        if (edits[n].Offset < 0)
+            input.Buf[offset + bytes_len] = 0;
+        HarnessInputTextFrame(&input, ImGuiInputTextFlags_ReadOnly);
+        const bool same_edit = HarnessInputTextMatchesFullConversion(input.Buf.Data, input.Buf.Data);
+        if (!same_edit)
+            fprintf(stderr, "input_text_activation: read-only update after \"%s\" differs from a whole conversion\n", edits[n].Name);
+        same &= same_edit;
+    }
+    // Invalid lead byte before the last new line, then truncated text
+    input.Buf[(int)strlen(input.Buf.Data) - 1 - 5] = '\xC3';
+    input.Buf[(int)strlen(input.Buf.Data) - 1] = '\xC3';
+    HarnessInputTextFrame(&input, ImGuiInputTextFlags_ReadOnly);
+    same &= HarnessInputTextMatchesFullConversion(input.Buf.Data, input.Buf.Data);
+    input.Buf[(int)strlen(input.Buf.Data) / 2] = 0;
+    HarnessInputTextFrame(&input, ImGuiInputTextFlags_ReadOnly);
+    same &= HarnessInputTextMatchesFullConversion(input.Buf.Data, input.Buf.Data);
+    Check("input_text_activation: read-only updates match whole conversions", same);
+    // An editable InputText writes its text back to the buffer once active, which replaces invalid sequences: compare with the buffer it got activated on
+    ImVector<char> activated_buf = input.Buf;
+    HarnessInputTextActivate(&input, 0);
+    same &= Check("input_text_activation: editable activation of invalid UTF-8 matches a whole conversion", HarnessInputTextMatchesFullConversion(activated_buf.Data, input.Buf.Data));
+    ImFormatString(input.Buf.Data, (size_t)input.Buf.Size, "caf\xC3\xA9 \xE2\x82\xAC 12\nna\xC3\xAFve\n");
+    HarnessInputTextActivate(&input, 0);
+    same &= Check("input_text_activation: editable activation of valid UTF-8 matches a whole conversion", HarnessInputTextMatchesFullConversion(input.Buf.Data, input.Buf.Data));
+    ImGui::ClearActiveID();
+
+    // Visible lines against drawing the whole text, with a fractional frame padding and scroll: inactive read-only, active read-only, and editable after
+    // typing (with the line starts updated by the edit against indexing the text again), with an integral font size then one that isn't
+    ImGuiHarnessInputText view(64 << 10);
+    static const float scroll_ys[] = { 0.0f, 1000.5f, 20000.25f };
+    static const float font_scales[] = { 1.0f, 1.15f };
+    ImGui::GetStyle().FramePadding.y = 3.5f;
+    bool same_draw = true;
+    for (int scale_n = 0; scale_n < IM_ARRAYSIZE(font_scales); scale_n++)
+    {
+        ImGui::GetIO().FontGlobalScale = font_scales[scale_n];
+        for (int active = 0; active < 3; active++)
+        {
+            const ImGuiInputTextFlags flags = (active == 2) ? 0 : ImGuiInputTextFlags_ReadOnly;
+            if (active)
+                HarnessInputTextActivate(&view, flags);
+            for (int scroll_n = 0; scroll_n < IM_ARRAYSIZE(scroll_ys); scroll_n++)
+            {
+                HarnessInputTextFrame(&view, flags);
+                ImGuiWindow* child = HarnessInputTextChild();
+                if (!child)
+                    break;
+                child->ScrollTarget.y = scroll_ys[scroll_n];
+                child->ScrollTargetCenterRatio.y = 0.0f;
+                HarnessInputTextFrame(&view, flags);
+                const bool same_view = HarnessInputTextMatchesWholeDraw(view.Buf.Data);
+                if (!same_view)
+                    fprintf(stderr, "input_text_activation: visible lines differ from the whole text drawn (%s, font scale %.2f, scroll %.2f)\n",
+                        active == 0 ? "inactive" : active == 1 ? "read-only" : "editable", font_scales[scale_n], scroll_ys[scroll_n]);
+                same_draw &= same_view;
+            }
+            if (active == 2)
+            {
+                static const ImWchar typed[] = { 'x', '\n', 0xE9, '\n', '\n', 'y' };
+                for (int n = 0; n < IM_ARRAYSIZE(typed); n++)
+                    ImGui::GetIO().AddInputCharacter(typed[n]);
+                HarnessInputTextFrame(&view, flags);
+                same &= Check("input_text_activation: line starts after typing match indexing the text again", HarnessInputTextMatchesFullConversion(view.Buf.Data, view.Buf.Data));
+                // The frame typing scrolls to the cursor after the child window got positioned, draw the next one
+                HarnessInputTextFrame(&view, flags);
+                same_draw &= HarnessInputTextMatchesWholeDraw(view.Buf.Data);
+            }
+            ImGui::ClearActiveID();
+        }
+    }
+    same &= Check("input_text_activation: visible lines match drawing the whole text", same_draw);
+
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Report.appendf("%s{\"name\":\"input_text_activation\",\"sizes\":[%s],\"passed\":%s}", RunCount > 0 ? ",\n" : "", sizes.c_str(), same ? "true" : "false");
+    RunCount++;
+}
+
+struct HarnessPayloadStep
+{
+    int         Size;
+    int         Seed;               // Bytes are Seed, Seed + 1, ...
+    ImGuiCond   Cond;
+    bool        Copied;             // Expected to bump DataVersion
+};
+
+void ImGuiHarness::RunDragDropPayload()
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = HarnessCreateContext(Context);
+    ImGuiIO& io = ImGui::GetIO();
+
+    // DragDropPayloadBufLocal holds up to 8 bytes
+    static const HarnessPayloadStep steps[] =
+    {
+        { 4,  'a', ImGuiCond_Always, true },
+        { 4,  'a', ImGuiCond_Always, false },    // Same bytes
+        { 4,  'b', ImGuiCond_Always, true },
+        { 3,  'b', ImGuiCond_Always, true },     // Shorter
+        { 8,  'b', ImGuiCond_Always, true },
+        { 8,  'b', ImGuiCond_Always, false },
+        { 40, 'c', ImGuiCond_Always, true },     // To the heap
+        { 40, 'c', ImGuiCond_Always, false },
+        { 40, 'd', ImGuiCond_Always, true },
+        { 41, 'd', ImGuiCond_Always, true },
+        { 41, 'e', ImGuiCond_Once,   false },    // Once only copies the first submission
+        { 5,  'f', ImGuiCond_Always, true },     // Back to the local buffer
+        { 0,  0,   ImGuiCond_Always, true },
+        { 0,  0,   ImGuiCond_Always, false },
+        { 6,  'g', ImGuiCond_Always, true },
+    };
+    unsigned char data[64];
+    unsigned char expected[64];
+    int expected_size = 0;
+    ImVec2 button_center;
+    int step_n = -1;
+    bool passed = true;
+    for (int frame = 0; frame < 4 + IM_ARRAYSIZE(steps) && step_n + 1 < IM_ARRAYSIZE(steps); frame++)
+    {
+        // Press on the button on the second frame, drag past the threshold on the third
+        io.MouseDown[0] = frame >= 1;
+        io.MousePos = frame >= 2 ? ImVec2(button_center.x + 20.0f + frame, button_center.y + 10.0f) : button_center;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImVec2(200, 200));
+        ImGui::Begin("Drag source", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoMove);
+        ImGui::Button("Drag me", ImVec2(100, 40));
+        button_center = ImVec2((ImGui::GetItemRectMin().x + ImGui::GetItemRectMax().x) * 0.5f, (ImGui::GetItemRectMin().y + ImGui::GetItemRectMax().y) * 0.5f);
+        if (ImGui::BeginDragDropSource())
+        {
+            const HarnessPayloadStep& step = steps[++step_n];
+            for (int n = 0; n < step.Size; n++)
+                data[n] = (unsigned char)(step.Seed + n);
+            const ImGuiPayload& payload = ctx->DragDropPayload;
+            const unsigned int version = step_n > 0 ? payload.DataVersion : 0;
+            const void* prev_data = payload.Data;
+            ImGui::SetDragDropPayload("HARNESS", step.Size > 0 ? data : NULL, (size_t)step.Size, step.Cond);
+            if (step.Copied)
+            {
+                memcpy(expected, data, (size_t)step.Size);
+                expected_size = step.Size;
+            }
+            const bool copied = step_n == 0 || payload.DataVersion != version;
+            const bool same_data = payload.DataSize == expected_size && (expected_size == 0 ? payload.Data == NULL : memcmp(payload.Data, expected, (size_t)expected_size) == 0);
+            const bool right_buffer = expected_size == 0 || (expected_size > 8) == (payload.Data != ctx->DragDropPayloadBufLocal);
+            if (copied != step.Copied || !same_data || !right_buffer || (!step.Copied && payload.Data != prev_data))
+            {
+                fprintf(stderr, "drag_drop_payload: step %d %s, data %s, buffer %s\n", step_n, copied ? "copied" : "kept", same_data ? "right" : "wrong", right_buffer ? "right" : "wrong");
+                passed = false;
+            }
+            ImGui::EndDragDropSource();
+        }
+        ImGui::End();
+        ImGui::Render();
+    }
+    io.MouseDown[0] = false;
+    ImGui::NewFrame();
+    ImGui::EndFrame();
+
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    passed &= Check("drag_drop_payload: the drag started and went through every step", step_n + 1 == IM_ARRAYSIZE(steps));
+    Check("drag_drop_payload: the payload is copied and DataVersion bumped exactly when the data changes", passed);
+    Report.appendf("%s{\"name\":\"drag_drop_payload\",\"steps\":%d,\"passed\":%s}", RunCount > 0 ? ",\n" : "", step_n + 1, passed ? "true" : "false");
+    RunCount++;
+}
+
+static bool HarnessDockLogOpen = true;
+
+static void HarnessDockPresetFrame(ImGui::ImGuiDockFlags scene_flags)
+{
+    static const char* labels[] = { "Scene", "Properties", "Log", "Assets" };
+    static const ImGui::ImGuiDockFlags flags[] = { ImGuiDockFlags_StartLeft, ImGuiDockFlags_StartRight, ImGuiDockFlags_StartBottom, ImGuiDockFlags_StartTop };
+    ImGui::NewFrame();
+    ImGui::RootDock(ImVec2(0, 0), ImGui::GetIO().DisplaySize);
+    for (int i = 0; i < IM_ARRAYSIZE(labels); i++)
+    {
+        if (ImGui::BeginDock(labels[i], i == 2 ? &HarnessDockLogOpen : NULL, 0, flags[i] | (i == 0 ? scene_flags : 0)))
+            ImGui::Text("%s", labels[i]);
+        ImGui::EndDock();
+    }
+    ImGui::Render();
+}
+
+// The whole dock tree as written by SaveDock()
+static void HarnessDockLayout(ImGuiTextBuffer* out)
+{
+    ImGui::SaveDock();
+    int size = 0;
+    char* data = (char*)ImFileLoadToMemory("imgui_dock.layout", "rb", &size, 1);
+    remove("imgui_dock.layout");
+    out->clear();
+    if (data)
+        out->append(data, data + size);
+    ImGui::MemFree(data);
+}
+
+void ImGuiHarness::RunDockPresets(int switch_count)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = HarnessCreateContext(Context);
+    ImGui::ShutdownDock();
+
+    // "full", "no_log" with the log panel closed, and "no_log_no_tabs" which only differs from it by the flags of one panel
+    static const char* presets[] = { "full", "no_log", "no_log_no_tabs" };
+    ImGuiTextBuffer layouts[IM_ARRAYSIZE(presets)];
+    for (int n = 0; n < IM_ARRAYSIZE(presets); n++)
+    {
+        HarnessDockLogOpen = n == 0;
+        for (int frame = 0; frame < 5; frame++)
+            HarnessDockPresetFrame(n == 2 ? ImGuiDockFlags_NoTabs | ImGuiDockFlags_NoPad : 0);
+        ImGui::SaveDockPreset(presets[n]);
+        HarnessDockLayout(&layouts[n]);
+    }
+    bool passed = strcmp(layouts[1].c_str(), layouts[2].c_str()) != 0;
+
+    // Flags only: one dock changes
+    ImGuiTextBuffer layout;
+    int changed_count = -1;
+    passed &= ImGui::LoadDockPreset("no_log", &changed_count) && changed_count == 1;
+    HarnessDockLayout(&layout);
+    passed &= strcmp(layout.c_str(), layouts[1].c_str()) == 0;
+
+    double switch_ms = 0.0;
+    int changed_total = 0;
+    for (int n = 0; n < switch_count && passed; n++)
+    {
+        const int preset = n % 2 == 0 ? 0 : 1 + (n / 2) % 2;
+        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        passed &= ImGui::LoadDockPreset(presets[preset], &changed_count) && changed_count > 0;
+        switch_ms += HarnessElapsedMs(t0);
+        changed_total += changed_count;
+        HarnessDockLayout(&layout);
+        passed &= strcmp(layout.c_str(), layouts[preset].c_str()) == 0;
+
+        // Frames keep the layout, loading the same preset again changes nothing
+        HarnessDockLogOpen = preset == 0;
+        HarnessDockPresetFrame(0);
+        passed &= ImGui::LoadDockPreset(presets[preset], &changed_count) && changed_count == 0;
+    }
+    passed &= !ImGui::LoadDockPreset("missing", &changed_count) && changed_count == 0;
+    Check("dock_presets: switching restores the saved dock tree and reports the docks it changed", passed);
+
+    ImGui::ShutdownDock();
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+    HarnessDockLogOpen = true;
+
+    Report.appendf("%s{\"name\":\"dock_presets\",\"switches\":%d,\"switch_ms\":%.4f,\"changed_docks_avg\":%.2f,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", switch_count, switch_ms / ImMax(switch_count, 1), (double)changed_total / ImMax(switch_count, 1), passed ? "true" : "false");
+    RunCount++;
+}
+
+// Resident set size in MB, and its peak since the last call with reset_peak, -1 where unknown
+static double HarnessResidentMb(bool peak, bool reset_peak = false)
+{
+#ifdef __linux__
+    if (reset_peak)
+    {
+        if (FILE* f = fopen("/proc/self/clear_refs", "w"))
+        {
+            fputs("5", f);
+            fclose(f);
+        }
+        return -1.0;
+    }
+    double kb = -1.0;
+    if (FILE* f = fopen("/proc/self/status", "r"))
+    {
+        char line[256];
+        const char* key = peak ? "VmHWM:" : "VmRSS:";
+        while (fgets(line, IM_ARRAYSIZE(line), f))
+            if (strncmp(line, key, strlen(key)) == 0)
+                kb = atof(line + strlen(key));
+        fclose(f);
+    }
+    return kb < 0.0 ? -1.0 : kb / 1024.0;
+#else
+    (void)peak; (void)reset_peak;
+    return -1.0;
+#endif
+}
+
+static double HarnessTextEditorFrame(TextEditor* editor)
+{
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    ImGui::NewFrame();
+    ImGui::HarnessSceneTextEditor(editor);
+    ImGui::Render();
+    return HarnessElapsedMs(t0);
+}
+
+// Generated log of about megabytes MB, returns its size
+static size_t HarnessWriteLog(const char* filename, int megabytes)
+{
+    size_t file_size = 0;
+    if (FILE* f = ImFileOpen(filename, "wb"))
+    {
+        static const char* levels[] = { "INFO", "WARN", "ERROR", "DEBUG" };
+        char line[128];
+        for (int n = 0; file_size < (size_t)megabytes << 20; n++)
+        {
+            int len = ImFormatString(line, IM_ARRAYSIZE(line), "[%08d] %-5s frame %d: uploaded %d vertices to buffer /* pool %d */ in %.3f ms\n", n, levels[n % IM_ARRAYSIZE(levels)], n / 40, (n * 7919) % 100000, n % 7, (n % 97) * 0.125f);
+            fwrite(line, 1, (size_t)len, f);
+            file_size += (size_t)len;
+        }
+        fclose(f);
+    }
+    return file_size;
+}
+
+void ImGuiHarness::RunTextEditorLoad(int megabytes)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = HarnessCreateContext(Context);
+
+    // Generated log, written out so both paths start from a file
+    const char* filename = "imgui_harness_text_editor.log";
+    const size_t file_size = HarnessWriteLog(filename, megabytes);
+
+    // LoadFile()
+    double rss_before = HarnessResidentMb(false);
+    HarnessResidentMb(true, true);
+    TextEditor* editor = new TextEditor();
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    editor->LoadFile(filename, Context->IO.DrawJobsRunner, Context->IO.DrawJobsRunnerUserData);
+    const double load_file_ms = HarnessElapsedMs(t0);
+    const double load_file_frame_ms = HarnessTextEditorFrame(editor);
+    const double load_file_second_frame_ms = HarnessTextEditorFrame(editor);
+    const double load_file_peak_mb = HarnessResidentMb(true) - rss_before;
+    const int line_count = editor->GetTotalLines();
+    delete editor;
+
+    // Reading the file into a string and SetText()
+    rss_before = HarnessResidentMb(false);
+    HarnessResidentMb(true, true);
+    editor = new TextEditor();
+    t0 = std::chrono::high_resolution_clock::now();
+    std::string text;
+    if (FILE* f = ImFileOpen(filename, "rb"))
+    {
+        text.resize(file_size);
+        text.resize(fread(&text[0], 1, file_size, f));
+        fclose(f);
+    }
+    editor->SetText(text);
+    const double set_text_ms = HarnessElapsedMs(t0);
+    const double set_text_frame_ms = HarnessTextEditorFrame(editor);
+    const double set_text_second_frame_ms = HarnessTextEditorFrame(editor);
+    const double set_text_peak_mb = HarnessResidentMb(true) - rss_before;
+    text = std::string();
+    delete editor;
+    remove(filename);
+
+    // LoadFile() against SetText() of the same bytes, once colorized: CRLF and '\r' elsewhere, multi-line comments and strings, no final new line,
+    // only new lines and an empty file. Then ReleaseFile() keeps the text while the file gets written over.
+    auto colorize = [](TextEditor* editor_a)
+    {
+        while (editor_a->mCheckMultilineComments || editor_a->mColorRangeMin < editor_a->mColorRangeMax)
+            editor_a->ColorizeInternal();
+    };
+    auto same_lines = [](TextEditor* editor_a, TextEditor* editor_b)
+    {
+        if (editor_a->GetTotalLines() != editor_b->GetTotalLines() || editor_a->GetText() != editor_b->GetText())
+            return false;
+        for (int i = 0; i < editor_a->GetTotalLines(); i++)
+        {
+            const TextEditor::Line& line = editor_a->GetLine(i);
+            const TextEditor::Line& other = editor_b->GetLine(i);
+            if (line.size() != other.size())
+                return false;
+            for (size_t n = 0; n < line.size(); n++)
+                if (line[n].mChar != other[n].mChar || line[n].mColorIndex != other[n].mColorIndex || line[n].mMultiLineComment != other[n].mMultiLineComment)
+                    return false;
+        }
+        return true;
+    };
+    static const char* docs[] =
+    {
+        "#include <vector>\r\n/* comment\r\n   \"still\" comment */ int a = 1;\r\nconst char* s = \"a\\\"b /* not a comment */\";\r\n// line comment\r\n",
+        "int x = 0; /* open\nstill open\n*/ float y = 2.5f;\nreturn x;",
+        "a\r\r\nb\rc\n\r",
+        "\n\n",
+        "",
+    };
+    const char* doc_filename = "imgui_harness_text_editor_load_check.cpp";
+    bool same = true;
+    for (int doc_n = 0; doc_n < IM_ARRAYSIZE(docs); doc_n++)
+    {
+        if (FILE* f = ImFileOpen(doc_filename, "wb"))
+        {
+            fwrite(docs[doc_n], 1, strlen(docs[doc_n]), f);
+            fclose(f);
+        }
+        TextEditor* loaded = new TextEditor();
+        TextEditor* set = new TextEditor();
+        const bool opened = loaded->LoadFile(doc_filename);
+        set->SetText(docs[doc_n]);
+        colorize(loaded);
+        colorize(set);
+        const bool same_doc = opened && same_lines(loaded, set);
+        if (!same_doc)
+            fprintf(stderr, "text_editor_load: LoadFile() of document %d differs from SetText()\n", doc_n);
+        same &= same_doc;
+
+        if (doc_n == 0)
+        {
+            TextEditor* released = new TextEditor();
+            released->LoadFile(doc_filename);
+            released->ReleaseFile();
+            FILE* f = ImFileOpen(doc_filename, "wb");
+            if (f)
+            {
+                fputs("saved over\n", f);
+                fclose(f);
+            }
+            colorize(released);
+            same &= Check("text_editor_load: ReleaseFile() keeps the text of the file written over", f != NULL && !released->mFile && same_lines(released, set));
+            delete released;
+        }
+        delete loaded;
+        delete set;
+    }
+    remove(doc_filename);
+    Check("text_editor_load: LoadFile() matches SetText() of the same bytes", same);
+
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Report.appendf("%s{\"name\":\"text_editor_load\",\"file_mb\":%.1f,\"lines\":%d,\"load_file_ms\":%.4f,\"load_file_first_frame_ms\":%.4f,\"load_file_second_frame_ms\":%.4f,\"load_file_peak_mb\":%.1f,"
+        "\"set_text_ms\":%.4f,\"set_text_first_frame_ms\":%.4f,\"set_text_second_frame_ms\":%.4f,\"set_text_peak_mb\":%.1f,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", file_size / (1024.0 * 1024.0), line_count, load_file_ms, load_file_frame_ms, load_file_second_frame_ms, load_file_peak_mb,
+        set_text_ms, set_text_frame_ms, set_text_second_frame_ms, set_text_peak_mb, same ? "true" : "false");
+    RunCount++;
+}
+
+struct HarnessSearchMatch
+{
+    int         Line;
+    int         Start;
+    int         End;
+};
+
+// Every match of a literal testing each position of the lines with a byte compare, ASCII letters only when not case sensitive. A whole word has no
+// [A-Za-z0-9_] character on either side as for ECMAScript's \b. The literal can't overlap itself, so the matches are those of scanning line by line.
+static ImVector<HarnessSearchMatch> HarnessFindAll(const std::vector<std::string>& lines, const std::string& literal, bool case_sensitive, bool whole_word)
+{
+    ImVector<HarnessSearchMatch> matches;
+    const int len = (int)literal.size();
+    for (int line = 0; line < (int)lines.size(); line++)
+    {
+        const std::string& s = lines[line];
+        for (int pos = 0; pos + len <= (int)s.size(); )
+        {
+            bool found = true;
+            for (int n = 0; n < len && found; n++)
+                found = case_sensitive ? s[pos + n] == literal[n] : tolower((unsigned char)s[pos + n]) == tolower((unsigned char)literal[n]);
+            if (found && whole_word)
+            {
+                const bool word_before = pos > 0 && (isalnum((unsigned char)s[pos - 1]) || s[pos - 1] == '_');
+                const bool word_after = pos + len < (int)s.size() && (isalnum((unsigned char)s[pos + len]) || s[pos + len] == '_');
+                found = !word_before && !word_after;
+            }
+            if (!found)
+            {
+                pos++;
+                continue;
+            }
+            HarnessSearchMatch match = { line, pos, pos + len };
+            matches.push_back(match);
+            pos += len;
+        }
+    }
+    return matches;
+}
+
+// FindNext() from the top then FindNext(true) from the bottom, a few steps past wrapping around, against the next and previous brute-force match
+static bool HarnessFindNextMatchesScan(TextEditor* editor, const std::vector<std::string>& lines, const ImVector<HarnessSearchMatch>& matches)
+{
+    bool same = true;
+    for (int backwards = 0; backwards < 2; backwards++)
+    {
+        TextEditor::Coordinates from = backwards ? TextEditor::Coordinates((int)lines.size() - 1, (int)lines.back().size()) : TextEditor::Coordinates();
+        editor->SetSelection(from, from);
+        editor->SetCursorPosition(from);
+        int line = from.mLine, column = from.mColumn;
+        for (int step = 0; step < matches.Size + 3; step++)
+        {
+            const bool found = editor->FindNext(backwards != 0);
+            if (matches.Size == 0)
+            {
+                same &= !found;
+                break;
+            }
+            // Forward: first match starting at or after the end of the previous one. Backward: last match starting before the start of the previous one.
+            int next;
+            if (!backwards)
+            {
+                for (next = 0; next < matches.Size && (matches[next].Line < line || (matches[next].Line == line && matches[next].Start < column)); next++) {}
+                if (next == matches.Size)
+                    next = 0;
+            }
+            else
+            {
+                for (next = matches.Size - 1; next >= 0 && (matches[next].Line > line || (matches[next].Line == line && matches[next].Start >= column)); next--) {}
+                if (next < 0)
+                    next = matches.Size - 1;
+            }
+            const HarnessSearchMatch& match = matches[next];
+            same &= found && editor->GetCursorPosition() == TextEditor::Coordinates(match.Line, match.End) && editor->GetSelectedText() == lines[match.Line].substr(match.Start, match.End - match.Start);
+            line = match.Line;
+            column = backwards ? match.Start : match.End;
+        }
+    }
+    return same;
+}
+
+void ImGuiHarness::RunTextEditorSearch(int megabytes)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = HarnessCreateContext(Context);
+
+    // Generated log with a single occurrence of the needle on its last line
+    const char* filename = "imgui_harness_text_editor_search.log";
+    const char* needle = "shader_cache_miss";
+    size_t file_size = HarnessWriteLog(filename, megabytes);
+    if (FILE* f = ImFileOpen(filename, "ab"))
+    {
+        file_size += fprintf(f, "[99999999] ERROR %s for pass 3\n", needle);
+        fclose(f);
+    }
+
+    TextEditor* mapped = new TextEditor();
+    mapped->LoadFile(filename, Context->IO.DrawJobsRunner, Context->IO.DrawJobsRunnerUserData);
+    HarnessTextEditorFrame(mapped);
+
+    // What callers had to do before: export the whole document and search the string
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    bool found_in_text = mapped->GetText().find(needle) != std::string::npos;
+    const double get_text_find_ms = HarnessElapsedMs(t0);
+
+    // Searches from the top of the mapped file to its last line
+    double find_next_ms[3];
+    bool found[3];
+    const char* patterns[3] = { needle, "SHADER_CACHE_MISS", "shader_\\w+_miss" };
+    for (int n = 0; n < 3; n++)
+    {
+        mapped->SetSearch(patterns[n], n != 1, n == 2);
+        mapped->SetCursorPosition(TextEditor::Coordinates());
+        mapped->SetSelection(TextEditor::Coordinates(), TextEditor::Coordinates());
+        t0 = std::chrono::high_resolution_clock::now();
+        found[n] = mapped->FindNext();
+        find_next_ms[n] = HarnessElapsedMs(t0);
+    }
+
+    // Stepping through a frequent match, and a frame highlighting the matches of the visible lines
+    const int step_count = 1000;
+    mapped->SetSearch("ERROR");
+    t0 = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < step_count; n++)
+        mapped->FindNext();
+    const double find_next_step_ms = HarnessElapsedMs(t0) / step_count;
+    mapped->SetSearch("vertices");
+    const double highlight_frame_ms = HarnessTextEditorFrame(mapped);
+    delete mapped;
+
+    // The same document with every line held as glyphs
+    std::string text;
+    if (FILE* f = ImFileOpen(filename, "rb"))
+    {
+        text.resize(file_size);
+        text.resize(fread(&text[0], 1, file_size, f));
+        fclose(f);
+    }
+    TextEditor* editor = new TextEditor();
+    editor->SetText(text);
+    text = std::string();
+    editor->SetSearch(needle);
+    t0 = std::chrono::high_resolution_clock::now();
+    const bool found_in_glyphs = editor->FindNext();
+    const double find_next_glyphs_ms = HarnessElapsedMs(t0);
+
+    editor->SetSearch("WARN ");
+    t0 = std::chrono::high_resolution_clock::now();
+    const int replace_count = editor->ReplaceAll("W ");
+    const double replace_all_ms = HarnessElapsedMs(t0);
+    delete editor;
+    remove(filename);
+
+    // A document with the pattern in other cases, inside longer words, next to '_', punctuation, tabs and UTF-8, several times on a line and on
+    // lines without it, set as glyphs and loaded from a file. FindNext() both ways against a brute-force scan, ReplaceAll() with a replacement adding
+    // lines (moving the matches after it on its line and below) against replacing the scanned matches, and Undo() and Redo() of it.
+    static const char* words[] = { "WARN", "warn", "Warn", "WARNING", "xWARN", "WARN_2", "[WARN]", "WARNWARN", "w\xC3\xA9", "\tWARN", "ERROR", "wArN." };
+    std::string doc;
+    for (int line = 0; line < 300; line++)
+    {
+        for (int n = 0; n < line % 5; n++)
+            doc.append(words[(line * 7 + n * 3) % IM_ARRAYSIZE(words)]).append(" ");
+        if (line < 299)
+            doc += '\n';
+    }
+    std::vector<std::string> lines;
+    for (size_t begin = 0, end; ; begin = end + 1)
+    {
+        end = doc.find('\n', begin);
+        lines.push_back(doc.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+        if (end == std::string::npos)
+            break;
+    }
+    const char* doc_filename = "imgui_harness_text_editor_search_check.txt";
+    if (FILE* f = ImFileOpen(doc_filename, "wb"))
+    {
+        fwrite(doc.data(), 1, doc.size(), f);
+        fclose(f);
+    }
+
+    // The replaced text is Prefix, the match for regex patterns (their With has $&), then Suffix
+    struct HarnessSearchCase { const char* Pattern; bool CaseSensitive; bool Regex; const char* Literal; bool WholeWord; const char* With; const char* Prefix; const char* Suffix; };
+    static const HarnessSearchCase cases[] =
+    {
+        { "WARN", true, false, "WARN", false, "W\n\xC3\xA9", "W\n\xC3\xA9", "" },
+        { "warn", false, false, "warn", false, "", "", "" },
+        { "\\bWARN\\b", true, true, "WARN", true, "<$&>\n", "<", ">\n" },
+        { "\\bwarn\\b", false, true, "warn", true, "$&x", "", "x" },
+        { "absent", true, false, "absent", false, "y", "y", "" },
+    };
+    bool same = true;
+    for (int case_n = 0; case_n < IM_ARRAYSIZE(cases); case_n++)
+    {
+        const HarnessSearchCase& search = cases[case_n];
+        const ImVector<HarnessSearchMatch> matches = HarnessFindAll(lines, search.Literal, search.CaseSensitive, search.WholeWord);
+        std::string replaced;
+        for (int line = 0, next = 0; line < (int)lines.size(); line++)
+        {
+            int column = 0;
+            for (; next < matches.Size && matches[next].Line == line; next++)
+            {
+                const HarnessSearchMatch& match = matches[next];
+                replaced.append(lines[line], column, match.Start - column).append(search.Prefix);
+                if (search.Regex)
+                    replaced.append(lines[line], match.Start, match.End - match.Start);
+                replaced.append(search.Suffix);
+                column = match.End;
+            }
+            replaced.append(lines[line], column, std::string::npos);
+            if (line + 1 < (int)lines.size())
+                replaced += '\n';
+        }
+
+        for (int loaded = 0; loaded < 2; loaded++)
+        {
+            TextEditor* search_editor = new TextEditor();
+            if (loaded)
+                search_editor->LoadFile(doc_filename);
+            else
+                search_editor->SetText(doc);
+            HarnessTextEditorFrame(search_editor);
+            search_editor->SetSearch(search.Pattern, search.CaseSensitive, search.Regex);
+            const bool same_find = HarnessFindNextMatchesScan(search_editor, lines, matches);
+            const int count = search_editor->ReplaceAll(search.With);
+            const bool same_replace = count == matches.Size && search_editor->GetText() == replaced;
+            search_editor->Undo();
+            bool same_undo = search_editor->GetText() == doc;
+            search_editor->Redo();
+            same_undo &= search_editor->GetText() == replaced;
+            search_editor->Undo();
+            same_undo &= search_editor->GetText() == doc;
+            delete search_editor;
+            if (!same_find || !same_replace || !same_undo)
+                fprintf(stderr, "text_editor_search: \"%s\" (%s) differs from a scan:%s%s%s\n", search.Pattern, loaded ? "loaded" : "glyphs",
+                    same_find ? "" : " FindNext()", same_replace ? "" : " ReplaceAll()", same_undo ? "" : " Undo()/Redo()");
+            same &= same_find && same_replace && same_undo;
+        }
+    }
+    remove(doc_filename);
+    Check("text_editor_search: FindNext(), ReplaceAll() and its undo match a brute-force scan", same);
+
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Report.appendf("%s{\"name\":\"text_editor_search\",\"file_mb\":%.1f,\"found\":%s,\"get_text_find_ms\":%.4f,\"find_next_ms\":%.4f,\"find_next_icase_ms\":%.4f,\"find_next_regex_ms\":%.4f,"
+        "\"find_next_glyphs_ms\":%.4f,\"find_next_step_ms\":%.4f,\"highlight_frame_ms\":%.4f,\"replace_all_count\":%d,\"replace_all_ms\":%.4f,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", file_size / (1024.0 * 1024.0), found_in_text && found[0] && found[1] && found[2] && found_in_glyphs ? "true" : "false",
+        get_text_find_ms, find_next_ms[0], find_next_ms[1], find_next_ms[2], find_next_glyphs_ms, find_next_step_ms, highlight_frame_ms, replace_count, replace_all_ms, same ? "true" : "false");
+    RunCount++;
+}
+
+static const char* HarnessGetClipboardText(void* user_data)
+{
+    return ((const std::string*)user_data)->c_str();
+}
+
+void ImGuiHarness::RunTextEditorMarkers(int line_count, int marker_count)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = HarnessCreateContext(Context);
+    ImGuiIO& io = ImGui::GetIO();
+
+    std::string text;
+    char line[64];
+    for (int n = 0; n < line_count; n++)
+        text.append(line, (size_t)ImFormatString(line, IM_ARRAYSIZE(line), "float value%d = %d.0; // diagnostic target\n", n, n));
+    TextEditor* editor = new TextEditor();
+    editor->SetText(text);
+
+    // Diagnostics spread over the document, one breakpoint for every four of them
+    TextEditor::ErrorMarkers error_markers;
+    TextEditor::Breakpoints breakpoints;
+    for (int n = 0; n < marker_count; n++)
+    {
+        int marker_line = 1 + (int)((long long)n * line_count / marker_count);
+        error_markers[marker_line] = "error X3004: undeclared identifier";
+        if (n % 4 == 0)
+            breakpoints.insert(marker_line);
+    }
+    editor->SetErrorMarkers(error_markers);
+    editor->SetBreakpoints(breakpoints);
+    bool markers_ok = Check("text_editor_markers: markers read back as set", editor->GetErrorMarkers() == error_markers && editor->GetBreakpoints() == breakpoints);
+
+    // Paste a 10k line block in the middle, through a private clipboard, then delete it. The markers of the lines below follow their text.
+    const int paste_lines = 10000;
+    const int paste_line = line_count / 2;
+    std::string block;
+    for (int n = 0; n < paste_lines; n++)
+        block.append(line, (size_t)ImFormatString(line, IM_ARRAYSIZE(line), "pasted%d();\n", n));
+    io.GetClipboardTextFn = HarnessGetClipboardText;
+    io.ClipboardUserData = &block;
+    TextEditor::ErrorMarkers pasted_error_markers;
+    TextEditor::Breakpoints pasted_breakpoints;
+    for (auto& marker : error_markers)
+        pasted_error_markers[marker.first > paste_line ? marker.first + paste_lines : marker.first] = marker.second;
+    for (int marker_line : breakpoints)
+        pasted_breakpoints.insert(marker_line > paste_line ? marker_line + paste_lines : marker_line);
+
+    editor->SetCursorPosition(TextEditor::Coordinates(paste_line, 0));
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    editor->Paste();
+    const double paste_ms = HarnessElapsedMs(t0);
+    markers_ok &= Check("text_editor_markers: markers below the paste move down by the pasted lines", editor->GetErrorMarkers() == pasted_error_markers && editor->GetBreakpoints() == pasted_breakpoints);
+    editor->SetSelection(TextEditor::Coordinates(paste_line, 0), TextEditor::Coordinates(paste_line + paste_lines, 0));
+    t0 = std::chrono::high_resolution_clock::now();
+    editor->Delete();
+    const double delete_ms = HarnessElapsedMs(t0);
+    markers_ok &= Check("text_editor_markers: deleting the pasted lines moves the markers back", editor->GetErrorMarkers() == error_markers && editor->GetBreakpoints() == breakpoints);
+    const double frame_ms = HarnessTextEditorFrame(editor);
+    const int error_markers_after = (int)editor->GetErrorMarkers().size();
+
+    // Undoing the delete pastes again, undoing the paste deletes again
+    editor->Undo();
+    markers_ok &= Check("text_editor_markers: undoing the delete moves the markers down again", editor->GetErrorMarkers() == pasted_error_markers && editor->GetBreakpoints() == pasted_breakpoints);
+    editor->Undo();
+    markers_ok &= Check("text_editor_markers: undoing the paste moves the markers back", editor->GetErrorMarkers() == error_markers && editor->GetBreakpoints() == breakpoints);
+    markers_ok &= Check("text_editor_markers: undo restores the text", editor->GetTotalLines() == line_count + 1);
+    delete editor;
+
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Report.appendf("%s{\"name\":\"text_editor_markers\",\"lines\":%d,\"error_markers\":%d,\"breakpoints\":%d,\"paste_lines\":%d,\"paste_ms\":%.4f,\"delete_ms\":%.4f,\"frame_ms\":%.4f,\"error_markers_after\":%d,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", line_count, (int)error_markers.size(), (int)breakpoints.size(), paste_lines, paste_ms, delete_ms, frame_ms, error_markers_after, markers_ok ? "true" : "false");
+    RunCount++;
+}
+
+void ImGuiHarness::RunTextEditorLongLines(int line_length, int line_count)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = HarnessCreateContext(Context);
+
+    // Minified-like lines, tab separated fields
+    std::string text;
+    char field[32];
+    for (int n = 0; n < line_count; n++)
+    {
+        size_t line_start = text.size();
+        for (int i = 0; text.size() - line_start < (size_t)line_length; i++)
+            text.append(field, (size_t)ImFormatString(field, IM_ARRAYSIZE(field), i % 3 ? "%d,\t" : "f(%d);", n * 7 + i));
+        text += '\n';
+    }
+    TextEditor* editor = new TextEditor();
+    editor->SetText(text);
+    text = std::string();
+
+    // TextDistanceToLineStart() and VisualColumnToColumn() at every glyph and visual column of a line, against walking its glyphs
+    auto same_columns = [editor](int line_index) -> bool
+    {
+        const TextEditor::Line& line = editor->GetLine(line_index);
+        const int line_size = (int)line.size();
+        bool same = editor->VisualColumnToColumn(line_index, 0) == 0 && editor->VisualColumnToColumn(line_index, -1) == 0;
+        int distance = 0;
+        for (int column = 0; column < line_size && same; column++)
+        {
+            same = editor->TextDistanceToLineStart(TextEditor::Coordinates(line_index, column)) == distance;
+            const int next_distance = line[column].mChar == '\t' ? (distance / editor->mTabSize) * editor->mTabSize + editor->mTabSize : distance + 1;
+            for (int visual_column = distance + 1; visual_column <= next_distance; visual_column++)
+                same &= editor->VisualColumnToColumn(line_index, visual_column) == column + 1;
+            distance = next_distance;
+        }
+        same &= editor->TextDistanceToLineStart(TextEditor::Coordinates(line_index, line_size)) == distance;
+        same &= editor->TextDistanceToLineStart(TextEditor::Coordinates(line_index, line_size + 10)) == distance;
+        same &= editor->VisualColumnToColumn(line_index, distance + 1) == line_size && editor->VisualColumnToColumn(line_index, INT_MAX) == line_size;
+        return same;
+    };
+    bool same = true;
+    for (int n = 0; n < ImMin(line_count, 4); n++)
+        same &= Check("text_editor_long_lines: cached columns match the glyph walk", same_columns(n));
+
+    // Scrolled to the far end of the first line, then typing there
+    editor->SetCursorPosition(TextEditor::Coordinates(0, line_length));
+    const double first_frame_ms = HarnessTextEditorFrame(editor);
+    const int frame_count = 60;
+    double frames_ms = 0.0;
+    for (int n = 0; n < frame_count; n++)
+        frames_ms += HarnessTextEditorFrame(editor);
+    double typing_frames_ms = 0.0;
+    for (int n = 0; n < frame_count; n++)
+    {
+        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        editor->InsertText(n % 2 ? "\t" : "x");
+        typing_frames_ms += HarnessElapsedMs(t0) + HarnessTextEditorFrame(editor);
+    }
+
+    // Edits at the end, in the middle and at the start of lines whose columns were looked up
+    same &= Check("text_editor_long_lines: cached columns match the glyph walk after typing", same_columns(0));
+    editor->SetCursorPosition(TextEditor::Coordinates(0, 7));
+    editor->InsertText("ab\tc\t");
+    same &= Check("text_editor_long_lines: cached columns match the glyph walk after inserting tabs", same_columns(0));
+    if (line_count > 1)
+    {
+        editor->SetCursorPosition(TextEditor::Coordinates(1, 0));
+        editor->InsertText("x");
+        same &= Check("text_editor_long_lines: cached columns match the glyph walk after shifting tabs by one", same_columns(1));
+        editor->SetCursorPosition(TextEditor::Coordinates(1, 0));
+        editor->InsertText("\n\t");
+        same &= Check("text_editor_long_lines: cached columns match the glyph walk after splitting a line", same_columns(1) && same_columns(2));
+    }
+    delete editor;
+
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Report.appendf("%s{\"name\":\"text_editor_long_lines\",\"line_length\":%d,\"lines\":%d,\"first_frame_ms\":%.4f,\"frame_ms\":%.4f,\"typing_frame_ms\":%.4f,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", line_length, line_count, first_frame_ms, frames_ms / frame_count, typing_frames_ms / frame_count, same ? "true" : "false");
+    RunCount++;
+}
+
+void ImGuiHarness::RunTextEditorGetText(int megabytes)
+{
+    const char* filename = "imgui_harness_text_editor.log";
+    const size_t file_size = HarnessWriteLog(filename, megabytes);
+    int file_data_size = 0;
+    char* file_data = (char*)ImFileLoadToMemory(filename, "rb", &file_data_size);
+    IM_ASSERT(file_data != NULL && (size_t)file_data_size == file_size);
+
+    // Mapped, then held as glyphs
+    TextEditor* editor = new TextEditor();
+    editor->LoadFile(filename);
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    std::string text = editor->GetText();
+    const double mapped_ms = HarnessElapsedMs(t0);
+    ImVector<char> buffer;
+    buffer.resize((int)editor->GetText(NULL, 0));
+    editor->GetText(buffer.Data, (size_t)buffer.Size);
+    bool passed = Check("text_editor_get_text: GetText() of the mapped file returns the file", text.size() == file_size && memcmp(text.data(), file_data, file_size) == 0);
+    passed &= Check("text_editor_get_text: GetText(char*, size_t) of the mapped file returns the file", buffer.Size == file_data_size && memcmp(buffer.Data, file_data, file_size) == 0);
+    editor->SetText(text);
+    remove(filename);
+    t0 = std::chrono::high_resolution_clock::now();
+    text = editor->GetText();
+    const double glyphs_ms = HarnessElapsedMs(t0);
+    passed &= Check("text_editor_get_text: GetText() returns the loaded file", text.size() == file_size && memcmp(text.data(), file_data, file_size) == 0);
+    memset(buffer.Data, 0, (size_t)buffer.Size);
+    buffer.resize((int)editor->GetText(NULL, 0));
+    t0 = std::chrono::high_resolution_clock::now();
+    editor->GetText(buffer.Data, (size_t)buffer.Size);
+    const double buffer_ms = HarnessElapsedMs(t0);
+    passed &= Check("text_editor_get_text: GetText(char*, size_t) returns the loaded file", buffer.Size == file_data_size && memcmp(buffer.Data, file_data, file_size) == 0);
+    passed &= Check("text_editor_get_text: GetText(char*, size_t) leaves a buffer too small alone", editor->GetText(buffer.Data, file_size - 1) == file_size);
+    ImGui::MemFree(file_data);
+
+    // A caller refreshing its copy of the text each frame
+    const int frame_count = 60;
+    double every_frame_ms = 0.0, on_change_ms = 0.0;
+    unsigned int version = editor->GetVersion();
+    int exports = 0;
+    for (int n = 0; n < frame_count; n++)
+    {
+        if (n % 10 == 0)
+            editor->InsertText("x");
+        t0 = std::chrono::high_resolution_clock::now();
+        text = editor->GetText();
+        every_frame_ms += HarnessElapsedMs(t0);
+        t0 = std::chrono::high_resolution_clock::now();
+        if (editor->IsChangedSince(version))
+        {
+            buffer.resize((int)editor->GetText(NULL, 0));
+            editor->GetText(buffer.Data, (size_t)buffer.Size);
+            version = editor->GetVersion();
+            exports++;
+        }
+        on_change_ms += HarnessElapsedMs(t0);
+    }
+    passed &= Check("text_editor_get_text: the text is exported again once per edit", exports == frame_count / 10);
+
+    // Reading the text, moving the cursor and selecting don't change it, deleting, undoing, redoing and replacing it do
+    version = editor->GetVersion();
+    editor->GetText();
+    editor->GetText(buffer.Data, (size_t)buffer.Size);
+    editor->SetCursorPosition(TextEditor::Coordinates(3, 2));
+    editor->SetSelection(TextEditor::Coordinates(1, 0), TextEditor::Coordinates(4, 5));
+    editor->GetSelectedText();
+    editor->Redo();
+    passed &= Check("text_editor_get_text: not changed by reading, moving the cursor or selecting", !editor->IsChangedSince(version));
+    editor->Delete();
+    passed &= Check("text_editor_get_text: changed by Delete()", editor->IsChangedSince(version));
+    version = editor->GetVersion();
+    editor->Undo();
+    passed &= Check("text_editor_get_text: changed by Undo()", editor->IsChangedSince(version));
+    version = editor->GetVersion();
+    editor->Redo();
+    passed &= Check("text_editor_get_text: changed by Redo()", editor->IsChangedSince(version));
+    version = editor->GetVersion();
+    editor->SetText("replaced\n");
+    passed &= Check("text_editor_get_text: changed by SetText()", editor->IsChangedSince(version));
+    version = editor->GetVersion();
+    passed &= Check("text_editor_get_text: not changed since the last GetVersion()", !editor->IsChangedSince(version));
+    delete editor;
+
+    Report.appendf("%s{\"name\":\"text_editor_get_text\",\"bytes\":%d,\"mapped_ms\":%.4f,\"glyphs_ms\":%.4f,\"buffer_ms\":%.4f,\"every_frame_ms\":%.4f,\"on_change_ms\":%.4f,\"exports\":%d,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", (int)file_size, mapped_ms, glyphs_ms, buffer_ms, every_frame_ms / frame_count, on_change_ms / frame_count, exports, passed ? "true" : "false");
+    RunCount++;
+}
+
+static double HarnessTabsFrame(bool* last_tab_open)
+{
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    ImGui::NewFrame();
+    ImGui::HarnessSceneTabsMany(last_tab_open);
+    ImGui::Render();
+    return HarnessElapsedMs(t0);
+}
+
+// One frame which has to skip the layout, then the same frame with a forced full layout: both have to give the same offsets and widths.
+// The layout uses the tabs submitted the frame before, so a tab closed last frame only leaves it this frame: one more frame settles it.
+static bool HarnessTabsCleanMatchesFullLayout(bool* last_tab_open)
+{
+    ImVector<ImGuiTabLayout> clean_tabs, full_tabs;
+    float clean_offset_max, full_offset_max;
+    int first_layout_count, clean_layout_count, full_layout_count;
+    HarnessTabsFrame(last_tab_open);
+    ImGui::GetTabBarLayout("Tabs (many)", "##tabs_many", &clean_tabs, &clean_offset_max, &first_layout_count);
+    HarnessTabsFrame(last_tab_open);
+    ImGui::GetTabBarLayout("Tabs (many)", "##tabs_many", &clean_tabs, &clean_offset_max, &clean_layout_count);
+    ImGui::SetTabBarLayoutDirty("Tabs (many)", "##tabs_many");
+    HarnessTabsFrame(last_tab_open);
+    ImGui::GetTabBarLayout("Tabs (many)", "##tabs_many", &full_tabs, &full_offset_max, &full_layout_count);
+    return clean_layout_count == first_layout_count && full_layout_count == clean_layout_count + 1 && clean_offset_max == full_offset_max && HarnessSameVector(clean_tabs, full_tabs);
+}
+
+void ImGuiHarness::RunTabsLayout(int frame_count)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(Context);
+    ImGui::GetIO().DeltaTime = 1.0f / 60.0f;
+
+    bool last_tab_open = true;
+    const double first_frame_ms = HarnessTabsFrame(&last_tab_open);
+    for (int n = 0; n < 10; n++)
+        HarnessTabsFrame(&last_tab_open);
+    double clean_ms = 0.0, relayout_ms = 0.0;
+    for (int n = 0; n < frame_count; n++)
+        clean_ms += HarnessTabsFrame(&last_tab_open);
+    for (int n = 0; n < frame_count; n++)
+    {
+        last_tab_open = !last_tab_open;
+        relayout_ms += HarnessTabsFrame(&last_tab_open);
+    }
+
+    // Skipped layouts after a tab is added, closed and reordered against full layouts
+    last_tab_open = true;
+    HarnessTabsFrame(&last_tab_open);
+    bool same = Check("tabs_layout: clean layout after adding a tab matches a full layout", HarnessTabsCleanMatchesFullLayout(&last_tab_open));
+    last_tab_open = false;
+    HarnessTabsFrame(&last_tab_open);
+    same &= Check("tabs_layout: clean layout after closing a tab matches a full layout", HarnessTabsCleanMatchesFullLayout(&last_tab_open));
+    ImGui::QueueTabBarReorder("Tabs (many)", "##tabs_many", 10, +1);
+    HarnessTabsFrame(&last_tab_open);
+    same &= Check("tabs_layout: clean layout after moving a tab right matches a full layout", HarnessTabsCleanMatchesFullLayout(&last_tab_open));
+    ImGui::QueueTabBarReorder("Tabs (many)", "##tabs_many", 500, -1);
+    HarnessTabsFrame(&last_tab_open);
+    same &= Check("tabs_layout: clean layout after moving a tab left matches a full layout", HarnessTabsCleanMatchesFullLayout(&last_tab_open));
+
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Report.appendf("%s{\"name\":\"tabs_layout\",\"tabs\":1000,\"first_frame_ms\":%.4f,\"clean_frame_ms\":%.4f,\"relayout_frame_ms\":%.4f,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", first_frame_ms, clean_ms / frame_count, relayout_ms / frame_count, same ? "true" : "false");
+    RunCount++;
+}
+
+struct HarnessPlotHistory
+{
+    const ImVector<float>*  Values;     // PlotLines() data, NULL for the stream
+    const ImGuiPlotStream*  Stream;
+};
+
+static double HarnessPlotFrame(const HarnessPlotHistory& history)
+{
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Plot", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+    if (history.Values)
+        ImGui::PlotLines("##history", history.Values->Data, history.Values->Size, 0, NULL, FLT_MAX, FLT_MAX, ImVec2(1200, 200));
+    else
+        ImGui::PlotStreamLines("##history", history.Stream, NULL, FLT_MAX, FLT_MAX, ImVec2(1200, 200));
+    ImGui::End();
+    ImGui::Render();
+    return HarnessElapsedMs(t0);
+}
+
+void ImGuiHarness::RunPlotStream(int sample_count, int frame_count)
+{
+    // Frame time like noise, with a spike up and one down every 100003 samples
+    ImVector<float> samples;
+    samples.resize(sample_count + sample_count / 3);
+    unsigned int seed = 12345;
+    for (int n = 0; n < samples.Size; n++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        samples[n] = 16.0f + (float)((seed >> 8) % 1000) * 0.001f;
+        if (n % 100003 == 50000)
+            samples[n] = 100.0f + (float)(n % 7);
+        else if (n % 100003 == 75000)
+            samples[n] = -(float)(n % 5);
+    }
+    ImGuiPlotStream stream(sample_count);
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < samples.Size; n++)
+        stream.Append(samples[n]);
+    const double append_ms = HarnessElapsedMs(t0);
+    ImVector<float> history;
+    history.resize(sample_count);
+    memcpy(history.Data, samples.Data + samples.Size - sample_count, (size_t)sample_count * sizeof(float));
+
+    // Columns split the samples like PlotStreamLines() does at 1200 pixels, less the frame padding
+    const int res_w = ImMin(1200 - (int)(ImGui::GetStyle().FramePadding.x * 2.0f), sample_count);
+    bool envelope_same = stream.Count == sample_count;
+    int spikes = 0, spikes_kept = 0;
+    float all_min = FLT_MAX, all_max = -FLT_MAX;
+    for (int col = 0; col < res_w; col++)
+    {
+        const int idx_begin = (int)((double)col * sample_count / res_w);
+        const int idx_end = (int)((double)(col + 1) * sample_count / res_w);
+        float expected_min = FLT_MAX, expected_max = -FLT_MAX;
+        int spike_idx = -1;
+        for (int n = idx_begin; n < idx_end; n++)
+        {
+            expected_min = ImMin(expected_min, history[n]);
+            expected_max = ImMax(expected_max, history[n]);
+            if (history[n] >= 100.0f || history[n] <= 0.0f)
+                spike_idx = n;
+        }
+        float v_min, v_max;
+        stream.GetMinMax(idx_begin, idx_end, &v_min, &v_max);
+        envelope_same &= v_min == expected_min && v_max == expected_max;
+        if (spike_idx >= 0)
+        {
+            spikes++;
+            spikes_kept += (v_max == history[spike_idx] || v_min == history[spike_idx]) ? 1 : 0;
+        }
+        all_min = ImMin(all_min, expected_min);
+        all_max = ImMax(all_max, expected_max);
+    }
+    Check("plot_stream: every column's min/max matches a pass over its samples", envelope_same);
+    Check("plot_stream: the spikes are the min or max of their column", spikes > 0 && spikes_kept == spikes);
+    Check("plot_stream: GetMin()/GetMax() are the extremes of the history", stream.GetMin() == all_min && stream.GetMax() == all_max);
+
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(Context);
+    ImGui::GetIO().DeltaTime = 1.0f / 60.0f;
+    HarnessPlotHistory plot_lines = { &history, NULL };
+    HarnessPlotHistory plot_stream = { NULL, &stream };
+    HarnessPlotFrame(plot_lines);
+    HarnessPlotFrame(plot_stream);
+    double plot_lines_ms = 0.0, plot_stream_ms = 0.0;
+    for (int n = 0; n < frame_count; n++)
+    {
+        plot_lines_ms += HarnessPlotFrame(plot_lines);
+        plot_stream_ms += HarnessPlotFrame(plot_stream);
+    }
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    const bool passed = envelope_same && spikes_kept == spikes;
+    Report.appendf("%s{\"name\":\"plot_stream\",\"samples\":%d,\"columns\":%d,\"append_ms\":%.4f,\"plot_lines_frame_ms\":%.4f,\"plot_stream_frame_ms\":%.4f,\"spikes\":%d,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", sample_count, res_w, append_ms, plot_lines_ms / frame_count, plot_stream_ms / frame_count, spikes, passed ? "true" : "false");
+    RunCount++;
+}
+
+static void HarnessResetDrawList(ImDrawList* draw_list, ImTextureID texture_id)
+{
+    draw_list->Clear();
+    draw_list->PushClipRectFullScreen();
+    draw_list->PushTextureID(texture_id);
+}
+
+void ImGuiHarness::RunRenderText(int line_count)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(Context);
+    ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
+    const ImTextureID texture_id = font->ContainerAtlas->TexID;
+    ImDrawList fast(&Context->DrawListSharedData), generic(&Context->DrawListSharedData);
+
+    // cpu_fine_clip turns the fast path off and only changes glyphs crossing the clip rectangle, this one holds all the text.
+    // It also drops glyphs with no height (DEL in the default font), the texts have none.
+    const ImVec4 clip_rect(0.0f, 0.0f, 100000.0f, 100000.0f);
+    static const char* texts[] =
+    {
+        "Log line 0042: connection established to server-3.example.net, latency 17 ms, payload ok",
+        "short",
+        "caf\xC3\xA9" " cr\xC3\xA8me br\xC3\xBBl\xC3\xA9" "e and \xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E" " fall back to the fallback glyph",
+        "^1error^0: file not found, ^3warning^0 ^^ escaped caret, trailing code ^",
+        "\tindented\twith\ttabs\r\nand a CRLF, then\nmore lines\n\nafter an empty one",
+        "A long paragraph that gets wrapped at two hundred pixels, with    several spaces between words and a verylongwordthatcannotbebrokenanywhere at the end.",
+        "\x01\x1F" " control characters and a lone continuation byte \x80" " in the middle",
+    };
+    bool same = true;
+    for (int text_n = 0; text_n < IM_ARRAYSIZE(texts); text_n++)
+        for (int wrap_n = 0; wrap_n < 2; wrap_n++)
+        {
+            const float wrap_width = wrap_n == 0 ? 0.0f : 200.0f;
+            HarnessResetDrawList(&fast, texture_id);
+            HarnessResetDrawList(&generic, texture_id);
+            font->RenderText(&fast, font->FontSize, ImVec2(10.0f, 20.0f), 0xFFFFFFFF, clip_rect, texts[text_n], NULL, wrap_width, false);
+            font->RenderText(&generic, font->FontSize, ImVec2(10.0f, 20.0f), 0xFFFFFFFF, clip_rect, texts[text_n], NULL, wrap_width, true);
+            same &= fast.VtxBuffer.Size == generic.VtxBuffer.Size && fast.IdxBuffer.Size == generic.IdxBuffer.Size && fast.VtxBuffer.Size > 0 &&
+                memcmp(fast.VtxBuffer.Data, generic.VtxBuffer.Data, (size_t)fast.VtxBuffer.Size * sizeof(ImDrawVert)) == 0 &&
+                memcmp(fast.IdxBuffer.Data, generic.IdxBuffer.Data, (size_t)fast.IdxBuffer.Size * sizeof(ImDrawIdx)) == 0;
+        }
+    Check("render_text: the ASCII fast path writes the same vertices and indices as the generic loop", same);
+
+    ImGuiTextBuffer log;
+    ImVector<int> line_offsets;
+    for (int n = 0; n < line_count; n++)
+    {
+        line_offsets.push_back(log.size());
+        log.appendf("[%06d] INFO  connection established to server-%d.example.net, latency %d ms, payload ok", n, n % 16, n % 97);
+    }
+    line_offsets.push_back(log.size());
+
+    double ms[2] = { 0.0, 0.0 };
+    for (int pass = 0; pass < 2; pass++)
+    {
+        ImDrawList* draw_list = pass == 0 ? &fast : &generic;
+        HarnessResetDrawList(draw_list, texture_id);
+        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        for (int n = 0; n < line_count; n++)
+        {
+            // Stay within 16-bit indices
+            if (draw_list->VtxBuffer.Size > 60000)
+                HarnessResetDrawList(draw_list, texture_id);
+            font->RenderText(draw_list, font->FontSize, ImVec2(0.0f, (float)(n % 60) * font->FontSize), 0xFFFFFFFF, clip_rect, log.begin() + line_offsets[n], log.begin() + line_offsets[n + 1], 0.0f, pass == 1);
+        }
+        ms[pass] = HarnessElapsedMs(t0);
+    }
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Report.appendf("%s{\"name\":\"render_text\",\"lines\":%d,\"chars\":%d,\"fast_path_ms\":%.4f,\"generic_ms\":%.4f,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", line_count, log.size(), ms[0], ms[1], same ? "true" : "false");
+    RunCount++;
+}
+
+// Scissor rectangle as the back-ends compute it, truncating
+static ImRect HarnessScissorRect(const ImVec4& clip_rect, const ImVec2& display_pos)
+{
+    return ImRect((float)(int)(clip_rect.x - display_pos.x), (float)(int)(clip_rect.y - display_pos.y), (float)(int)(clip_rect.z - display_pos.x), (float)(int)(clip_rect.w - display_pos.y));
+}
+
+// Walk the unmerged commands alongside the batches. Returns false and prints the first difference.
+static bool HarnessCheckDrawBatches(const ImDrawData* draw_data, bool indices_rebased, const ImVector<ImGuiDrawBatch>& batches, int draw_calls_saved, ImVector<char>* packed)
+{
+    size_t idx_buffer_offset;
+    packed->resize((int)ImGui::CalcDrawDataUploadSize(draw_data, &idx_buffer_offset));
+    ImGui::PackDrawData(draw_data, packed->Data, idx_buffer_offset, indices_rebased);
+    const ImDrawIdx* packed_idx = (const ImDrawIdx*)(packed->Data + idx_buffer_offset);
+
+    ImVector<int> batch_vtx_min, batch_vtx_max;  // Union of the vertex ranges of the commands merged in each batch
+    batch_vtx_min.resize(batches.Size);
+    batch_vtx_max.resize(batches.Size);
+    for (int n = 0; n < batches.Size; n++)
+    {
+        batch_vtx_min[n] = INT_MAX;
+        batch_vtx_max[n] = -1;
+    }
+
+    const char* error = NULL;
+    int cmd_count = 0, batch_n = 0, prev_batch_n = -1;
+    const ImDrawCmd* prev_cmd = NULL;
+    const ImDrawList* prev_list = NULL;
+    unsigned int idx_offset = 0;
+    int vtx_base = 0;
+    for (int list_n = 0; list_n < draw_data->CmdListsCount && !error; list_n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[list_n];
+        unsigned int idx_start = 0;
+        for (int cmd_n = 0; cmd_n < cmd_list->CmdBuffer.Size && !error; cmd_n++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_n];
+            cmd_count++;
+            if (pcmd->UserCallback)
+            {
+                while (batch_n < batches.Size && batches[batch_n].Cmd != pcmd)
+                    batch_n++;
+                if (batch_n == batches.Size)
+                    error = "callback without its own batch";
+                prev_cmd = NULL;
+            }
+            else if (pcmd->ElemCount > 0)
+            {
+                while (batch_n < batches.Size && (batches[batch_n].Cmd->UserCallback || batches[batch_n].IdxOffset + batches[batch_n].ElemCount < idx_offset + pcmd->ElemCount))
+                    batch_n++;
+                const ImGuiDrawBatch* batch = batch_n < batches.Size ? &batches[batch_n] : NULL;
+                if (!batch || batch->IdxOffset > idx_offset)
+                    error = "command indices not inside a batch";
+                else if (batch->TextureId != pcmd->TextureId)
+                    error = "batch texture differs from a merged command";
+                else if (batch->VtxOffset != (indices_rebased ? 0 : vtx_base))
+                    error = "batch base vertex doesn't address the command vertices";
+                else if (prev_cmd && prev_cmd->TextureId == pcmd->TextureId && memcmp(&prev_cmd->ClipRect, &pcmd->ClipRect, sizeof(ImVec4)) == 0 && (indices_rebased || prev_list == cmd_list) && prev_batch_n != batch_n)
+                    error = "adjacent commands with the same texture and clip rectangle not merged";
+                ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+                for (unsigned int i = 0; i < pcmd->ElemCount && !error; i++)
+                {
+                    const int vtx = vtx_base + cmd_list->IdxBuffer[(int)(idx_start + i)];
+                    if ((int)packed_idx[idx_offset + i] + batch->VtxOffset != vtx)
+                        error = "batch draws different vertices than the command";
+                    batch_vtx_min[batch_n] = ImMin(batch_vtx_min[batch_n], vtx);
+                    batch_vtx_max[batch_n] = ImMax(batch_vtx_max[batch_n], vtx);
+                    bounds.Add(cmd_list->VtxBuffer[vtx - vtx_base].pos);
+                }
+                if (!error && memcmp(&batch->ClipRect, &pcmd->ClipRect, sizeof(ImVec4)) != 0)
+                {
+                    bounds.Translate(ImVec2(-draw_data->DisplayPos.x, -draw_data->DisplayPos.y));
+                    if (!HarnessScissorRect(pcmd->ClipRect, draw_data->DisplayPos).Contains(bounds) || !HarnessScissorRect(batch->ClipRect, draw_data->DisplayPos).Contains(bounds))
+                        error = "batch clip rectangle clips a command differently";
+                }
+                prev_cmd = pcmd;
+                prev_list = cmd_list;
+                prev_batch_n = batch_n;
+            }
+            idx_start += pcmd->ElemCount;
+            idx_offset += pcmd->ElemCount;
+        }
+        vtx_base += cmd_list->VtxBuffer.Size;
+    }
+
+    unsigned int batch_idx_end = 0;
+    for (int n = 0; n < batches.Size && !error; n++)
+    {
+        const ImGuiDrawBatch& batch = batches[n];
+        if (batch.IdxOffset != batch_idx_end)
+            error = "batches don't cover the index stream in order";
+        batch_idx_end = batch.IdxOffset + batch.ElemCount;
+        if (batch.Cmd->UserCallback)
+            continue;
+        int vtx_min = INT_MAX, vtx_max = -1;
+        for (unsigned int i = 0; i < batch.ElemCount; i++)
+        {
+            vtx_min = ImMin(vtx_min, (int)packed_idx[batch.IdxOffset + i] + batch.VtxOffset);
+            vtx_max = ImMax(vtx_max, (int)packed_idx[batch.IdxOffset + i] + batch.VtxOffset);
+        }
+        if (vtx_min != batch_vtx_min[n] || vtx_max != batch_vtx_max[n])
+            error = "batch vertex range differs from its commands";
+    }
+    if (!error && batch_idx_end != idx_offset)
+        error = "batches draw a different number of indices";
+    if (!error && batches.Size + draw_calls_saved != cmd_count)
+        error = "saved draw calls don't match the command count";
+    if (error)
+        fprintf(stderr, "draw_batches: %s (%s indices)\n", error, indices_rebased ? "rebased" : "per list");
+    return error == NULL;
+}
+
+static void HarnessDrawBatchesCallback(const ImDrawList*, const ImDrawCmd*)
+{
+}
+
+void ImGuiHarness::RunDrawBatches(int frame_count)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(Context);
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+
+    struct Scene { const char* Name; ImGuiHarnessSceneFn Fn; };
+    static const Scene scenes[] = { { "demo", ImGui::HarnessSceneDemo }, { "dock", ImGui::HarnessSceneDock }, { "tabs", ImGui::HarnessSceneTabs }, { "property_grid", ImGui::HarnessScenePropertyGrid } };
+    ImVector<ImGuiDrawBatch> batches;
+    ImVector<char> packed;
+    bool scenes_ok = true;
+    Report.appendf("%s{\"name\":\"draw_batches\",\"frames\":%d,\"scenes\":[", RunCount > 0 ? ",\n" : "", frame_count);
+    for (int scene_n = 0; scene_n < IM_ARRAYSIZE(scenes); scene_n++)
+    {
+        int commands[2] = { 0, 0 }, draw_calls[2] = { 0, 0 };
+        for (int frame = 0; frame < frame_count; frame++)
+        {
+            ImGui::NewFrame();
+            scenes[scene_n].Fn(NULL);
+            ImGui::Render();
+            const ImDrawData* draw_data = ImGui::GetDrawData();
+            for (int rebased = 0; rebased < 2; rebased++)
+            {
+                if (rebased && !ImGui::CanRebaseDrawDataIndices(draw_data))
+                    continue;
+                const int saved = ImGui::BuildDrawBatches(draw_data, rebased != 0, &batches);
+                scenes_ok &= HarnessCheckDrawBatches(draw_data, rebased != 0, batches, saved, &packed);
+                commands[rebased] += batches.Size + saved;
+                draw_calls[rebased] += batches.Size;
+            }
+        }
+        Report.appendf("%s{\"scene\":\"%s\",\"commands\":%d,\"draw_calls\":%d,\"draw_calls_rebased\":%d}", scene_n > 0 ? "," : "", scenes[scene_n].Name, commands[0], draw_calls[0], draw_calls[1]);
+    }
+    ImGui::NewFrame();
+    ImGui::EndFrame();
+
+    // Known merges: list 0 [A], list 1 [A, B], list 2 [B, callback, B], all in one clip rectangle.
+    // Rebased indices merge across lists: [A A] [B B] [callback] [B]. Per list indices only within a list, where nothing is adjacent: 6 batches.
+    ImDrawList* lists[3];
+    for (int n = 0; n < IM_ARRAYSIZE(lists); n++)
+    {
+        lists[n] = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+        lists[n]->Clear();
+        lists[n]->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(100.0f, 100.0f));
+        lists[n]->PushTextureID(n == 2 ? (ImTextureID)2 : (ImTextureID)1);
+        lists[n]->AddRectFilled(ImVec2(10.0f, 10.0f), ImVec2(20.0f, 20.0f), IM_COL32_WHITE);
+    }
+    lists[1]->PushTextureID((ImTextureID)2);
+    lists[1]->AddRectFilled(ImVec2(30.0f, 10.0f), ImVec2(40.0f, 20.0f), IM_COL32_WHITE);
+    lists[2]->AddCallback(HarnessDrawBatchesCallback, NULL);
+    lists[2]->AddRectFilled(ImVec2(30.0f, 10.0f), ImVec2(40.0f, 20.0f), IM_COL32_WHITE);
+    ImDrawData draw_data;
+    draw_data.Valid = true;
+    draw_data.CmdLists = lists;
+    draw_data.CmdListsCount = IM_ARRAYSIZE(lists);
+    draw_data.TotalVtxCount = draw_data.TotalIdxCount = 0;
+    for (int n = 0; n < IM_ARRAYSIZE(lists); n++)
+    {
+        draw_data.TotalVtxCount += lists[n]->VtxBuffer.Size;
+        draw_data.TotalIdxCount += lists[n]->IdxBuffer.Size;
+    }
+    draw_data.DisplayPos = ImVec2(0.0f, 0.0f);
+    draw_data.DisplaySize = ImVec2(100.0f, 100.0f);
+    bool known_ok = true;
+    for (int rebased = 0; rebased < 2; rebased++)
+    {
+        const int saved = ImGui::BuildDrawBatches(&draw_data, rebased != 0, &batches);
+        known_ok &= HarnessCheckDrawBatches(&draw_data, rebased != 0, batches, saved, &packed);
+        known_ok &= (batches.Size == (rebased ? 4 : 6));
+        known_ok &= (!rebased || (batches[0].ElemCount == 12 && batches[0].TextureId == (ImTextureID)1 && batches[1].ElemCount == 12 && batches[1].TextureId == (ImTextureID)2));
+    }
+    draw_data.CmdLists = NULL;
+    for (int n = 0; n < IM_ARRAYSIZE(lists); n++)
+        IM_DELETE(lists[n]);
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Check("draw_batches: batches of the scenes draw the same commands, vertex ranges and clipping as the unmerged stream", scenes_ok);
+    Check("draw_batches: known adjacent commands are merged", known_ok);
+    Report.appendf("],\"passed\":%s}", scenes_ok && known_ok ? "true" : "false");
+    RunCount++;
+}
+
+// Stands in for a GPU buffer: which fence last wrote every byte, 0 for bytes not written since the last discard
+struct HarnessFakeGpuBuffer
+{
+    ImVector<ImU64> Owners;
+    size_t          PrevEnd;        // End of the previous upload, to tell reuse from wrap
+    int             Overwrites;     // Bytes written while still in use, counted once per upload
+
+    HarnessFakeGpuBuffer() { PrevEnd = 0; Overwrites = 0; }
+
+    // Apply the plan like a back-end would and classify it
+    const char* Upload(const ImGuiUploadPlan& plan, bool use_fences, ImU64 fence, ImU64 completed_fence)
+    {
+        const size_t prev_size = (size_t)Owners.Size;
+        if (plan.Recreate || plan.Discard)
+        {
+            Owners.resize((int)plan.BufferSize);
+            memset(Owners.Data, 0, (size_t)Owners.Size * sizeof(ImU64));
+        }
+        if (plan.Offset % 16 != 0 || plan.Offset + plan.Size > (size_t)Owners.Size)
+            return "out_of_range";
+        for (size_t n = plan.Offset; n < plan.Offset + plan.Size; n++)
+        {
+            // With fences a byte is in use until its fence completes, without them until the next discard
+            if (use_fences ? Owners[(int)n] > completed_fence : Owners[(int)n] != 0)
+            {
+                Overwrites++;
+                break;
+            }
+        }
+        for (size_t n = plan.Offset; n < plan.Offset + plan.Size; n++)
+            Owners[(int)n] = fence;
+        const size_t prev_end = PrevEnd;
+        PrevEnd = plan.Offset + plan.Size;
+        if (plan.Recreate)
+            return plan.BufferSize > prev_size ? "grow" : "shrink";
+        return plan.Offset < prev_end ? "wrap" : "reuse";
+    }
+};
+
+struct HarnessUploadStep
+{
+    size_t      Size;
+    ImU64       CompletedFence;     // Fences mode only
+    const char* Action;
+    size_t      BufferSize;
+    size_t      Offset;
+};
+
+void ImGuiHarness::RunUploadPlanner(int random_frame_count)
+{
+    // 16 byte alignment, 4 KB minimum, 3 uploads of slack
+    static const HarnessUploadStep discard_steps[] =
+    {
+        { 1000, 0, "grow",   4096,  0 },
+        { 1000, 0, "reuse",  4096,  1008 },
+        { 1000, 0, "reuse",  4096,  2016 },
+        { 1000, 0, "reuse",  4096,  3024 },
+        { 1000, 0, "wrap",   4096,  0 },        // Discard
+        { 5000, 0, "grow",   16384, 0 },
+        { 100,  0, "reuse",  16384, 5008 },
+        { 100,  0, "reuse",  16384, 5120 },     // 8th upload: the window saw 5000, no shrink
+        { 100,  0, "reuse",  16384, 5232 },
+        { 100,  0, "reuse",  16384, 5344 },
+        { 100,  0, "reuse",  16384, 5456 },
+        { 100,  0, "reuse",  16384, 5568 },
+        { 100,  0, "reuse",  16384, 5680 },
+        { 100,  0, "reuse",  16384, 5792 },
+        { 100,  0, "reuse",  16384, 5904 },
+        { 100,  0, "shrink", 4096,  0 },        // 16th: 8 uploads of 100, 4 KB is enough
+        { 100,  0, "reuse",  4096,  112 },
+    };
+    static const HarnessUploadStep fence_steps[] =
+    {
+        { 1300, 0, "grow",   4096,  0 },
+        { 1300, 0, "reuse",  4096,  1312 },
+        { 1300, 0, "reuse",  4096,  2624 },
+        { 1300, 0, "grow",   8192,  0 },        // The GPU still reads fences 1 to 3, nowhere to wrap to
+        { 1300, 3, "reuse",  8192,  1312 },
+        { 1300, 3, "reuse",  8192,  2624 },
+        { 1300, 3, "reuse",  8192,  3936 },
+        { 1300, 3, "reuse",  8192,  5248 },
+        { 1300, 3, "reuse",  8192,  6560 },
+        { 1300, 4, "wrap",   8192,  0 },        // Fence 4 done: [0, 1300) is free again
+        { 1300, 4, "grow",   16384, 0 },        // Fence 5 at 1312 still pending
+    };
+
+    bool scripted_ok = true;
+    for (int mode = 0; mode < 2; mode++)
+    {
+        const bool use_fences = (mode == 1);
+        const HarnessUploadStep* steps = use_fences ? fence_steps : discard_steps;
+        const int step_count = use_fences ? IM_ARRAYSIZE(fence_steps) : IM_ARRAYSIZE(discard_steps);
+        ImGuiUploadRing ring;
+        ring.MinCapacity = 4096;
+        ring.UseFences = use_fences;
+        ring.ShrinkAfter = use_fences ? 0 : 8;
+        HarnessFakeGpuBuffer gpu;
+        for (int n = 0; n < step_count; n++)
+        {
+            const HarnessUploadStep& step = steps[n];
+            const ImU64 fence = (ImU64)n + 1;
+            const ImGuiUploadPlan plan = ring.Plan(step.Size, 16, step.CompletedFence);
+            const char* action = gpu.Upload(plan, use_fences, use_fences ? fence : 1, step.CompletedFence);
+            if (use_fences)
+                ring.Submit(fence);
+            if (strcmp(action, step.Action) != 0 || plan.BufferSize != step.BufferSize || plan.Offset != step.Offset)
+            {
+                fprintf(stderr, "upload_planner: %s step %d planned %s, buffer %d, offset %d\n", use_fences ? "fences" : "discard", n, action, (int)plan.BufferSize, (int)plan.Offset);
+                scripted_ok = false;
+            }
+        }
+        scripted_ok &= (gpu.Overwrites == 0);
+    }
+
+    // Random sizes in three phases (small, large, small again) and a GPU lagging 0 to 3 fences behind
+    int overwrites[2] = { 0, 0 }, recreations[2] = { 0, 0 }, shrinks[2] = { 0, 0 };
+    size_t peak_capacity[2] = { 0, 0 }, final_capacity[2] = { 0, 0 };
+    for (int mode = 0; mode < 2; mode++)
+    {
+        const bool use_fences = (mode == 1);
+        ImGuiUploadRing ring;
+        ring.MinCapacity = 4096;
+        ring.UseFences = use_fences;
+        ring.ShrinkAfter = 300;
+        HarnessFakeGpuBuffer gpu;
+        ImU64 fence = 0, completed_fence = 0;
+        unsigned int seed = 1;
+        for (int frame = 0; frame < random_frame_count; frame++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            while (fence - completed_fence > (seed >> 16) % 4)
+                completed_fence++;
+            const bool large = (frame >= random_frame_count / 3 && frame < random_frame_count * 2 / 3);
+            const size_t size = (seed >> 8) % 3000 + (large ? 60000 : 0);
+            const ImGuiUploadPlan plan = ring.Plan(size, 16, completed_fence);
+            const size_t prev_capacity = (size_t)gpu.Owners.Size;
+            if (strcmp(gpu.Upload(plan, use_fences, use_fences ? fence + 1 : 1, completed_fence), "out_of_range") == 0)
+                overwrites[mode]++;
+            if (use_fences)
+                ring.Submit(++fence);
+            shrinks[mode] += (plan.Recreate && plan.BufferSize < prev_capacity) ? 1 : 0;
+            if (ring.Capacity > peak_capacity[mode])
+                peak_capacity[mode] = ring.Capacity;
+        }
+        overwrites[mode] += gpu.Overwrites;
+        recreations[mode] = ring.Recreations;
+        final_capacity[mode] = ring.Capacity;
+    }
+
+    Check("upload_planner: scripted uploads get the expected action, buffer size and offset", scripted_ok);
+    const bool random_ok = Check("upload_planner: no upload overwrites data the GPU may still read", overwrites[0] == 0 && overwrites[1] == 0);
+    const bool shrink_ok = random_frame_count < 3000 || Check("upload_planner: the buffer shrinks back after the large phase", shrinks[0] > 0 && shrinks[1] > 0 && final_capacity[0] < peak_capacity[0] && final_capacity[1] < peak_capacity[1]);
+    Report.appendf("%s{\"name\":\"upload_planner\",\"random_frames\":%d,\"discard\":{\"recreations\":%d,\"shrinks\":%d,\"peak_capacity\":%d,\"final_capacity\":%d},\"fences\":{\"recreations\":%d,\"shrinks\":%d,\"peak_capacity\":%d,\"final_capacity\":%d},\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", random_frame_count, recreations[0], shrinks[0], (int)peak_capacity[0], (int)final_capacity[0], recreations[1], shrinks[1], (int)peak_capacity[1], (int)final_capacity[1],
+        scripted_ok && random_ok && shrink_ok ? "true" : "false");
+    RunCount++;
+}
+
+// Tessellation heavy, and a scratch ImVector grown from empty so every job makes the same heap allocations on whatever thread runs it
+static void HarnessDrawJob(ImDrawList* draw_list, void* user_data)
+{
+    const int job_index = *(const int*)user_data;
+    ImVector<ImVec2> points;
+    for (int n = 0; n < 200; n++)
+        points.push_back(ImVec2(20.0f + n * 5.0f, 100.0f + job_index * 8.0f + sinf(n * 0.2f + job_index) * 30.0f));
+    draw_list->AddPolyline(points.Data, points.Size, IM_COL32(255, 200, 0, 255), false, 2.5f);
+    for (int n = 0; n < 40; n++)
+        draw_list->AddCircleFilled(ImVec2(30.0f + n * 25.0f, 60.0f + job_index * 8.0f), 10.0f, IM_COL32(0, 160, 255, 200), 24);
+    draw_list->AddText(ImVec2(10.0f, job_index * 8.0f), IM_COL32_WHITE, "draw job output, layered above the window contents");
+}
+
+struct HarnessDrawJobsScene
+{
+    int     JobCount;
+};
+
+static void HarnessSceneDrawJobs(void* user_data)
+{
+    const HarnessDrawJobsScene* scene = (const HarnessDrawJobsScene*)user_data;
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Draw jobs", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+    for (int n = 0; n < scene->JobCount; n++)
+        ImGui::AddDrawJob(HarnessDrawJob, &n, sizeof(n));
+    ImGui::End();
+}
+
+// FNV-1a over the vertices, indices and commands
+static ImU64 HarnessHashDrawData(const ImDrawData* draw_data)
+{
+    ImU64 hash = 14695981039346656037ULL;
+    for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+        const unsigned char* blocks[2] = { (const unsigned char*)draw_list->VtxBuffer.Data, (const unsigned char*)draw_list->IdxBuffer.Data };
+        const size_t sizes[2] = { (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert), (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx) };
+        for (int block_n = 0; block_n < 2; block_n++)
+            for (size_t n = 0; n < sizes[block_n]; n++)
+                hash = (hash ^ blocks[block_n][n]) * 1099511628211ULL;
+        for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd& cmd = draw_list->CmdBuffer[cmd_n];
+            hash = (hash ^ cmd.ElemCount) * 1099511628211ULL;
+            hash = (hash ^ (ImU64)(intptr_t)cmd.TextureId) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+// io.DrawJobsRunner spreading the jobs over ThreadCount threads, the calling one included. Threads are started per call, close enough for measuring scaling.
+struct HarnessThreadedRunner
+{
+    int     ThreadCount;
+};
+
+static void HarnessRunJobsThreaded(int job_count, void (*run_job)(int job_index, void* jobs), void* jobs, void* user_data)
+{
+    const int thread_count = ImMin(ImMin(((const HarnessThreadedRunner*)user_data)->ThreadCount, 16), job_count);
+    std::atomic<int> next_job(0);
+    struct Worker
+    {
+        static void Run(std::atomic<int>* next_job, int job_count, void (*run_job)(int, void*), void* jobs)
+        {
+            for (int n = (*next_job)++; n < job_count; n = (*next_job)++)
+                run_job(n, jobs);
+        }
+    };
+    std::thread threads[15];
+    for (int n = 0; n < thread_count - 1; n++)
+        threads[n] = std::thread(Worker::Run, &next_job, job_count, run_job, jobs);
+    Worker::Run(&next_job, job_count, run_job, jobs);
+    for (int n = 0; n < thread_count - 1; n++)
+        threads[n].join();
+}
+
+// SetFrameAllocatorFunctions() allocator taking every request from the heap and counting the bytes
+struct HarnessFrameAllocator
+{
+    ImVector<void*> Allocations;
+    size_t          Requested;
+    int             Resets;
+};
+
+static void* HarnessFrameAlloc(size_t sz, void* user_data)
+{
+    HarnessFrameAllocator* allocator = (HarnessFrameAllocator*)user_data;
+    allocator->Requested += sz;
+    allocator->Allocations.push_back(malloc(sz));
+    return allocator->Allocations.back();
+}
+
+static void HarnessFrameReset(void* user_data)
+{
+    HarnessFrameAllocator* allocator = (HarnessFrameAllocator*)user_data;
+    for (int n = 0; n < allocator->Allocations.Size; n++)
+        free(allocator->Allocations[n]);
+    allocator->Allocations.resize(0);
+    allocator->Resets++;
+}
+
+// Empty frame taking bytes from MemAllocFrame() in 1 KB pieces
+static void HarnessFrameArenaFrame(size_t bytes)
+{
+    ImGui::NewFrame();
+    for (size_t n = 0; n < bytes; n += 1024)
+        memset(ImGui::MemAllocFrame(1024), 0, 1024);
+    ImGui::Render();
+}
+
+void ImGuiHarness::RunFrameArena(int shrink_after)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = HarnessCreateContext(Context);
+    ImGuiContext& g = *ctx;
+    g.FrameArena.ShrinkAfter = shrink_after;
+
+    // One large frame grows the block, the window it falls in keeps it, then a whole window of small frames shrinks it
+    const size_t large_bytes = 4 << 20, small_bytes = 16 << 10;
+    HarnessFrameArenaFrame(large_bytes);
+    HarnessFrameArenaFrame(small_bytes);
+    const size_t grown_size = g.FrameArena.Size;
+    bool same = Check("frame_arena: io.MetricsFrameArenaBytes counts the bytes of the last frame", g.IO.MetricsFrameArenaBytes == (int)large_bytes);
+    bool kept = true;
+    for (int n = 0; n < shrink_after - 2; n++)
+    {
+        HarnessFrameArenaFrame(small_bytes);
+        kept &= g.FrameArena.Size == grown_size;
+    }
+    for (int n = 0; n < shrink_after; n++)
+        HarnessFrameArenaFrame(small_bytes);
+    const size_t shrunk_size = g.FrameArena.Size;
+    const char* shrunk_data = g.FrameArena.Data;
+    same &= Check("frame_arena: the block is kept through the window of the large frame", grown_size >= large_bytes && kept);
+    same &= Check("frame_arena: the block shrinks after a window of small frames", shrunk_size >= small_bytes && shrunk_size * 4 <= grown_size);
+    bool steady = true;
+    for (int n = 0; n < shrink_after * 2; n++)
+    {
+        HarnessFrameArenaFrame(small_bytes);
+        steady &= g.FrameArena.Data == shrunk_data && g.FrameArena.Spilled.Size == 0 && g.IO.MetricsFrameArenaBytes == (int)small_bytes;
+    }
+    same &= Check("frame_arena: steady small frames keep the shrunk block", steady);
+
+    // The same metric with the allocator hooks replacing the arena
+    HarnessFrameAllocator allocator;
+    allocator.Requested = 0;
+    allocator.Resets = 0;
+    ImGui::SetFrameAllocatorFunctions(HarnessFrameAlloc, HarnessFrameReset, &allocator);
+    HarnessFrameArenaFrame(large_bytes);
+    HarnessFrameArenaFrame(small_bytes);
+    same &= Check("frame_arena: io.MetricsFrameArenaBytes counts the bytes of a custom frame allocator",
+        g.IO.MetricsFrameArenaBytes == (int)large_bytes && allocator.Requested == large_bytes + small_bytes && allocator.Resets == 2);
+    ImGui::NewFrame();
+    ImGui::Render();
+    ImGui::SetFrameAllocatorFunctions(NULL, NULL);
+    HarnessFrameReset(&allocator);
+
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Report.appendf("%s{\"name\":\"frame_arena\",\"shrink_after\":%d,\"grown_bytes\":%d,\"shrunk_bytes\":%d,\"passed\":%s}",
+        RunCount > 0 ? ",\n" : "", shrink_after, (int)grown_size, (int)shrunk_size, same ? "true" : "false");
+    RunCount++;
+}
+
+void ImGuiHarness::RunDrawJobsThreads(int job_count, int frame_count)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(Context);
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    void (*backup_runner)(int, void (*)(int, void*), void*, void*) = io.DrawJobsRunner;
+    void* backup_runner_user_data = io.DrawJobsRunnerUserData;
+
+    HarnessDrawJobsScene scene = { job_count };
+    HarnessThreadedRunner runner = { 1 };
+    static const int thread_counts[] = { 0, 1, 2, 4, 8, 16 };  // 0 is the serial loop of Render(), no runner
+    ImVector<ImU64> serial_hashes;
+    int serial_allocations = -1;
+    bool same_draw_data = true, same_allocations = true;
+    Report.appendf("%s{\"name\":\"draw_jobs_threads\",\"jobs\":%d,\"frames\":%d,\"hardware_threads\":%d,\"runs\":[", RunCount > 0 ? ",\n" : "",
+        job_count, frame_count, (int)std::thread::hardware_concurrency());
+    for (int run_n = 0; run_n < IM_ARRAYSIZE(thread_counts); run_n++)
+    {
+        runner.ThreadCount = thread_counts[run_n];
+        io.DrawJobsRunner = runner.ThreadCount > 0 ? HarnessRunJobsThreaded : NULL;
+        io.DrawJobsRunnerUserData = &runner;
+
+        // Warm up so the draw lists have grown and every measured frame makes the same allocations
+        for (int n = 0; n < 5; n++)
+        {
+            ImGui::NewFrame();
+            HarnessSceneDrawJobs(&scene);
+            ImGui::Render();
+        }
+        double render_ms = 0.0;
+        int allocations_per_frame = INT_MAX;  // Lowest count, other frames add a few unrelated allocations depending on the frame number
+        for (int frame = 0; frame < frame_count; frame++)
+        {
+            ImGui::NewFrame();
+            allocations_per_frame = ImMin(allocations_per_frame, io.MetricsAllocations);
+            HarnessSceneDrawJobs(&scene);
+            std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+            ImGui::Render();
+            render_ms += HarnessElapsedMs(t0);
+            const ImU64 hash = HarnessHashDrawData(ImGui::GetDrawData());
+            if (run_n == 0)
+                serial_hashes.push_back(hash);
+            else
+                same_draw_data &= hash == serial_hashes[frame];
+        }
+        if (run_n == 0)
+            serial_allocations = allocations_per_frame;
+        same_allocations &= allocations_per_frame == serial_allocations;
+        Report.appendf("%s{\"threads\":%d,\"render_ms\":%.4f,\"allocations_per_frame\":%d}", run_n > 0 ? "," : "", runner.ThreadCount, render_ms / frame_count, allocations_per_frame);
+    }
+    ImGui::NewFrame();
+    ImGui::EndFrame();
+    io.DrawJobsRunner = backup_runner;
+    io.DrawJobsRunnerUserData = backup_runner_user_data;
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+
+    Check("draw_jobs_threads: the draw data matches the serial run for every thread count", same_draw_data);
+    Check("draw_jobs_threads: io.MetricsAllocations matches the serial run for every thread count", same_allocations);
+    Report.appendf("],\"passed\":%s}", same_draw_data && same_allocations ? "true" : "false");
+    RunCount++;
+}
+
+void ImGuiHarness::RunTextFilter(int string_count)
+{
+    // Outliner-like names, the same on every run
+    static const char* words[] = { "Entity", "Mesh", "Light", "Camera", "Prop", "Tree", "Rock", "Enemy", "Spawner", "Trigger" };
+    ImGuiTextList list;
+    unsigned int seed = 12345;
+    for (int n = 0; n < string_count; n++)
+    {
+        char name[64];
+        seed = seed * 1664525u + 1013904223u;
+        ImFormatString(name, IM_ARRAYSIZE(name), "%s_%s_%u", words[(seed >> 8) % IM_ARRAYSIZE(words)], words[(seed >> 16) % IM_ARRAYSIZE(words)], seed % 100000);
+        list.Add(name);
+    }
+
+    Report.appendf("%s{\"name\":\"text_filter\",\"strings\":%d,\"filters\":[", RunCount > 0 ? ",\n" : "", string_count);
+    static const char* filters[] = { "tree", "rock,-enemy", "spawner_light", "zz", "e", "-rock", "LIGHT_t,-_1", "trigger_spawner_9999" };
+    ImVector<int> expected, indices;
+    HarnessThreadedRunner runner = { 4 };
+    bool same_indices = true;
+    for (int filter_n = 0; filter_n < IM_ARRAYSIZE(filters); filter_n++)
+    {
+        ImGuiTextFilter filter(filters[filter_n]);
+        expected.resize(0);
+        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        for (int n = 0; n < list.Size(); n++)
+            if (filter.PassFilter(list.Buf.Data + list.Offsets[n], list.Buf.Data + list.Offsets[n + 1]))
+                expected.push_back(n);
+        const double pass_filter_ms = HarnessElapsedMs(t0);
+        const int passed = expected.Size;
+        indices.resize(0);
+        t0 = std::chrono::high_resolution_clock::now();
+        list.Filter(filter, &indices);
+        const double pass_filter_many_ms = HarnessElapsedMs(t0);
+        same_indices &= Check("text_filter: PassFilterMany() returns the indices PassFilter() passes", HarnessSameVector(indices, expected));
+        indices.resize(0);
+        list.Filter(filter, &indices, HarnessRunJobsThreaded, &runner);
+        same_indices &= Check("text_filter: PassFilterMany() over threads returns the indices PassFilter() passes", HarnessSameVector(indices, expected));
+        Report.appendf("%s{\"filter\":\"%s\",\"passed\":%d,\"pass_filter_ms\":%.4f,\"pass_filter_many_ms\":%.4f}", filter_n > 0 ? "," : "", filters[filter_n], passed, pass_filter_ms, pass_filter_many_ms);
+    }
+    Report.appendf("],\"passed\":%s}", same_indices ? "true" : "false");
+    RunCount++;
+}
+
+// Brute force scoring for ImGuiFuzzyIndex: the subsequence match is found on the original text and the word start bonuses recomputed for it
+static int HarnessFuzzyScore(const char* pattern, const char* text, int len)
+{
+    char p[256];
+    int pattern_len = 0;
+    for (; *pattern; pattern++)
+        if (*pattern != ' ')
+            p[pattern_len++] = (char)tolower((unsigned char)*pattern);
+    if (pattern_len == 0 || len < pattern_len)
+        return -1;
+
+    // Leftmost end, then the latest start for it
+    int end = -1;
+    for (int n = 0, matched = 0; n < len && end < 0; n++)
+        if (tolower((unsigned char)text[n]) == p[matched] && ++matched == pattern_len)
+            end = n;
+    if (end < 0)
+        return -1;
+    int start = end;
+    for (int n = end, matched = pattern_len; matched > 0; n--)
+        if (tolower((unsigned char)text[n]) == p[matched - 1])
+        {
+            matched--;
+            start = n;
+        }
+
+    int score = 0, run_bonus = 0;
+    bool in_run = false;
+    for (int n = start, matched = 0; matched < pattern_len; n++)
+    {
+        if (tolower((unsigned char)text[n]) != p[matched])
+        {
+            score -= in_run ? 3 : 1;
+            in_run = false;
+            continue;
+        }
+        const char prev = n > 0 ? text[n - 1] : 0;
+        int bonus = 0;
+        if (n == 0 || prev == '/' || prev == '\\')
+            bonus = 10;
+        else if (strchr("_-.: ", prev) != NULL)
+            bonus = 8;
+        else if (isupper((unsigned char)text[n]) && (islower((unsigned char)prev) || isdigit((unsigned char)prev)))
+            bonus = 7;
+        run_bonus = in_run ? ImMax(run_bonus, bonus) : bonus;
+        score += 16 + run_bonus + (in_run ? 4 : 0) + (matched == 0 ? bonus : 0);
+        in_run = true;
+        matched++;
+    }
+    return score;
+}
+
+struct HarnessFuzzyResult
+{
+    int     Index;
+    int     Score;
+    int     Length;
+};
+
+// Best first: higher score, then shorter, then added first
+static int HarnessCompareFuzzyResults(const void* lhs, const void* rhs)
+{
+    const HarnessFuzzyResult* a = (const HarnessFuzzyResult*)lhs;
+    const HarnessFuzzyResult* b = (const HarnessFuzzyResult*)rhs;
+    if (a->Score != b->Score)
+        return b->Score - a->Score;
+    if (a->Length != b->Length)
+        return a->Length - b->Length;
+    return a->Index - b->Index;
+}
+
+static bool HarnessSameFuzzyMatches(const ImGuiFuzzyMatch* a, int a_count, const ImGuiFuzzyMatch* b, int b_count)
+{
+    if (a_count != b_count)
+        return false;
+    for (int n = 0; n < a_count; n++)
+        if (a[n].Index != b[n].Index || a[n].Score != b[n].Score)
+            return false;
+    return true;
+}
+
+void ImGuiHarness::RunFuzzySearch(int candidate_count)
+{
+    static const char* folders[] = { "Textures", "Models", "Materials", "Sounds", "Prefabs", "Scripts", "Shaders", "Animations" };
+    static const char* names[] = { "Rock", "Tree", "Player", "Enemy", "Door", "Crate", "Terrain", "Water", "Light", "Camera" };
+    static const char* suffixes[] = { "albedo.dds", "normal.dds", "lod0.fbx", "lod1.fbx", "controller.cs", "mat", "prefab", "idle.anim" };
+    ImGuiFuzzyIndex index;
+    ImGuiTextBuffer path;
+    ImGuiTextList paths;
+    unsigned int seed = 12345;
+    for (int n = 0; n < candidate_count; n++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const char* name = names[(seed >> 12) % IM_ARRAYSIZE(names)];
+        path.clear();
+        path.appendf("Assets/%s/%s/%s%u/%s_%s", folders[(seed >> 8) % IM_ARRAYSIZE(folders)], name, name, (seed >> 4) % 16, name, suffixes[(seed >> 16) % IM_ARRAYSIZE(suffixes)]);
+        paths.Add(path.begin(), path.end());
+    }
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < candidate_count; n++)
+        index.Add(paths.Buf.Data + paths.Offsets[n], paths.Buf.Data + paths.Offsets[n + 1]);
+    const double build_ms = HarnessElapsedMs(t0);
+
+    Report.appendf("%s{\"name\":\"fuzzy_search\",\"candidates\":%d,\"build_ms\":%.4f,\"keystrokes\":[", RunCount > 0 ? ",\n" : "", candidate_count, build_ms);
+    const char* query = "rockalbedo";
+    char pattern[16];
+    ImGuiFuzzyMatch matches[50], scratch_matches[50];
+    ImVector<HarnessFuzzyResult> brute_force;
+    bool same_narrowed = true, same_brute_force = true;
+    int count = index.Search("", matches, IM_ARRAYSIZE(matches));
+    bool empty_ok = count == ImMin(IM_ARRAYSIZE(matches), candidate_count);
+    for (int n = 0; n < count; n++)
+        empty_ok &= matches[n].Index == n && matches[n].Score == 0;
+    for (int len = 1; query[len - 1]; len++)
+    {
+        memcpy(pattern, query, (size_t)len);
+        pattern[len] = 0;
+        t0 = std::chrono::high_resolution_clock::now();
+        count = index.Search(pattern, matches, IM_ARRAYSIZE(matches));
+        const double narrowed_ms = HarnessElapsedMs(t0);
+        const int narrowed_candidates = index.LastMatches.Size;
+        index.LastValid = false;
+        t0 = std::chrono::high_resolution_clock::now();
+        const int scratch_count = index.Search(pattern, scratch_matches, IM_ARRAYSIZE(scratch_matches));
+        const double scratch_ms = HarnessElapsedMs(t0);
+        same_narrowed &= HarnessSameFuzzyMatches(matches, count, scratch_matches, scratch_count) && index.LastMatches.Size == narrowed_candidates;
+        Report.appendf("%s{\"pattern\":\"%s\",\"matches\":%d,\"ms\":%.4f,\"from_scratch_ms\":%.4f}", len > 1 ? "," : "", pattern, index.LastMatches.Size, narrowed_ms, scratch_ms);
+    }
+
+    // Top 50 against scoring and sorting every candidate, including patterns that don't extend the previous one (no narrowing)
+    static const char* patterns[] = { "rock", "rockalbedo", "rockalb", "Rock Lod", "TEX/pl", "mt", "a", "zzz", "camera15/camera_idle.anim" };
+    for (int pattern_n = 0; pattern_n < IM_ARRAYSIZE(patterns); pattern_n++)
+    {
+        count = index.Search(patterns[pattern_n], matches, IM_ARRAYSIZE(matches));
+        brute_force.resize(0);
+        for (int n = 0; n < candidate_count; n++)
+        {
+            HarnessFuzzyResult result;
+            result.Index = n;
+            result.Length = paths.Offsets[n + 1] - paths.Offsets[n];
+            result.Score = HarnessFuzzyScore(patterns[pattern_n], paths.Buf.Data + paths.Offsets[n], result.Length);
+            if (result.Score >= 0)
+                brute_force.push_back(result);
+        }
+        qsort(brute_force.Data, (size_t)brute_force.Size, sizeof(HarnessFuzzyResult), HarnessCompareFuzzyResults);
+        bool same = count == ImMin(brute_force.Size, IM_ARRAYSIZE(matches));
+        for (int n = 0; n < count && same; n++)
+            same = matches[n].Index == brute_force[n].Index && matches[n].Score == brute_force[n].Score;
+        if (!same)
+            fprintf(stderr, "fuzzy_search: \"%s\" differs from brute force (%d matches, %d expected)\n", patterns[pattern_n], count, ImMin(brute_force.Size, IM_ARRAYSIZE(matches)));
+        same_brute_force &= same;
+    }
+
+    // No candidates at all
+    ImGuiFuzzyIndex empty_index;
+    empty_ok &= empty_index.Search("", matches, IM_ARRAYSIZE(matches)) == 0 && empty_index.Search("rock", matches, IM_ARRAYSIZE(matches)) == 0 && empty_index.Search("rocks", matches, IM_ARRAYSIZE(matches)) == 0;
+
+    Check("fuzzy_search: narrowed searches return the matches of searches from scratch", same_narrowed);
+    Check("fuzzy_search: the best matches and their order match brute force scoring and sorting", same_brute_force);
+    Check("fuzzy_search: empty patterns and empty indices", empty_ok);
+    Report.appendf("],\"passed\":%s}", same_narrowed && same_brute_force && empty_ok ? "true" : "false");
+    RunCount++;
+}
+
+// Row-major with row vectors like ImGuizmo, r = a * b (r must not alias a or b)
+static void HarnessMatrixMultiply(const float* a, const float* b, float* r)
+{
+    for (int row = 0; row < 4; row++)
+        for (int col = 0; col < 4; col++)
+            r[row * 4 + col] = a[row * 4] * b[col] + a[row * 4 + 1] * b[4 + col] + a[row * 4 + 2] * b[8 + col] + a[row * 4 + 3] * b[12 + col];
+}
+
+// Rotated about z and placed in pairs mirrored through the origin, so the center of the selection is exactly the origin (and the first one is there when count is odd)
+static void HarnessGizmoMatrices(ImVector<float>* matrices, int count)
+{
+    matrices->resize(count * 16);
+    unsigned int seed = 12345;
+    for (int n = 0; n < count; n++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const float angle = (float)(seed % 6283) * 0.001f;
+        float* m = matrices->Data + n * 16;
+        const float* pair = m - 16;
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        if ((count & 1) == 0 ? (n & 1) != 0 : (n > 0 && (n & 1) == 0))
+        {
+            x = -pair[12]; y = -pair[13]; z = -pair[14];
+        }
+        else if ((count & 1) == 0 || n > 0)
+        {
+            x = (float)((seed >> 8) % 2000) * 0.001f - 1.0f;
+            y = (float)((seed >> 12) % 2000) * 0.001f - 1.0f;
+            z = (float)((seed >> 16) % 2000) * 0.001f - 1.0f;
+        }
+        const float c = cosf(angle), s = sinf(angle);
+        const float mat[16] = { c, s, 0.0f, 0.0f, -s, c, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, x, y, z, 1.0f };
+        memcpy(m, mat, sizeof(mat));
+    }
+}
+
+// One frame of a drag starting on the center of the display: pressed on frame 1, moved by (6,4) pixels per frame after it, released on the last frame
+static void HarnessGizmoDragInput(int frame, int frame_count)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    const float moved = (float)ImMax(frame - 1, 0);
+    io.MousePos = ImVec2(io.DisplaySize.x * 0.5f + 1.0f + moved * 6.0f, io.DisplaySize.y * 0.5f + 1.0f + moved * 4.0f);
+    io.MouseDown[0] = frame >= 1 && frame < frame_count - 1;
+}
+
+void ImGuiHarness::RunGizmoManipulateMany(int matrix_count, int frame_count)
+{
+    ImGuiContext* backup_context = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(Context);
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+
+    // Camera 10 units behind the origin looking down +z, left-handed perspective
+    const float aspect = io.DisplaySize.x / io.DisplaySize.y, focal = 1.0f / tanf(0.5f), z_near = 0.1f, z_far = 100.0f;
+    const float view[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 10.0f, 1.0f };
+    const float projection[16] = { focal / aspect, 0.0f, 0.0f, 0.0f, 0.0f, focal, 0.0f, 0.0f, 0.0f, 0.0f, z_far / (z_far - z_near), 1.0f, 0.0f, 0.0f, -z_near * z_far / (z_far - z_near), 0.0f };
+
+    ImGuizmo::Context* gizmo_many = ImGuizmo::CreateContext();
+    ImGuizmo::Context* gizmo_pivot = ImGuizmo::CreateContext();
+
+    struct GizmoCase { const char* Name; ImGuizmo::OPERATION Operation; ImGuizmo::PIVOT Pivot; };
+    static const GizmoCase cases[] = { { "translate_center", ImGuizmo::TRANSLATE, ImGuizmo::PIVOT_CENTER }, { "translate_individual", ImGuizmo::TRANSLATE, ImGuizmo::PIVOT_INDIVIDUAL }, { "scale_center", ImGuizmo::SCALE, ImGuizmo::PIVOT_CENTER }, { "scale_individual", ImGuizmo::SCALE, ImGuizmo::PIVOT_INDIVIDUAL } };
+    Report.appendf("%s{\"name\":\"gizmo_manipulate_many\",\"matrices\":%d,\"frames\":%d,\"cases\":[", RunCount > 0 ? ",\n" : "", matrix_count, frame_count);
+    ImVector<float> source, matrices, reference;
+    for (int case_n = 0; case_n < IM_ARRAYSIZE(cases); case_n++)
+    {
+        const GizmoCase& gizmo_case = cases[case_n];
+        bool same = true, single_same = true;
+        float max_error = 0.0f;
+        double many_ms = 0.0, per_object_ms = 0.0;
+        for (int count_n = 0; count_n < 2; count_n++)
+        {
+            // A single matrix first, ManipulateMany() has to behave exactly like Manipulate() on it. Both in LOCAL mode, a WORLD scale gizmo drops the rotation of the matrix it edits.
+            const int count = count_n == 0 ? 1 : matrix_count;
+            const ImGuizmo::MODE mode = count_n == 0 ? ImGuizmo::LOCAL : ImGuizmo::WORLD;
+            HarnessGizmoMatrices(&source, count);
+            matrices = source;
+            reference = source;
+            float pivot[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+            for (int frame = 0; frame < frame_count; frame++)
+            {
+                HarnessGizmoDragInput(frame, frame_count);
+                ImGui::NewFrame();
+                ImGuizmo::SetContext(gizmo_many);
+                ImGuizmo::BeginFrame();
+                ImGuizmo::SetRect(0.0f, 0.0f, io.DisplaySize.x, io.DisplaySize.y);
+                std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+                ImGuizmo::ManipulateMany(view, projection, gizmo_case.Operation, mode, gizmo_case.Pivot, matrices.Data, count);
+                if (count_n == 0)
+                {
+                    ImGui::EndFrame();
+                    continue;
+                }
+                many_ms += HarnessElapsedMs(t0);
+
+                // The pivot starts as the identity at the origin, the matrices are source * pivot for PIVOT_CENTER. PIVOT_INDIVIDUAL keeps the
+                // positions and only adds the translation of the pivot.
+                ImGuizmo::SetContext(gizmo_pivot);
+                ImGuizmo::BeginFrame();
+                ImGuizmo::SetRect(0.0f, 0.0f, io.DisplaySize.x, io.DisplaySize.y);
+                t0 = std::chrono::high_resolution_clock::now();
+                ImGuizmo::Manipulate(view, projection, gizmo_case.Operation, ImGuizmo::WORLD, pivot);
+                for (int n = 0; n < count; n++)
+                {
+                    float* out = reference.Data + n * 16;
+                    HarnessMatrixMultiply(source.Data + n * 16, pivot, out);
+                    if (gizmo_case.Pivot == ImGuizmo::PIVOT_INDIVIDUAL)
+                        for (int c = 0; c < 3; c++)
+                            out[12 + c] = source[n * 16 + 12 + c] + pivot[12 + c];
+                }
+                per_object_ms += HarnessElapsedMs(t0);
+                ImGui::EndFrame();
+
+                for (int n = 0; n < count * 16; n++)
+                {
+                    const float error = fabsf(matrices[n] - reference[n]) / ImMax(1.0f, fabsf(reference[n]));
+                    max_error = ImMax(max_error, error);
+                    same &= error < 1e-4f;
+                }
+            }
+            if (count_n == 0)
+            {
+                // Same drag on the matrix itself
+                ImGuizmo::SetContext(gizmo_pivot);
+                float single[16];
+                memcpy(single, source.Data, sizeof(single));
+                for (int frame = 0; frame < frame_count; frame++)
+                {
+                    HarnessGizmoDragInput(frame, frame_count);
+                    ImGui::NewFrame();
+                    ImGuizmo::BeginFrame();
+                    ImGuizmo::SetRect(0.0f, 0.0f, io.DisplaySize.x, io.DisplaySize.y);
+                    ImGuizmo::Manipulate(view, projection, gizmo_case.Operation, ImGuizmo::LOCAL, single);
+                    ImGui::EndFrame();
+                }
+                for (int n = 0; n < 16; n++)
+                    single_same &= fabsf(single[n] - matrices[n]) <= 1e-4f * ImMax(1.0f, fabsf(single[n]));
+                Check("gizmo_manipulate_many: the drag changed the matrix", memcmp(single, source.Data, sizeof(single)) != 0);
+            }
+            else
+            {
+                static const float identity[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+                Check("gizmo_manipulate_many: the drag changed the pivot", memcmp(pivot, identity, sizeof(identity)) != 0);
+            }
+        }
+        Check("gizmo_manipulate_many: ManipulateMany() matches Manipulate() of the pivot applied to every matrix", same);
+        Check("gizmo_manipulate_many: ManipulateMany() of one matrix matches Manipulate() of it", single_same);
+        Report.appendf("%s{\"operation\":\"%s\",\"manipulate_many_ms\":%.4f,\"per_object_ms\":%.4f,\"max_error\":%g,\"passed\":%s}", case_n > 0 ? "," : "",
+            gizmo_case.Name, many_ms / frame_count, per_object_ms / frame_count, max_error, same && single_same ? "true" : "false");
+    }
+    Report.appendf("]}");
+    RunCount++;
+
+    ImGuizmo::SetContext(NULL);
+    ImGuizmo::DestroyContext(gizmo_many);
+    ImGuizmo::DestroyContext(gizmo_pivot);
+    io.MouseDown[0] = false;
+    ImGui::SetCurrentContext(backup_context ? backup_context : Context);
+}
+
+void ImGuiHarness::RunGizmoKernels(int input_count)
+{
+    // Diagonally dominant so every matrix of a has an inverse
+    ImVector<float> a, b, simd_out, scalar_out;
+    a.resize(input_count * 16);
+    b.resize(input_count * 16);
+    simd_out.resize(input_count * 16);
+    scalar_out.resize(input_count * 16);
+    unsigned int seed = 12345;
+    for (int n = 0; n < input_count * 16; n++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        a[n] = (float)((seed >> 8) % 20000) * 0.0001f - 1.0f + ((n % 16) % 5 == 0 ? 4.0f : 0.0f);
+        seed = seed * 1664525u + 1013904223u;
+        b[n] = (float)((seed >> 8) % 20000) * 0.0001f - 1.0f;
+    }
+
+    static const char* kernel_names[] = { "multiply", "inverse", "transform", "transform_point", "transform_vector", "orthonormalize" };
+    IM_ASSERT(IM_ARRAYSIZE(kernel_names) == ImGuizmo::KERNEL_COUNT);
+    Report.appendf("%s{\"name\":\"gizmo_kernels\",\"inputs\":%d,\"kernels\":[", RunCount > 0 ? ",\n" : "", input_count);
+    for (int kernel_n = 0; kernel_n < ImGuizmo::KERNEL_COUNT; kernel_n++)
+    {
+        const ImGuizmo::KERNEL kernel = (ImGuizmo::KERNEL)kernel_n;
+        // Once untimed, so neither side pays for touching its output first
+        ImGuizmo::RunKernel(kernel, false, a.Data, b.Data, scalar_out.Data, input_count);
+        ImGuizmo::RunKernel(kernel, true, a.Data, b.Data, simd_out.Data, input_count);
+        std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+        ImGuizmo::RunKernel(kernel, false, a.Data, b.Data, scalar_out.Data, input_count);
+        const double scalar_ms = HarnessElapsedMs(t0);
+        t0 = std::chrono::high_resolution_clock::now();
+        if (!ImGuizmo::RunKernel(kernel, true, a.Data, b.Data, simd_out.Data, input_count))
+        {
+            Report.appendf("%s{\"kernel\":\"%s\",\"scalar_ms\":%.4f,\"simd\":false}", kernel_n > 0 ? "," : "", kernel_names[kernel_n], scalar_ms);
+            continue;
+        }
+        const double simd_ms = HarnessElapsedMs(t0);
+
+        float max_error = 0.0f;
+        const int floats = (kernel == ImGuizmo::KERNEL_MULTIPLY || kernel == ImGuizmo::KERNEL_INVERSE || kernel == ImGuizmo::KERNEL_ORTHONORMALIZE) ? 16 : 4;
+        for (int n = 0; n < input_count; n++)
+            for (int c = 0; c < floats; c++)
+            {
+                const float expected = scalar_out[n * 16 + c];
+                max_error = ImMax(max_error, fabsf(simd_out[n * 16 + c] - expected) / ImMax(1.0f, fabsf(expected)));
+            }
+        char what[96];
+        ImFormatString(what, IM_ARRAYSIZE(what), "gizmo_kernels: SSE %s matches the scalar version", kernel_names[kernel_n]);
+        const bool passed = Check(what, max_error <= 1e-4f);
+        Report.appendf("%s{\"kernel\":\"%s\",\"scalar_ms\":%.4f,\"simd\":true,\"simd_ms\":%.4f,\"max_error\":%g,\"passed\":%s}", kernel_n > 0 ? "," : "",
+            kernel_names[kernel_n], scalar_ms, simd_ms, max_error, passed ? "true" : "false");
+    }
+    Report.appendf("]}");
+    RunCount++;
+}
+
+void ImGuiHarness::WriteReport(ImGuiTextBuffer* out) const
+{
+    // Report is kept without the enclosing brackets so runs can keep appending
+    out->appendf("[\n%s\n]\n", Report.c_str());
+}
+
+//-----------------------------------------------------------------------------
+// Scenes
+//-----------------------------------------------------------------------------
+
+namespace ImGui
+{
+
+    void HarnessSceneDemo(void*)
+    {
+        ShowDemoWindow();
+    }
+
+    void HarnessSceneTextEditor(void* user_data)
+    {
+        TextEditor* editor = (TextEditor*)user_data;
+        SetNextWindowPos(ImVec2(0, 0));
+        SetNextWindowSize(GetIO().DisplaySize);
+        Begin("Text Editor", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+        editor->Render("##editor");
+        End();
+    }
+
+    void HarnessSceneDock(void*)
+    {
+        RootDock(ImVec2(0, 0), GetIO().DisplaySize);
+        for (int i = 0; i < 6; i++)
+        {
+            char label[32];
+            ImFormatString(label, IM_ARRAYSIZE(label), "Panel %d", i);
+            if (BeginDock(label))
+            {
+                for (int line = 0; line < 20; line++)
+                    Text("%s line %d", label, line);
+            }
+            EndDock();
+        }
+    }
+
+    void HarnessSceneTabs(void*)
+    {
+        SetNextWindowPos(ImVec2(0, 0));
+        SetNextWindowSize(GetIO().DisplaySize);
+        Begin("Tabs", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+        BeginTabBar("##tabs");
+        for (int i = 0; i < 32; i++)
+        {
+            char label[32];
+            ImFormatString(label, IM_ARRAYSIZE(label), "Document %d", i);
+            if (TabItem(label))
+            {
+                for (int line = 0; line < 40; line++)
+                    Text("%s line %d", label, line);
+            }
+        }
+        EndTabBar();
+        End();
+    }
+
+    void HarnessSceneTabsMany(void* user_data)
+    {
+        bool* last_tab_open = (bool*)user_data;
+        SetNextWindowPos(ImVec2(0, 0));
+        SetNextWindowSize(GetIO().DisplaySize);
+        Begin("Tabs (many)", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+        BeginTabBar("##tabs_many");
+        for (int i = 0; i < 1000; i++)
+        {
+            char label[32];
+            ImFormatString(label, IM_ARRAYSIZE(label), "Document %d.cpp", i);
+            if (TabItem(label, i == 999 ? last_tab_open : NULL))
+            {
+                for (int line = 0; line < 40; line++)
+                    Text("%s line %d", label, line);
+            }
+        }
+        EndTabBar();
+        End();
+    }
+
+    // Property grid of 5000 label/value rows, every 50th value is a wrapped description
+    void HarnessScenePropertyGrid(void*)
+    {
+        static const char* groups[] = { "Transform", "Material/Surface", "Physics/RigidBody", "Audio/Emitter" };
+        static const char* fields[] = { "position", "rotation (euler)", "scale", "linear damping coefficient", "albedo color", "emission intensity" };
+        static float values[5000];
+        SetNextWindowPos(ImVec2(0, 0));
+        SetNextWindowSize(GetIO().DisplaySize);
+        Begin("Properties", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+        Columns(2, "##properties");
+        for (int i = 0; i < IM_ARRAYSIZE(values); i++)
+        {
+            char label[64];
+            ImFormatString(label, IM_ARRAYSIZE(label), "%s/%s #%d", groups[i % IM_ARRAYSIZE(groups)], fields[(i / IM_ARRAYSIZE(groups)) % IM_ARRAYSIZE(fields)], i);
+            TextUnformatted(label);
+            NextColumn();
+            if (i % 50 == 0)
+                TextWrapped("%s: a longer description of the property, wrapped to the width of the value column", label);
+            else
+                Text("%.3f", values[i]);
+            NextColumn();
+        }
+        Columns(1);
+        End();
+    }
+
+    void HarnessSceneInputTextMultiline(void* user_data)
+    {
+        ImGuiHarnessInputText* input = (ImGuiHarnessInputText*)user_data;
+        SetNextWindowPos(ImVec2(0, 0));
+        SetNextWindowSize(GetIO().DisplaySize);
+        Begin("Log", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+
+        // The text lives in a child window named after the widget id, scroll it directly so the run doesn't depend on the recorded input
+        char child_name[64];
+        ImFormatString(child_name, IM_ARRAYSIZE(child_name), "%s/%08X", GetCurrentWindow()->Name, GetID("##log"));
+        if (ImGuiWindow* child = FindWindowByName(child_name))
+        {
+            input->ScrollY = (input->ScrollY + child->Size.y > child->SizeContents.y) ? 0.0f : input->ScrollY + child->Size.y;
+            child->ScrollTarget.y = input->ScrollY;
+            child->ScrollTargetCenterRatio.y = 0.0f;
+        }
+        if (input->Activate && !IsAnyItemActive())
+            SetKeyboardFocusHere();
+        InputTextMultiline("##log", input->Buf.Data, (size_t)input->Buf.Size, ImVec2(-1.0f, -1.0f));
+        End();
+    }
+
+#ifdef _MSC_VER
+    struct HarnessSequence : public ImSequencer::SequenceInterface
+    {
+        int Keys[16][2];
+
+        HarnessSequence() { for (int i = 0; i < 16; i++) { Keys[i][0] = i * 10; Keys[i][1] = i * 10 + 25; } }
+        virtual int GetFrameCount() const { return 200; }
+        virtual int GetTrackCount() const { return 16; }
+        virtual ImSequencer::TRACK_NATURE GetTrackNature(unsigned) const { return ImSequencer::TRACK_NATURE_DEFAULT; }
+        virtual const char* GetTrackLabel(int) const { return "Track"; }
+        virtual unsigned GetKeyFrameCount(int) { return 1; }
+        virtual void Get(int trackIndex, int, int** start, int** end, int* type, unsigned int* color)
+        {
+            if (start) *start = &Keys[trackIndex][0];
+            if (end) *end = &Keys[trackIndex][1];
+            if (type) *type = 0;
+            if (color) *color = 0xFFAA8080;
+        }
+    };
+
+    void HarnessSceneSequencer(void*)
+    {
+        static HarnessSequence sequence;
+        static int current_frame = 0, selected_entry = -1, selected_key = -1, first_frame = 0;
+        static bool expanded = true;
+        SetNextWindowPos(ImVec2(0, 0));
+        SetNextWindowSize(GetIO().DisplaySize);
+        Begin("Sequencer", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+        ImSequencer::Sequencer(&sequence, &current_frame, &expanded, &selected_entry, &selected_key, &first_frame, ImSequencer::SEQUENCER_EDIT_ALL);
+        End();
+    }
+#endif
+
+    static bool HarnessWriteReport(const ImGuiHarness& harness, const char* report_filename)
+    {
+        FILE* f = report_filename ? ImFileOpen(report_filename, "wt") : stdout;
+        if (!f)
+            return false;
+        ImGuiTextBuffer report;
+        harness.WriteReport(&report);
+        fputs(report.c_str(), f);
+        if (f != stdout)
+            fclose(f);
+        return true;
+    }
+
+    bool HarnessRunAll(const char* input_filename, const char* report_filename, int frame_count)
+    {
+        ImGuiHarness harness;
+        if (input_filename && !harness.LoadInput(input_filename))
+            return false;
+
+        std::string source;
+        for (int line = 0; line < 2000; line++)
+        {
+            char buf[96];
+            ImFormatString(buf, IM_ARRAYSIZE(buf), "float function_%d(float a, float b) { return a * %d.0 + b; } // line %d\n", line, line, line);
+            source += buf;
+        }
+        TextEditor editor;
+        editor.SetText(source);
+
+        harness.Run("demo", HarnessSceneDemo, NULL, frame_count);
+        harness.Run("text_editor", HarnessSceneTextEditor, &editor, frame_count);
+        harness.Run("dock", HarnessSceneDock, NULL, frame_count);
+        harness.Run("tabs", HarnessSceneTabs, NULL, frame_count);
+        harness.Run("tabs_1000", HarnessSceneTabsMany, NULL, frame_count);
+        harness.Run("property_grid", HarnessScenePropertyGrid, NULL, frame_count);
+        ImGuiHarnessInputText input_text;
+        harness.Run("input_text_10mb", HarnessSceneInputTextMultiline, &input_text, frame_count);
+        input_text.Activate = true;
+        input_text.ScrollY = 0.0f;
+        harness.Run("input_text_10mb_active", HarnessSceneInputTextMultiline, &input_text, frame_count);
+#ifdef _MSC_VER
+        harness.Run("sequencer", HarnessSceneSequencer, NULL, frame_count);
+#endif
+        harness.RunInputRoundTrip(1000);
+        harness.RunDockPresets(1000);
+        harness.RunIniSettings(10000);
+        harness.RunInputTextActivation();
+        harness.RunDragDropPayload();
+        harness.RunTextEditorLoad(100);
+        harness.RunTextEditorSearch(50);
+        harness.RunTextEditorMarkers(100000, 10000);
+        harness.RunTextEditorLongLines(100000, 100);
+        harness.RunTextEditorGetText(20);
+        harness.RunTabsLayout(120);
+        harness.RunPlotStream(1000000, 60);
+        harness.RunRenderText(100000);
+        harness.RunDrawJobsThreads(64, 60);
+        harness.RunUploadPlanner(20000);
+        harness.RunFrameArena();
+        harness.RunDrawBatches(60);
+        harness.RunTextFilter(1000000);
+        harness.RunFuzzySearch(500000);
+        harness.RunGizmoManipulateMany(10000, 60);
+        harness.RunGizmoKernels(100000);
+
+        ImGuiContext* backup_context = GetCurrentContext();
+        SetCurrentContext(harness.Context);
+        ShutdownDock();
+        ShutdownTabs();
+        SetCurrentContext(backup_context);
+
+        return HarnessWriteReport(harness, report_filename) && harness.CheckFailures == 0;
+    }
+
+    bool HarnessRunProfiler(const char* input_filename, const char* trace_filename, int frame_count)
+    {
+#ifndef IMGUI_ENABLE_PROFILER
+        (void)input_filename;
+        (void)trace_filename;
+        (void)frame_count;
+        fprintf(stderr, "profiler: built without IMGUI_ENABLE_PROFILER, see the imgui_harness_profiler target of CMakeLists.txt\n");
+        return false;
+#else
+        ImGuiHarness harness;
+        if (input_filename && !harness.LoadInput(input_filename))
+            return false;
+
+        std::string source;
+        for (int line = 0; line < 2000; line++)
+        {
+            char buf[96];
+            ImFormatString(buf, IM_ARRAYSIZE(buf), "float function_%d(float a, float b) { return a * %d.0 + b; } // line %d\n", line, line, line);
+            source += buf;
+        }
+        TextEditor editor;
+        editor.SetText(source);
+
+        ImGuiTextBuffer trace;
+        harness.RunProfiler("demo", HarnessSceneDemo, NULL, frame_count, &trace);
+        harness.RunProfiler("text_editor", HarnessSceneTextEditor, &editor, frame_count, &trace);
+        harness.RunProfiler("dock", HarnessSceneDock, NULL, frame_count, &trace);
+        harness.RunProfiler("tabs_1000", HarnessSceneTabsMany, NULL, frame_count, &trace);
+        harness.RunProfiler("property_grid", HarnessScenePropertyGrid, NULL, frame_count, &trace);
+
+        ImGuiContext* backup_context = GetCurrentContext();
+        SetCurrentContext(harness.Context);
+        ShutdownDock();
+        ShutdownTabs();
+        SetCurrentContext(backup_context);
+
+        FILE* f = ImFileOpen(trace_filename, "wt");
+        if (!f)
+            return false;
+        fprintf(f, "[\n%s\n]\n", trace.c_str());
+        fclose(f);
+        return harness.CheckFailures == 0;
+#endif
+    }
+
+    bool HarnessRunChecks(const char* report_filename)
+    {
+        ImGuiHarness harness;
+        harness.RunInputRoundTrip(1000);
+        harness.RunIniSettings(2000);
+        harness.RunInputTextActivation(64 << 10);
+        harness.RunDockPresets(100);
+        harness.RunDragDropPayload();
+        harness.RunTabsLayout(10);
+        harness.RunTextEditorLoad(1);
+        harness.RunTextEditorGetText(1);
+        harness.RunTextEditorSearch(1);
+        harness.RunTextEditorMarkers(20000, 2000);
+        harness.RunTextEditorLongLines(3000, 8);
+        harness.RunPlotStream(300000, 10);
+        harness.RunRenderText(1000);
+        harness.RunDrawJobsThreads(32, 20);
+        harness.RunUploadPlanner(20000);
+        harness.RunFrameArena(60);
+        harness.RunDrawBatches(10);
+        harness.RunTextFilter(100000);  // Several 16k string jobs for the threaded path
+        harness.RunFuzzySearch(20000);
+        harness.RunGizmoManipulateMany(100, 30);
+        harness.RunGizmoKernels(1000);
+        return HarnessWriteReport(harness, report_filename) && harness.CheckFailures == 0;
+    }
+
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "imgui.h"
+#include "imgui_upload.h"
+
+// Headless harness: a bare context with the default font atlas, no window, no graphics device.
+// Replays recorded input against scripted UIs and reports per-frame CPU time, vertex counts and heap allocations.
+// Everything here is portable C++, CMakeLists.txt builds it with the native sources as the imgui_harness executable (see imgui_harness_main.cpp) and registers its checks with CTest.
+// Test code only: it is not part of ImGuiCLI.vcxproj, nothing of it ships in the assembly.
+
+// Input of one frame, as copied from/into ImGuiIO
+struct ImGuiHarnessInput
+{
+    ImVec2      MousePos;
+    int         MouseButtons;       // Bit n is io.MouseDown[n]
+    float       MouseWheel;
+    bool        KeyCtrl;
+    bool        KeyShift;
+    bool        KeyAlt;
+    short       KeysDown[8];        // Indices into io.KeysDown[], -1 terminated
+    ImWchar     Text[8];            // Characters typed during the frame, 0 terminated
+};
+
+struct ImGuiHarnessFrameStats
+{
+    float       CpuMs;              // NewFrame() to Render() and the upload, scene included
+    int         Vertices;
+    int         Indices;
+    int         Allocations;        // MemAlloc calls made during the frame
+    int         DrawCalls;          // After BuildDrawBatches()
+    int         DrawCallsSaved;
+};
+
+typedef void (*ImGuiHarnessSceneFn)(void* user_data);
+
+// Generated log text for HarnessSceneInputTextMultiline()
+struct ImGuiHarnessInputText
+{
+    ImVector<char>  Buf;                // Text followed by free capacity, edited in place
+    bool            Activate;           // Give the widget keyboard focus so it renders through the edit state
+    float           ScrollY;
+
+    IMGUI_API ImGuiHarnessInputText(int text_size = 10 << 20);
+};
+
+struct ImGuiHarness
+{
+    ImGuiContext*                       Context;
+    ImVector<ImGuiHarnessInput>         Input;          // Replayed in a loop, frames get no input when empty
+    ImVector<ImGuiHarnessFrameStats>    Frames;         // Stats of the last Run()
+    ImGuiTextBuffer                     Report;         // JSON objects of the runs so far, see WriteReport()
+    int                                 RunCount;
+    int                                 CheckFailures;  // Failed Check() calls of the runs so far
+    ImGuiUploadRing                     UploadRing;     // Draw data is uploaded like a renderer would, into UploadBuffer instead of GPU memory
+    ImVector<char>                      UploadBuffer;
+    ImVector<ImGuiDrawBatch>            DrawBatches;
+
+    IMGUI_API ImGuiHarness(const ImVec2& display_size = ImVec2(1280, 720));
+    IMGUI_API ~ImGuiHarness();
+
+    IMGUI_API void          RecordInput(const ImGuiIO& io);                 // Append the current input state of a live application
+    IMGUI_API bool          LoadInput(const char* filename);
+    IMGUI_API bool          SaveInput(const char* filename) const;
+    IMGUI_API bool          Check(const char* what, bool passed);          // Count and print a failed correctness check, returns passed
+
+    // Run scene for frame_count frames (0 = one pass over Input) at a fixed 60 Hz time step and append the results to Report
+    IMGUI_API void          Run(const char* name, ImGuiHarnessSceneFn scene, void* user_data, int frame_count = 0);
+    // Run scene like Run() and append ProfilerAppendFrameJson() of every frame to trace, as {"name":..,"frames":[..]}. Needs IMGUI_ENABLE_PROFILER.
+    // Checks NewFrame, Begin, End and Render are timed every frame and text layout and tessellation at least once, every scope is closed by the end
+    // of the frame, and no phase nor the sum of the top-level ones exceeds the frame.
+    IMGUI_API void          RunProfiler(const char* name, ImGuiHarnessSceneFn scene, void* user_data, int frame_count, ImGuiTextBuffer* trace);
+    // Save generated input with SaveInput() and check LoadInput() reads back the same frames
+    IMGUI_API void          RunInputRoundTrip(int frame_count = 1000);
+    // Time .ini settings loading and saving (full, unchanged, one window moved) with entry_count window entries, in a private context
+    // Checks incremental saves match full rewrites after windows are moved, added, no longer submitted and after loading another .ini
+    IMGUI_API void          RunIniSettings(int entry_count = 10000);
+    // Time the frame activating a multi-line InputText over 64 KB, 1 MB and 10 MB of text (up to max_text_size), editable and read-only, and a read-only frame after a line got appended.
+    // Checks read-only updates converting from the first changed line give the text and line starts of a whole conversion, with invalid and multi-byte UTF-8 around chunk boundaries.
+    // Checks the visible lines it draws match drawing the whole text, scrolled and with a fractional font size, and the line starts after typing match indexing the text again.
+    IMGUI_API void          RunInputTextActivation(int max_text_size = 10 << 20);
+    // Drag a button and submit a scripted payload each frame: resubmitting the same bytes must keep the copy and DataVersion, changing the bytes or
+    // the size must copy them and bump it, and the data must survive moving between the local buffer and the heap one
+    IMGUI_API void          RunDragDropPayload();
+    // Switch between dock layout presets (a panel closed, a panel without tabs) switch_count times, checking the dock tree after each switch
+    // against SaveDock() of the layout the preset was saved from, and the changed dock counts LoadDockPreset() reports. Leaves the dock shut down.
+    IMGUI_API void          RunDockPresets(int switch_count = 1000);
+    // Open a generated log of about megabytes MB with TextEditor::LoadFile() and with SetText() from a string read from the file, timing the load and the first frames.
+    // The peak resident memory is only measured on Linux. LoadFile() splits its work with the io.DrawJobsRunner of the harness context, if set.
+    // Checks LoadFile() gives the text and colours of SetText() on the same bytes (CRLF, no final new line, empty) and ReleaseFile() keeps the text of a file written over.
+    IMGUI_API void          RunTextEditorLoad(int megabytes = 100);
+    // Time TextEditor::FindNext() from the top of a generated log of about megabytes MB to its last line (literal, case insensitive, regex) against GetText() and a string search,
+    // with the file mapped and held as glyphs, then stepping through a frequent match, a frame highlighting matches and a ReplaceAll()
+    // Checks FindNext() both ways with wrapping around, case insensitive and whole word (regex) patterns, ReplaceAll() and its undo and redo against a brute-force scan
+    IMGUI_API void          RunTextEditorSearch(int megabytes = 50);
+    // Time pasting a 10k line block into a document of line_count lines with marker_count error markers (and a breakpoint for every fourth), then deleting it.
+    // Checks the markers follow their lines through the paste, the delete and undoing both.
+    IMGUI_API void          RunTextEditorMarkers(int line_count = 100000, int marker_count = 10000);
+    // Time frames of a document of line_count tab separated lines of line_length characters, scrolled to the end of the first line, idle and while typing there
+    // Checks the column conversions looked up in the tabs of long lines match walking their glyphs, also after edits drop the lookup
+    IMGUI_API void          RunTextEditorLongLines(int line_length = 100000, int line_count = 100);
+    // Time TextEditor::GetText() over a generated log of about megabytes MB, mapped and held as glyphs, and into a reused buffer. Then a caller keeping a copy
+    // of the text while a character gets typed every tenth frame, exporting it every frame against only when IsChangedSince() its copy.
+    // Checks both GetText() return the file byte for byte, and which calls change the version
+    IMGUI_API void          RunTextEditorGetText(int megabytes = 20);
+    // Time frames of HarnessSceneTabsMany() with its tab bar layout clean, and with the last tab closed or reopened every frame so the bar gets laid out again
+    // Checks the layout skipped on clean frames matches a forced full layout after tabs are added, closed and reordered
+    IMGUI_API void          RunTabsLayout(int frame_count = 120);
+    // Time frames plotting a history of sample_count values with PlotLines() against PlotStreamLines(), after appending a third more so the stream's ring wraps.
+    // Checks the min/max of every plotted column against a pass over the samples, and that spikes show up in the envelope.
+    IMGUI_API void          RunPlotStream(int sample_count = 1000000, int frame_count = 60);
+    // Check ImFont::RenderText() writes byte-identical vertices and indices with its ASCII fast path and with the generic loop (forced with cpu_fine_clip and
+    // a clip rectangle holding all the text), then time both over line_count generated log lines
+    IMGUI_API void          RunRenderText(int line_count = 100000);
+    // Compare ImGui::BuildDrawBatches() with the unmerged command stream, with and without rebased indices: frame_count frames of each scene and a
+    // hand built draw data with known merges. Every command must be drawn by one batch with its texture and indices, unchanged vertex ranges, a clip
+    // rectangle that doesn't clip it differently, and adjacent commands sharing texture and clip rectangle must end up in the same batch.
+    IMGUI_API void          RunDrawBatches(int frame_count = 60);
+    // Drive ImGuiUploadRing against a fake GPU buffer recording which fence owns every byte: scripted frame sizes check the planned action
+    // (grow, reuse, wrap, shrink) and offset of every upload, then random_frame_count random frames check nothing in use by the GPU is ever overwritten.
+    IMGUI_API void          RunUploadPlanner(int random_frame_count = 20000);
+    // Frames taking a large then small amounts from MemAllocFrame(), with ImGuiFrameArena::ShrinkAfter set to shrink_after. Checks the block is kept through
+    // the window of the large frame and shrinks after a window of small ones, and io.MetricsFrameArenaBytes with the arena and with a custom frame allocator.
+    IMGUI_API void          RunFrameArena(int shrink_after = 600);
+    // Render job_count draw jobs (see ImGui::AddDrawJob()) serially and with io.DrawJobsRunner spreading them over 1 to 16 threads. Checks the draw data
+    // and the heap allocations counted per frame match the serial run, and times Render() for each thread count.
+    IMGUI_API void          RunDrawJobsThreads(int job_count = 64, int frame_count = 60);
+    // Time ImGuiTextFilter::PassFilter() called per string against one PassFilterMany() call, over string_count generated names.
+    // Checks PassFilterMany() returns exactly the indices PassFilter() passes, run serially and spread over 4 threads.
+    IMGUI_API void          RunTextFilter(int string_count = 1000000);
+    // Time ImGuiFuzzyIndex::Search() for each keystroke of a typed query over candidate_count generated asset paths, narrowed and from scratch.
+    // Checks narrowed searches return what searches from scratch do, and the top 50 match scoring and sorting every candidate by brute force.
+    IMGUI_API void          RunFuzzySearch(int candidate_count = 500000);
+    // Drag a translate and a scale gizmo over matrix_count matrices with ImGuizmo::ManipulateMany(), checking every frame against Manipulate() of the pivot
+    // applied to each matrix by the harness, and timing both
+    IMGUI_API void          RunGizmoManipulateMany(int matrix_count = 10000, int frame_count = 60);
+    // Run every ImGuizmo::RunKernel() kernel over input_count generated matrices with the SSE and the scalar versions, checking they agree within a relative 1e-4
+    // and timing both. Only the scalar times are reported when the SSE versions are compiled out.
+    IMGUI_API void          RunGizmoKernels(int input_count = 100000);
+    IMGUI_API void          WriteReport(ImGuiTextBuffer* out) const;       // "[ {run}, {run}.. ]"
+};
+
+namespace ImGui
+{
+    // Scripted scenes. Dock and tabs keep global state, call ShutdownDock()/ShutdownTabs() between harnesses.
+    IMGUI_API void  HarnessSceneDemo(void* user_data);
+    IMGUI_API void  HarnessSceneTextEditor(void* user_data);               // user_data: TextEditor*
+    IMGUI_API void  HarnessSceneDock(void* user_data);
+    IMGUI_API void  HarnessSceneTabs(void* user_data);
+    IMGUI_API void  HarnessSceneTabsMany(void* user_data);                 // 1000 document tabs, user_data: bool* open state of the last one (may be NULL)
+    IMGUI_API void  HarnessScenePropertyGrid(void* user_data);             // 5000 rows, exercises text measuring and the font layout cache
+    IMGUI_API void  HarnessSceneInputTextMultiline(void* user_data);       // user_data: ImGuiHarnessInputText*, scrolled down by a page per frame
+#ifdef _MSC_VER
+    IMGUI_API void  HarnessSceneSequencer(void* user_data);                // ImSequencer.cpp still relies on MSVC-only constructs
+#endif
+
+    // Run every scene against the input file (may be NULL) and write the JSON report, for regression runs. Returns false on I/O errors or when a check failed.
+    IMGUI_API bool  HarnessRunAll(const char* input_filename, const char* report_filename, int frame_count = 600);
+    // Only the runs that check results, on small data sets, for CI. Failed checks are printed to stderr, the report (may be NULL) is written as by HarnessRunAll().
+    IMGUI_API bool  HarnessRunChecks(const char* report_filename);
+    // Profile the benchmark scenes for frame_count frames each and write the per-frame trace, a JSON array of RunProfiler() objects. Returns false
+    // on I/O errors, when a check failed, or when built without IMGUI_ENABLE_PROFILER (see the imgui_harness_profiler target of CMakeLists.txt).
+    IMGUI_API bool  HarnessRunProfiler(const char* input_filename, const char* trace_filename, int frame_count = 600);
+}
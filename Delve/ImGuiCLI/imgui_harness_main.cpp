@@ -0,0 +1,45 @@
+// Command line of the imgui_harness target of CMakeLists.txt
+//  imgui_harness [--input file] [--report file] [--frames n]   run every scene and benchmark (see HarnessRunAll()), the report goes to stdout by default
+//  imgui_harness --check [--report file]                       only the correctness checks on small data sets (see HarnessRunChecks()), run by CTest
+//  imgui_harness_profiler --profile file [--input file] [--frames n]   per-frame profiler trace of the benchmark scenes (see HarnessRunProfiler()), run by CTest
+// The exit code is 0 when the report got written and no check failed.
+
+#include "imgui_harness.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char** argv)
+{
+    const char* input_filename = NULL;
+    const char* report_filename = NULL;
+    int frame_count = 600;
+    const char* trace_filename = NULL;
+    bool check = false;
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "--check") == 0)
+            check = true;
+        else if (strcmp(argv[n], "--profile") == 0 && n + 1 < argc)
+            trace_filename = argv[++n];
+        else if (strcmp(argv[n], "--input") == 0 && n + 1 < argc)
+            input_filename = argv[++n];
+        else if (strcmp(argv[n], "--report") == 0 && n + 1 < argc)
+            report_filename = argv[++n];
+        else if (strcmp(argv[n], "--frames") == 0 && n + 1 < argc)
+            frame_count = atoi(argv[++n]);
+        else
+        {
+            fprintf(stderr, "usage: %s [--check] [--profile file] [--input file] [--report file] [--frames n]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bool passed;
+    if (trace_filename)
+        passed = ImGui::HarnessRunProfiler(input_filename, trace_filename, frame_count);
+    else
+        passed = check ? ImGui::HarnessRunChecks(report_filename) : ImGui::HarnessRunAll(input_filename, report_filename, frame_count);
+    return passed ? 0 : 1;
+}
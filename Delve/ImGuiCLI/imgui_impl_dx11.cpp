@@ -12,6 +12,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2018-XX-XX: DirectX11: Vertices and indices share one dynamic buffer used as a ring (see imgui_upload.h), mapped once per draw data with NO_OVERWRITE until it wraps.
 //  2018-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
 //  2018-XX-XX: DirectX11: Offset projection matrix and clipping rectangle by draw_data->DisplayPos (which will be non-zero for multi-viewport applications).
 //  2018-02-16: Misc: Obsoleted the io.RenderDrawListsFn callback and exposed ImGui_ImplDX11_RenderDrawData() in the .h file so you can call it yourself.
@@ -20,6 +21,7 @@
 
 #include "imgui.h"
 #include "imgui_impl_dx11.h"
+#include "imgui_upload.h"
 
 #include <map>
 
@@ -32,8 +34,9 @@
 ID3D11Device*            g_pd3dDevice = NULL;
 ID3D11DeviceContext*     g_pd3dDeviceContext = NULL;
 IDXGIFactory1*           g_pFactory = NULL;
-static ID3D11Buffer*            g_pVB = NULL;
-static ID3D11Buffer*            g_pIB = NULL;
+static ID3D11Buffer*            g_pUploadBuffer = NULL;     // Vertices and indices
+static ImGuiUploadRing          g_UploadRing;
+static ImVector<ImGuiDrawBatch> g_DrawBatches;              // Commands merged into draw calls, see BuildDrawBatches()
 static ID3D10Blob *             g_pVertexShaderBlob = NULL;
 static ID3D11VertexShader*      g_pVertexShader = NULL;
 static ID3D11InputLayout*       g_pInputLayout = NULL;
@@ -45,7 +48,6 @@ static ID3D11ShaderResourceView*g_pFontTextureView = NULL;
 static ID3D11RasterizerState*   g_pRasterizerState = NULL;
 static ID3D11BlendState*        g_pBlendState = NULL;
 static ID3D11DepthStencilState* g_pDepthStencilState = NULL;
-static int                      g_VertexBufferSize = 5000, g_IndexBufferSize = 10000;
 
 struct VERTEX_CONSTANT_BUFFER
 {
@@ -62,53 +64,35 @@ void ImGui_ImplDX11_RenderDrawData(ImDrawData* draw_data)
 {
     ID3D11DeviceContext* ctx = g_pd3dDeviceContext;
 
-    // Create and grow vertex/index buffers if needed
-    if (!g_pVB || g_VertexBufferSize < draw_data->TotalVtxCount)
+    // Find room for this draw data in the upload buffer, creating or growing it if needed (see imgui_upload.h)
+    size_t idx_offset;
+    const size_t upload_size = ImGui::CalcDrawDataUploadSize(draw_data, &idx_offset);
+    const ImGuiUploadPlan plan = g_UploadRing.Plan(upload_size);
+    if (plan.Recreate || !g_pUploadBuffer)
     {
-        if (g_pVB) { g_pVB->Release(); g_pVB = NULL; }
-        g_VertexBufferSize = draw_data->TotalVtxCount + 5000;
+        if (g_pUploadBuffer) { g_pUploadBuffer->Release(); g_pUploadBuffer = NULL; }
         D3D11_BUFFER_DESC desc;
         memset(&desc, 0, sizeof(D3D11_BUFFER_DESC));
         desc.Usage = D3D11_USAGE_DYNAMIC;
-        desc.ByteWidth = g_VertexBufferSize * sizeof(ImDrawVert);
-        desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        desc.ByteWidth = (UINT)plan.BufferSize;
+        desc.BindFlags = D3D11_BIND_VERTEX_BUFFER | D3D11_BIND_INDEX_BUFFER;
         desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
         desc.MiscFlags = 0;
-        if (g_pd3dDevice->CreateBuffer(&desc, NULL, &g_pVB) < 0)
-            return;
-    }
-    if (!g_pIB || g_IndexBufferSize < draw_data->TotalIdxCount)
-    {
-        if (g_pIB) { g_pIB->Release(); g_pIB = NULL; }
-        g_IndexBufferSize = draw_data->TotalIdxCount + 10000;
-        D3D11_BUFFER_DESC desc;
-        memset(&desc, 0, sizeof(D3D11_BUFFER_DESC));
-        desc.Usage = D3D11_USAGE_DYNAMIC;
-        desc.ByteWidth = g_IndexBufferSize * sizeof(ImDrawIdx);
-        desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-        desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-        if (g_pd3dDevice->CreateBuffer(&desc, NULL, &g_pIB) < 0)
+        if (g_pd3dDevice->CreateBuffer(&desc, NULL, &g_pUploadBuffer) < 0)
+        {
+            g_UploadRing.Clear();
             return;
+        }
     }
 
-    // Copy and convert all vertices into a single contiguous buffer
-    D3D11_MAPPED_SUBRESOURCE vtx_resource, idx_resource;
-    if (ctx->Map(g_pVB, 0, D3D11_MAP_WRITE_DISCARD, 0, &vtx_resource) != S_OK)
+    // Copy all vertices then all indices in one map. Appending never touches what previous draws are reading, a wrap discards.
+    D3D11_MAPPED_SUBRESOURCE upload_resource;
+    if (ctx->Map(g_pUploadBuffer, 0, plan.Discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &upload_resource) != S_OK)
         return;
-    if (ctx->Map(g_pIB, 0, D3D11_MAP_WRITE_DISCARD, 0, &idx_resource) != S_OK)
-        return;
-    ImDrawVert* vtx_dst = (ImDrawVert*)vtx_resource.pData;
-    ImDrawIdx* idx_dst = (ImDrawIdx*)idx_resource.pData;
-    for (int n = 0; n < draw_data->CmdListsCount; n++)
-    {
-        const ImDrawList* cmd_list = draw_data->CmdLists[n];
-        memcpy(vtx_dst, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
-        memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
-        vtx_dst += cmd_list->VtxBuffer.Size;
-        idx_dst += cmd_list->IdxBuffer.Size;
-    }
-    ctx->Unmap(g_pVB, 0);
-    ctx->Unmap(g_pIB, 0);
+    const bool rebase_indices = ImGui::CanRebaseDrawDataIndices(draw_data);
+    ImGui::PackDrawData(draw_data, (char*)upload_resource.pData + plan.Offset, idx_offset, rebase_indices);
+    ctx->Unmap(g_pUploadBuffer, 0);
+    ImGui::BuildDrawBatches(draw_data, rebase_indices, &g_DrawBatches);
 
     // Setup orthographic projection matrix into our constant buffer
     // Our visible imgui space lies from draw_data->DisplayPps (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayMin is typically (0,0) for single viewport apps.
@@ -187,10 +171,10 @@ void ImGui_ImplDX11_RenderDrawData(ImDrawData* draw_data)
 
     // Bind shader and vertex buffers
     unsigned int stride = sizeof(ImDrawVert);
-    unsigned int offset = 0;
+    unsigned int offset = (unsigned int)plan.Offset;
     ctx->IASetInputLayout(g_pInputLayout);
-    ctx->IASetVertexBuffers(0, 1, &g_pVB, &stride, &offset);
-    ctx->IASetIndexBuffer(g_pIB, sizeof(ImDrawIdx) == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, 0);
+    ctx->IASetVertexBuffers(0, 1, &g_pUploadBuffer, &stride, &offset);
+    ctx->IASetIndexBuffer(g_pUploadBuffer, sizeof(ImDrawIdx) == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, (UINT)(plan.Offset + idx_offset));
     ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     ctx->VSSetShader(g_pVertexShader, NULL, 0);
     ctx->VSSetConstantBuffers(0, 1, &g_pVertexConstantBuffer);
@@ -203,35 +187,27 @@ void ImGui_ImplDX11_RenderDrawData(ImDrawData* draw_data)
     ctx->OMSetDepthStencilState(g_pDepthStencilState, 0);
     ctx->RSSetState(g_pRasterizerState);
 
-    // Render command lists
-    int vtx_offset = 0;
-    int idx_offset = 0;
+    // Render command lists, merged into batches
     ImVec2 display_pos = draw_data->DisplayPos;
-    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    for (int batch_i = 0; batch_i < g_DrawBatches.Size; batch_i++)
     {
-        const ImDrawList* cmd_list = draw_data->CmdLists[n];
-        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        const ImGuiDrawBatch* batch = &g_DrawBatches[batch_i];
+        if (batch->Cmd->UserCallback)
+        {
+            // User callback (registered via ImDrawList::AddCallback)
+            batch->Cmd->UserCallback(batch->CmdList, batch->Cmd);
+        }
+        else
         {
-            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
-            if (pcmd->UserCallback)
-            {
-                // User callback (registered via ImDrawList::AddCallback)
-                pcmd->UserCallback(cmd_list, pcmd);
-            }
-            else
-            {
-                // Apply scissor/clipping rectangle
-                const ImVec4 clip_rect = ImVec4(pcmd->ClipRect.x - display_pos.x, pcmd->ClipRect.y - display_pos.y, pcmd->ClipRect.z - display_pos.x, pcmd->ClipRect.w - display_pos.y);
-                const D3D11_RECT clip_rect_dx = { (LONG)clip_rect.x, (LONG)clip_rect.y, (LONG)clip_rect.z, (LONG)clip_rect.w };
-                ctx->RSSetScissorRects(1, &clip_rect_dx);
-
-                // Bind texture, Draw
-                ctx->PSSetShaderResources(0, 1, (ID3D11ShaderResourceView**)&pcmd->TextureId);
-                ctx->DrawIndexed(pcmd->ElemCount, idx_offset, vtx_offset);
-            }
-            idx_offset += pcmd->ElemCount;
+            // Apply scissor/clipping rectangle
+            const ImVec4 clip_rect = ImVec4(batch->ClipRect.x - display_pos.x, batch->ClipRect.y - display_pos.y, batch->ClipRect.z - display_pos.x, batch->ClipRect.w - display_pos.y);
+            const D3D11_RECT clip_rect_dx = { (LONG)clip_rect.x, (LONG)clip_rect.y, (LONG)clip_rect.z, (LONG)clip_rect.w };
+            ctx->RSSetScissorRects(1, &clip_rect_dx);
+
+            // Bind texture, Draw
+            ctx->PSSetShaderResources(0, 1, (ID3D11ShaderResourceView**)&batch->TextureId);
+            ctx->DrawIndexed(batch->ElemCount, batch->IdxOffset, batch->VtxOffset);
         }
-        vtx_offset += cmd_list->VtxBuffer.Size;
     }
 
     // Restore modified DX state
@@ -502,8 +478,9 @@ void    ImGui_ImplDX11_InvalidateDeviceObjects()
 
     if (g_pFontSampler) { g_pFontSampler->Release(); g_pFontSampler = NULL; }
     if (g_pFontTextureView) { g_pFontTextureView->Release(); g_pFontTextureView = NULL; ImGui::GetIO().Fonts->TexID = NULL; } // We copied g_pFontTextureView to io.Fonts->TexID so let's clear that as well.
-    if (g_pIB) { g_pIB->Release(); g_pIB = NULL; }
-    if (g_pVB) { g_pVB->Release(); g_pVB = NULL; }
+    if (g_pUploadBuffer) { g_pUploadBuffer->Release(); g_pUploadBuffer = NULL; }
+    g_UploadRing.Clear();
+    g_DrawBatches.clear();
 
     if (g_pBlendState) { g_pBlendState->Release(); g_pBlendState = NULL; }
     if (g_pDepthStencilState) { g_pDepthStencilState->Release(); g_pDepthStencilState = NULL; }
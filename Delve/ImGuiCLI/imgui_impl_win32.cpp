@@ -34,6 +34,18 @@ static INT64                g_TicksPerSecond = 0;
 static ImGuiMouseCursor     g_LastMouseCursor = ImGuiMouseCursor_Count_;
 static bool                 g_WantUpdateMonitors = true;
 
+// .ini writer thread data. The frame copies the text into g_IniPendingData, the thread swaps it out and writes it.
+// Buffers are only (re)allocated on the main thread, the writer thread only swaps and reads them.
+static HANDLE               g_IniWriterThread = NULL;
+static HANDLE               g_IniWriterEvent = NULL;
+static CRITICAL_SECTION     g_IniWriterLock;
+static ImVector<char>       g_IniPendingData;
+static ImVector<char>       g_IniPendingFilename;
+static ImVector<char>       g_IniWritingData;
+static ImVector<char>       g_IniWritingFilename;
+static bool                 g_IniPending = false;
+static bool                 g_IniWriterQuit = false;
+
 // Forward Declarations
 void ImGui_ImplWin32_InitPlatformInterface();
 void ImGui_ImplWin32_ShutdownPlatformInterface();
@@ -84,15 +96,102 @@ bool    ImGui_ImplWin32_Init(void* hwnd)
     io.KeyMap[ImGuiKey_Y] = 'Y';
     io.KeyMap[ImGuiKey_Z] = 'Z';
 
+    ImGui_ImplWin32_InitIniWriter();
     return true;
 }
 
 void    ImGui_ImplWin32_Shutdown()
 {
+    ImGui_ImplWin32_ShutdownIniWriter();
     ImGui_ImplWin32_ShutdownPlatformInterface();
     g_hWnd = (HWND)0;
 }
 
+static DWORD WINAPI ImGui_ImplWin32_IniWriterThread(LPVOID)
+{
+    for (;;)
+    {
+        ::WaitForSingleObject(g_IniWriterEvent, INFINITE);
+        ::EnterCriticalSection(&g_IniWriterLock);
+        const bool write = g_IniPending;
+        const bool quit = g_IniWriterQuit;
+        if (write)
+        {
+            g_IniWritingData.swap(g_IniPendingData);
+            g_IniWritingFilename.swap(g_IniPendingFilename);
+            g_IniPending = false;
+        }
+        ::LeaveCriticalSection(&g_IniWriterLock);
+
+        if (write)
+            if (FILE* f = ImFileOpen(g_IniWritingFilename.Data, "wt"))
+            {
+                fwrite(g_IniWritingData.Data, sizeof(char), (size_t)g_IniWritingData.Size, f);
+                fclose(f);
+            }
+        if (quit)
+            return 0;
+    }
+}
+
+// io.IniSaveFn: a save replaces the one still pending, if any
+static void ImGui_ImplWin32_SaveIniAsync(const char* filename, const char* ini_data, size_t ini_size, void*)
+{
+    const int filename_size = (int)strlen(filename) + 1;
+    ::EnterCriticalSection(&g_IniWriterLock);
+    g_IniPendingData.resize((int)ini_size);
+    memcpy(g_IniPendingData.Data, ini_data, ini_size);
+    g_IniPendingFilename.resize(filename_size);
+    memcpy(g_IniPendingFilename.Data, filename, (size_t)filename_size);
+    g_IniPending = true;
+    ::LeaveCriticalSection(&g_IniWriterLock);
+    ::SetEvent(g_IniWriterEvent);
+}
+
+void    ImGui_ImplWin32_InitIniWriter()
+{
+    if (g_IniWriterThread)
+        return;
+    ::InitializeCriticalSection(&g_IniWriterLock);
+    g_IniWriterEvent = ::CreateEvent(NULL, FALSE, FALSE, NULL);
+    g_IniPending = g_IniWriterQuit = false;
+    g_IniWriterThread = g_IniWriterEvent ? ::CreateThread(NULL, 0, ImGui_ImplWin32_IniWriterThread, NULL, 0, NULL) : NULL;
+    if (!g_IniWriterThread)
+    {
+        // Keep the synchronous saves
+        if (g_IniWriterEvent) { ::CloseHandle(g_IniWriterEvent); g_IniWriterEvent = NULL; }
+        ::DeleteCriticalSection(&g_IniWriterLock);
+        return;
+    }
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniSaveFn = ImGui_ImplWin32_SaveIniAsync;
+    io.IniSaveFnUserData = NULL;
+}
+
+void    ImGui_ImplWin32_ShutdownIniWriter()
+{
+    if (!g_IniWriterThread)
+        return;
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.IniSaveFn == ImGui_ImplWin32_SaveIniAsync)
+        io.IniSaveFn = NULL;
+
+    // Let the thread finish the pending write
+    ::EnterCriticalSection(&g_IniWriterLock);
+    g_IniWriterQuit = true;
+    ::LeaveCriticalSection(&g_IniWriterLock);
+    ::SetEvent(g_IniWriterEvent);
+    ::WaitForSingleObject(g_IniWriterThread, INFINITE);
+    ::CloseHandle(g_IniWriterThread);
+    ::CloseHandle(g_IniWriterEvent);
+    ::DeleteCriticalSection(&g_IniWriterLock);
+    g_IniWriterThread = g_IniWriterEvent = NULL;
+    g_IniPendingData.clear();
+    g_IniPendingFilename.clear();
+    g_IniWritingData.clear();
+    g_IniWritingFilename.clear();
+}
+
 static bool ImGui_ImplWin32_UpdateMouseCursor()
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -7,6 +7,10 @@ IMGUI_API bool        ImGui_ImplWin32_Init(void* hwnd);
 IMGUI_API void        ImGui_ImplWin32_Shutdown();
 IMGUI_API void        ImGui_ImplWin32_NewFrame();
 
+// Background .ini writer installed as io.IniSaveFn (done by Init/Shutdown). Shutdown waits for the pending write.
+IMGUI_API void        ImGui_ImplWin32_InitIniWriter();
+IMGUI_API void        ImGui_ImplWin32_ShutdownIniWriter();
+
 // DPI-related helpers (which run and compile without requiring 8.1 or 10, neither Windows version, neither associated SDK)
 IMGUI_API void        ImGui_ImplWin32_EnableDpiAwareness();
 IMGUI_API float       ImGui_ImplWin32_GetDpiScaleForHwnd(void* hwnd);       // HWND hwnd
@@ -16,6 +16,15 @@
 #include <math.h>       // sqrtf, fabsf, fmodf, powf, floorf, ceilf, cosf, sinf
 #include <limits.h>     // INT_MIN, INT_MAX
 
+// SSE2 scanning loops (ASCII runs in ImFont::RenderText(), ImGuiTextFilter::PassFilterMany()). Managed (/clr) builds keep the scalar loops,
+// intrinsics would be compiled as native functions there and pay a managed/native transition on every call.
+#if !defined(IMGUI_DISABLE_SSE) && !defined(_M_CEE) && (defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__))
+#define IMGUI_SSE 1
+#include <emmintrin.h>
+#else
+#define IMGUI_SSE 0
+#endif
+
 #ifdef _MSC_VER
 #pragma warning (push)
 #pragma warning (disable: 4251) // class 'xxx' needs to have dll-interface to be used by clients of struct 'xxx' // when IMGUI_API is set to__declspec(dllexport)
@@ -90,7 +99,7 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit ImGui context pointe
 // Helpers: UTF-8 <> wchar
 IMGUI_API int           ImTextStrToUtf8(char* buf, int buf_size, const ImWchar* in_text, const ImWchar* in_text_end);      // return output UTF-8 bytes count
 IMGUI_API int           ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char* in_text_end);          // return input UTF-8 bytes count
-IMGUI_API int           ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_remaining = NULL);   // return input UTF-8 bytes count
+IMGUI_API int           ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_remaining = NULL, bool* out_lossless = NULL);   // return input UTF-8 bytes count
 IMGUI_API int           ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end);                            // return number of UTF-8 code-points (NOT bytes count)
 IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end);                   // return number of bytes to express string as UTF-8 code-points
 
@@ -224,6 +233,19 @@ enum ImGuiItemStatusFlags_
     ImGuiItemStatusFlags_HasDisplayRect     = 1 << 1
 };
 
+// Profiler phases, see IMGUI_PROFILE_SCOPE()
+enum ImGuiProfilePhase_
+{
+    ImGuiProfilePhase_NewFrame,
+    ImGuiProfilePhase_Begin,
+    ImGuiProfilePhase_End,
+    ImGuiProfilePhase_Render,
+    ImGuiProfilePhase_UpdatePlatformWindows,
+    ImGuiProfilePhase_Tessellation,
+    ImGuiProfilePhase_TextLayout,
+    ImGuiProfilePhase_COUNT
+};
+
 // FIXME: this is in development, not exposed/functional as a generic feature yet.
 enum ImGuiLayoutType_
 {
@@ -383,6 +405,11 @@ struct IMGUI_API ImGuiTextEditState
     ImVector<char>      TempTextBuffer;
     int                 CurLenA, CurLenW;           // we need to maintain our buffer length in both UTF-8 and wchar format.
     int                 BufSizeA;                   // end-user buffer size
+    ImVector<int>       LineStartsW;                // index in Text of the first character of each line, so multi-line text only measures and renders the visible lines
+    ImVector<int>       LineStartsA;                // same lines as byte offsets in the displayed UTF-8 buffer
+    bool                LineStartsDirty;            // Text changed since the line starts were built (set by the stb_textedit callbacks)
+    bool                TempTextBufferDirty;        // Text changed since it was converted into TempTextBuffer
+    bool                TextFromInitialText;        // Text and the line starts were made from InitialText and not edited since, so read-only updates only convert the lines after the first changed byte
     float               ScrollX;
     ImGuiStb::STB_TexteditState   StbState;
     float               CursorAnim;
@@ -396,6 +423,7 @@ struct IMGUI_API ImGuiTextEditState
     void                ClearSelection()            { StbState.select_start = StbState.select_end = StbState.cursor; }
     void                SelectAll()                 { StbState.select_start = 0; StbState.cursor = StbState.select_end = CurLenW; StbState.has_preferred_x = false; }
     void                OnKeyPressed(int key);
+    void                OnTextChanged()             { LineStartsDirty = TempTextBufferDirty = true; TextFromInitialText = false; }
 };
 
 // Data saved in imgui.ini file
@@ -408,8 +436,10 @@ struct ImGuiWindowSettings
     ImVec2      ViewportPos;
     ImGuiID     ViewportId;
     bool        Collapsed;
+    int         IniOffset;  // Text of this entry in g.SettingsWindowsIni as of the last save, -1 when it changed since
+    int         IniLength;
 
-    ImGuiWindowSettings() { Name = NULL; Id = ViewportId = 0; Pos = Size = ViewportPos = ImVec2(0, 0); Collapsed = false; }
+    ImGuiWindowSettings() { Name = NULL; Id = ViewportId = 0; Pos = Size = ViewportPos = ImVec2(0, 0); Collapsed = false; IniOffset = -1; IniLength = 0; }
 };
 
 struct ImGuiSettingsHandler
@@ -588,6 +618,106 @@ struct ImGuiNextWindowData
     }
 };
 
+// Bump allocator behind MemAllocFrame(). Reset() is called by NewFrame(), the block is regrown to the previous frame
+// high-water mark so steady state frames don't touch the heap. Requests that don't fit spill to MemAlloc() until then.
+// Like ImGuiUploadRing, the block shrinks back once the frames of a whole ShrinkAfter window are much smaller.
+struct ImGuiFrameArena
+{
+    char*                   Data;
+    size_t                  Size;
+    size_t                  Used;
+    size_t                  Requested;                          // Bytes handed out this frame, including spilled ones
+    ImVector<void*>         Spilled;
+    int                     ShrinkAfter;                        // = 600 // Reallocate smaller when the largest of the last ShrinkAfter frames fits in a quarter of the block. 0 to never shrink.
+    size_t                  PeakRequested;                      // Largest frame since PeakCount was reset
+    int                     PeakCount;
+
+    ImGuiFrameArena()       { Data = NULL; Size = Used = Requested = PeakRequested = 0; ShrinkAfter = 600; PeakCount = 0; }
+    ~ImGuiFrameArena()      { Clear(); }
+    IMGUI_API void*         Alloc(size_t sz);
+    IMGUI_API void          Reset();
+    IMGUI_API void          Clear();
+};
+
+struct ImGuiProfilerPhaseData
+{
+    ImU64                   Ticks;                              // Nanoseconds, only the outermost scope of a phase is timed
+    int                     Calls;
+    int                     Allocations;
+    int                     Depth;
+};
+
+struct ImGuiProfiler
+{
+    ImGuiProfilerPhaseData  Phases[ImGuiProfilePhase_COUNT];    // Frame in progress
+    ImGuiProfilerPhaseData  LastPhases[ImGuiProfilePhase_COUNT];
+    int                     LastFrameCount;
+};
+
+#ifdef IMGUI_ENABLE_PROFILER
+struct ImGuiProfileScope
+{
+    ImGuiProfilerPhaseData* Phase;
+    ImU64                   StartTicks;
+    size_t                  StartAllocations;
+
+    IMGUI_API ImGuiProfileScope(ImGuiProfilePhase_ phase);
+    IMGUI_API ~ImGuiProfileScope();
+};
+#define IMGUI_PROFILE_SCOPE(_PHASE)     ImGuiProfileScope imgui_profile_scope(_PHASE)
+#else
+#define IMGUI_PROFILE_SCOPE(_PHASE)     (void)0
+#endif
+
+// Per-font cache of CalcTextSizeA() results and word-wrap positions, keyed by (text hash, size, wrap width).
+// Set associative with LRU replacement inside a set, so a lookup never walks more than a few entries and never allocates.
+// Cleared by ImFont::BuildLookupTable() and AddRemapChar(), which covers every atlas rebuild.
+#ifndef IMGUI_TEXT_LAYOUT_CACHE_SIZE
+#define IMGUI_TEXT_LAYOUT_CACHE_SIZE        8192
+#endif
+#define IMGUI_TEXT_LAYOUT_CACHE_WAYS        8
+#define IMGUI_TEXT_LAYOUT_CACHE_MIN_LENGTH  24      // Unwrapped strings shorter than this are measured faster than they are looked up
+#if (IMGUI_TEXT_LAYOUT_CACHE_SIZE % IMGUI_TEXT_LAYOUT_CACHE_WAYS) != 0
+#error "IMGUI_TEXT_LAYOUT_CACHE_SIZE must be a multiple of IMGUI_TEXT_LAYOUT_CACHE_WAYS"
+#endif
+
+struct ImFontLayoutCacheEntry
+{
+    ImU64                   Hash;                               // 0 = unused slot
+    int                     TextLength;
+    float                   Size;
+    float                   WrapWidth;
+    ImVec2                  TextSize;
+    unsigned int            LastUse;
+    int                     WrapBreaksOffset;                   // Into ImFontLayoutCache::WrapBreaks, offsets from the start of the text
+    int                     WrapBreaksCount;
+};
+
+struct ImFontLayoutCache
+{
+    ImVector<ImFontLayoutCacheEntry> Entries;                   // Allocated on first use, IMGUI_TEXT_LAYOUT_CACHE_SIZE entries
+    ImVector<int>           WrapBreaks;                         // Append only, evicted entries leave holes until the next Clear()
+    unsigned int            Clock;
+    int                     Hits, Misses, Evictions;            // Since the last atlas build
+    bool                    Frozen;                             // Set while draw jobs run on worker threads: lookups only, misses return NULL
+
+    ImFontLayoutCache()     { Clock = 0; Hits = Misses = Evictions = 0; Frozen = false; }
+    IMGUI_API void          Clear();
+    IMGUI_API int           GetUsedCount() const;
+    IMGUI_API const ImFontLayoutCacheEntry* FindOrAdd(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end);   // NULL on a miss while Frozen
+};
+
+// Queued by AddDrawJob(), run by Render()
+struct ImGuiDrawJob
+{
+    ImGuiDrawJobFn          Fn;
+    void*                   UserData;
+    ImDrawList*             DrawList;                           // From ImGuiContext::DrawJobListsPool, also referenced by the window's DrawJobLists
+    ImVec4                  ClipRect;                           // Window draw list state at the time of AddDrawJob()
+    ImTextureID             TextureId;
+    ImDrawListFlags         Flags;
+};
+
 // Main state for ImGui
 struct ImGuiContext
 {
@@ -722,6 +852,9 @@ struct ImGuiContext
     bool                           SettingsLoaded;
     float                          SettingsDirtyTimer;          // Save .ini Settings on disk when time reaches zero
     ImVector<ImGuiWindowSettings>  SettingsWindows;             // .ini settings for ImGuiWindow
+    ImGuiStorage                   SettingsWindowsIndex;        // Index into SettingsWindows, by window ID
+    ImVector<char>                 SettingsWindowsIni;          // Window entries as written by the last save, unchanged ones are copied from here
+    ImVector<char>                 SettingsIniData;             // Whole .ini text of the last save, zero terminated
     ImVector<ImGuiSettingsHandler> SettingsHandlers;            // List of .ini settings handlers
 
     // Logging
@@ -739,6 +872,16 @@ struct ImGuiContext
     int                     WantCaptureKeyboardNextFrame;
     int                     WantTextInputNextFrame;
     char                    TempBuffer[1024*3+1];               // Temporary text buffer
+    ImGuiFrameArena         FrameArena;                         // Transient allocations, see MemAllocFrame()
+    void*                   (*FrameAllocFunc)(size_t sz, void* user_data);  // Optional replacement for FrameArena, see SetFrameAllocatorFunctions()
+    void                    (*FrameResetFunc)(void* user_data);
+    void*                   FrameAllocUserData;
+    size_t                  FrameAllocBytes;                    // Requested from MemAllocFrame() this frame, from FrameArena or FrameAllocFunc
+    ImGuiProfiler           Profiler;
+    ImVector<ImGuiDrawJob>  DrawJobs;                           // Queued during the frame, run and cleared by Render()
+    ImVector<ImDrawList*>   DrawJobListsPool;                   // Owned, reused frame to frame, DrawJobs[n] uses DrawJobListsPool[n]
+    bool                    DrawJobsRunning;                    // Worker threads may be inside ImDrawList/ImFont code, the profiler and the font layout caches stay untouched
+    void                    (*DockMetricsFn)();                 // Set by imgui_dock.cpp once a dock space is used, shown in the metrics window. The core doesn't link against the dock extension.
 
     ImGuiContext(ImFontAtlas* shared_font_atlas)
     {
@@ -840,6 +983,13 @@ struct ImGuiContext
         FramerateSecPerFrameAccum = 0.0f;
         WantCaptureMouseNextFrame = WantCaptureKeyboardNextFrame = WantTextInputNextFrame = -1;
         memset(TempBuffer, 0, sizeof(TempBuffer));
+        FrameAllocFunc = NULL;
+        FrameResetFunc = NULL;
+        FrameAllocUserData = NULL;
+        FrameAllocBytes = 0;
+        memset(&Profiler, 0, sizeof(Profiler));
+        DrawJobsRunning = false;
+        DockMetricsFn = NULL;
     }
 };
 
@@ -1003,6 +1153,7 @@ struct IMGUI_API ImGuiWindow
 
     ImDrawList*             DrawList;                           // == &DrawListInst (for backward compatibility reason with code using imgui_internal.h we keep this a pointer)
     ImDrawList              DrawListInst;
+    ImVector<ImDrawList*>   DrawJobLists;                       // Filled by draw jobs in Render(), drawn right after DrawList. Not owned.
     ImGuiWindow*            ParentWindow;                       // If we are a child _or_ popup window, this is pointing to our parent. Otherwise NULL.
     ImGuiWindow*            RootWindow;                         // Point to ourself or first ancestor that is not a child window.
     ImGuiWindow*            RootWindowForTitleBarHighlight;     // Point to ourself or first ancestor which will display TitleBgActive color when this window is active.
@@ -1088,6 +1239,8 @@ namespace ImGui
     IMGUI_API void                  MarkIniSettingsDirty();
     IMGUI_API ImGuiSettingsHandler* FindSettingsHandler(const char* type_name);
     IMGUI_API ImGuiWindowSettings*  FindWindowSettings(ImGuiID id);
+    IMGUI_API void                  LoadIniSettingsFromMemory(const char* ini_data);    // Merge into the current settings, zero terminated
+    IMGUI_API const char*           SaveIniSettingsToMemory(size_t* out_ini_size = NULL); // Valid until the next save
 
     IMGUI_API void          SetActiveID(ImGuiID id, ImGuiWindow* window);
     IMGUI_API ImGuiID       GetActiveID();
@@ -3,6 +3,7 @@
 
 #define _CRT_SECURE_NO_WARNINGS
 #include "imgui_tabs.h"
+#include "imgui_tabs_internal.h"
 #define IMGUI_DEFINE_MATH_OPERATORS
 #define IMGUI_DEFINE_PLACEMENT_NEW
 #include "imgui_internal.h"
@@ -62,6 +63,10 @@ struct ImGuiTabItem
     bool            SkipOffsetAnim;
     bool            SkipAppearAnim;
     char            DebugName[16];
+    ImGuiID         LabelHash;          // Hash of the displayed part of the label, LabelSize is only measured again when it or the font changes
+    ImFont*         LabelFont;
+    float           LabelFontSize;
+    ImVec2          LabelSize;
 
     ImGuiTabItem() 
     { 
@@ -75,6 +80,10 @@ struct ImGuiTabItem
         AppearAnim = 1.0f;
         SkipOffsetAnim = SkipAppearAnim = false;
         memset(DebugName, 0, sizeof(DebugName));
+        LabelHash = 0;
+        LabelFont = NULL;
+        LabelFontSize = 0.0f;
+        LabelSize = ImVec2(0.0f, 0.0f);
     }
 };
 
@@ -96,6 +105,11 @@ struct ImGuiTabBar
     int                 ReorderRequestTabIdx;
     int                 ReorderRequestDir;
     bool                WantLayout;
+    bool                LayoutDirty;        // Offsets/widths need to be recomputed: tabs added, removed, reordered or resized
+    float               LayoutBarWidth;     // Inputs of the last full layout, a change in any of them dirties it
+    float               LayoutSpacing;
+    ImGuiTabBarFlags    LayoutFlags;
+    int                 LayoutCount;        // Number of full layouts done, for ShowTabsDebug()
     bool                CurrOrderInsideTabsIsValid;
     bool                CurrSelectedTabIdIsAlive;
 
@@ -112,6 +126,10 @@ struct ImGuiTabBar
         ReorderRequestTabIdx = -1;
         ReorderRequestDir = 0;
         WantLayout = false;
+        LayoutDirty = true;
+        LayoutBarWidth = LayoutSpacing = 0.0f;
+        LayoutFlags = ImGuiTabBarFlags_None;
+        LayoutCount = 0;
         CurrOrderInsideTabsIsValid = false;
         CurrSelectedTabIdIsAlive = false;
     }
@@ -245,6 +263,8 @@ void    ImGui::BeginTabBar(const char* str_id, ImGuiTabBarFlags flags)
     tab_bar->Flags = flags;
     tab_bar->BarRect = ImRect(window->DC.CursorPos, window->DC.CursorPos + ImVec2(GetContentRegionAvailWidth(), g.FontSize + style.FramePadding.y * 2.0f));
     tab_bar->WantLayout = true; // Layout will be done on the first call to ItemTab()
+    if (tab_bar->CurrFrameVisible + 1 < g.FrameCount)
+        tab_bar->LayoutDirty = true;
     tab_bar->LastFrameVisible = tab_bar->CurrFrameVisible;
     tab_bar->CurrFrameVisible = g.FrameCount;
 
@@ -330,6 +350,8 @@ static void TabBarLayout(ImGuiTabBar* tab_bar)
     }
     tab_bar->CurrSelectedTabIdIsAlive = false;
 
+    if (tab_bar->CurrTabCount != tab_bar->NextTabCount)
+        tab_bar->LayoutDirty = true;
     tab_bar->CurrTabCount = tab_bar->NextTabCount;
     tab_bar->NextTabCount = 0;
 
@@ -350,19 +372,40 @@ static void TabBarLayout(ImGuiTabBar* tab_bar)
 #endif
             if (tab1->Id == tab_bar->CurrSelectedTabId)
                 scroll_track_selected_tab = tab1;
+            tab_bar->LayoutDirty = true;
         }
         tab_bar->ReorderRequestTabIdx = -1;
     }
 
+    if (tab_bar->LayoutBarWidth != tab_bar->BarRect.GetWidth() || tab_bar->LayoutSpacing != g.Style.ItemInnerSpacing.x || tab_bar->LayoutFlags != tab_bar->Flags)
+        tab_bar->LayoutDirty = true;
+
     // During layout we will search for those infos
     int selected_order = -1;
     ImGuiTabItem* most_recent_selected_tab = NULL;
 
+    // Nothing changed since the last layout, offsets and widths are still valid so only resolve what the full pass would have found
+    if (!tab_bar->LayoutDirty)
+    {
+        if (ImGuiTabItem* selected_tab = tab_bar->CurrSelectedTabId ? ctx.Tabs.GetByKey(tab_bar->CurrSelectedTabId) : NULL)
+            if (selected_tab->CurrentOrderVisible != -1)
+                selected_order = selected_tab->CurrentOrder;
+        if (tab_bar->CurrSelectedTabId == 0)
+        {
+            for (int tab_order_n = 0; tab_order_n < tab_bar->TabsOrder.Size; tab_order_n++)
+            {
+                ImGuiTabItem* tab = ctx.GetTabByOrder(tab_bar, tab_order_n);
+                if (tab->CurrentOrderVisible != -1 && (most_recent_selected_tab == NULL || most_recent_selected_tab->LastFrameSelected < tab->LastFrameSelected))
+                    most_recent_selected_tab = tab;
+            }
+        }
+    }
+
     // Layout all active tabs
     const float tab_width_equal = (tab_bar->CurrTabCount > 0) ? (float)(int)((tab_bar->BarRect.GetWidth() - (tab_bar->CurrTabCount - 1) * g.Style.ItemInnerSpacing.x) / tab_bar->CurrTabCount) : 0.0f;
     float offset_x = 0.0f;
     int tab_order_visible_n = 0;
-    for (int tab_order_n = 0; tab_order_n < tab_bar->TabsOrder.Size; tab_order_n++)
+    for (int tab_order_n = 0; tab_bar->LayoutDirty && tab_order_n < tab_bar->TabsOrder.Size; tab_order_n++)
     {
         ImGuiTabItem* tab = ctx.GetTabByOrder(tab_bar, tab_order_n);
         tab->CurrentOrder = tab_order_n;
@@ -399,8 +442,16 @@ static void TabBarLayout(ImGuiTabBar* tab_bar)
 
         offset_x += tab->WidthTarget + g.Style.ItemInnerSpacing.x;
     }
-    tab_bar->OffsetMax = ImMax(offset_x - g.Style.ItemInnerSpacing.x, 0.0f);
-    tab_bar->CurrVisibleCount = tab_order_visible_n;
+    if (tab_bar->LayoutDirty)
+    {
+        tab_bar->OffsetMax = ImMax(offset_x - g.Style.ItemInnerSpacing.x, 0.0f);
+        tab_bar->CurrVisibleCount = tab_order_visible_n;
+        tab_bar->LayoutBarWidth = tab_bar->BarRect.GetWidth();
+        tab_bar->LayoutSpacing = g.Style.ItemInnerSpacing.x;
+        tab_bar->LayoutFlags = tab_bar->Flags;
+        tab_bar->LayoutDirty = false;
+        tab_bar->LayoutCount++;
+    }
     tab_bar->CurrOrderInsideTabsIsValid = true;
 
     // Horizontal scrolling buttons
@@ -509,6 +560,7 @@ void    ImGui::SetTabItemClosed(const char* label)
     {
         if (tab->LastFrameVisible == tab_bar->LastFrameVisible)
             tab_bar->NextTabCount--;
+        tab_bar->LayoutDirty = true;
         tab->LastFrameVisible = -1;
         if (tab->Id == tab_bar->CurrSelectedTabId)
         {
@@ -562,6 +614,8 @@ bool    ImGui::TabItem(const char* label, bool* p_open, ImGuiTabItemFlags flags)
     const bool tab_bar_appearing = (tab_bar->LastFrameVisible + 1 < g.FrameCount);
     const bool tab_appearing = (tab->LastFrameVisible + 1 < g.FrameCount);
     const bool tab_selected = (tab_bar->CurrSelectedTabId == id);
+    if (tab_appearing)
+        tab_bar->LayoutDirty = true;
 
     // Position newly appearing tab at the end of the tab list
     if (tab_appearing && !tab_bar_appearing && !(tab_bar->Flags & ImGuiTabBarFlags_NoResetOrderOnAppearing))
@@ -589,9 +643,20 @@ bool    ImGui::TabItem(const char* label, bool* p_open, ImGuiTabItemFlags flags)
     // Backup current layout position
     const ImVec2 backup_main_cursor_pos = window->DC.CursorPos;
 
-    // Calculate tab contents size
-    ImVec2 label_size = CalcTextSize(label, NULL, true);
+    // Calculate tab contents size, hashing the label is a lot cheaper than measuring it
+    const char* label_end = FindRenderedTextEnd(label);
+    const ImGuiID label_hash = ImHash(label, (int)(label_end - label));
+    if (tab->LabelHash != label_hash || tab->LabelFont != g.Font || tab->LabelFontSize != g.FontSize)
+    {
+        tab->LabelHash = label_hash;
+        tab->LabelFont = g.Font;
+        tab->LabelFontSize = g.FontSize;
+        tab->LabelSize = CalcTextSize(label, label_end, false);
+    }
+    ImVec2 label_size = tab->LabelSize;
     ImVec2 size = TabBarCalcTabBaseSize(label_size, p_open);
+    if (tab->WidthContents != size.x)
+        tab_bar->LayoutDirty = true;
     tab->WidthContents = size.x;
 
     // Animate
@@ -1062,6 +1127,7 @@ void ImGui::ShowTabsDebug()
         ImGui::Separator();
         ImGui::Text("TabBar 0x%08X", tab_bar->Id);
         ImGui::Text("TabsOrder.Size %d", tab_bar->TabsOrder.Size);
+        ImGui::Text("Full layouts %d%s", tab_bar->LayoutCount, tab_bar->LayoutDirty ? " (dirty)" : "");
 
         for (int tab_n = 0; tab_n < tab_bar->TabsOrder.Size; tab_n++)
         {
@@ -1079,3 +1145,42 @@ void ImGui::ShowTabsDebug()
     }
     ImGui::End();
 }
+
+static ImGuiTabBar* FindTabBar(const char* window_name, const char* str_id)
+{
+    ImGuiWindow* window = ImGui::FindWindowByName(window_name);
+    IM_ASSERT(window != NULL);
+    const ImGuiID id = ImHash("", 0, ImHash(str_id, 0, window->ID));   // PushID(str_id) + GetID("") in BeginTabBar()
+    ImGuiTabBar* tab_bar = GTabs.TabBars.GetByKey(id);
+    IM_ASSERT(tab_bar != NULL);
+    return tab_bar;
+}
+
+void ImGui::GetTabBarLayout(const char* window_name, const char* str_id, ImVector<ImGuiTabLayout>* out_tabs, float* out_offset_max, int* out_layout_count)
+{
+    ImGuiTabsContext& ctx = GTabs;
+    ImGuiTabBar* tab_bar = FindTabBar(window_name, str_id);
+    out_tabs->resize(tab_bar->TabsOrder.Size);
+    for (int tab_order_n = 0; tab_order_n < tab_bar->TabsOrder.Size; tab_order_n++)
+    {
+        const ImGuiTabItem* tab = ctx.GetTabByOrder(tab_bar, tab_order_n);
+        ImGuiTabLayout& layout = (*out_tabs)[tab_order_n];
+        layout.Id = tab->Id;
+        layout.OrderVisible = tab->CurrentOrderVisible;
+        layout.Offset = tab->OffsetTarget;
+        layout.Width = tab->WidthTarget;
+    }
+    *out_offset_max = tab_bar->OffsetMax;
+    *out_layout_count = tab_bar->LayoutCount;
+}
+
+void ImGui::SetTabBarLayoutDirty(const char* window_name, const char* str_id)
+{
+    FindTabBar(window_name, str_id)->LayoutDirty = true;
+}
+
+void ImGui::QueueTabBarReorder(const char* window_name, const char* str_id, int order, int dir)
+{
+    ImGuiTabBar* tab_bar = FindTabBar(window_name, str_id);
+    TabBarQueueChangeTabOrder(tab_bar, GTabs.GetTabByOrder(tab_bar, order), dir);
+}
@@ -0,0 +1,23 @@
+// Internals of imgui_tabs.cpp for tests, not part of the API (see imgui_tabs.h, which has to be included first)
+#pragma once
+
+struct ImGuiTabLayout
+{
+    ImGuiID     Id;
+    int         OrderVisible;       // -1 when the tab wasn't submitted
+    float       Offset;             // OffsetTarget, relative to the beginning of the bar
+    float       Width;              // WidthTarget
+};
+
+namespace ImGui
+{
+
+// The tab bar str_id submitted in the window window_name, as BeginTabBar() identifies it. The bar has to exist.
+// Layout of its tabs in display order, with the OffsetMax and the number of full layouts of the bar.
+void            GetTabBarLayout(const char* window_name, const char* str_id, ImVector<ImGuiTabLayout>* out_tabs, float* out_offset_max, int* out_layout_count);
+// The next layout of the bar is a full one, even if nothing changed
+void            SetTabBarLayoutDirty(const char* window_name, const char* str_id);
+// Moves the tab at display position order one visible tab left (dir = -1) or right (+1) on the next layout, as dragging it does
+void            QueueTabBarReorder(const char* window_name, const char* str_id, int order, int dir);
+
+};
@@ -0,0 +1,303 @@
+#include "imgui_upload.h"
+#include "imgui_internal.h"
+
+#include <string.h>
+
+static size_t ImUploadAlign(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+static size_t ImUploadGrowCapacity(size_t capacity, size_t min_capacity, size_t required)
+{
+    if (capacity < min_capacity)
+        capacity = min_capacity;
+    while (capacity < required)
+        capacity *= 2;
+    return capacity;
+}
+
+ImGuiUploadRing::ImGuiUploadRing()
+{
+    MinCapacity = 64 * 1024;
+    FramesOfSlack = 3;
+    UseFences = false;
+    ShrinkAfter = 600;
+    Recreations = Discards = 0;
+    Clear();
+}
+
+void ImGuiUploadRing::Clear()
+{
+    Capacity = Head = PendingStart = 0;
+    PendingCount = 0;
+    InFlight.resize(0);
+    PeakSize = 0;
+    PeakCount = 0;
+}
+
+ImGuiUploadPlan ImGuiUploadRing::Plan(size_t size, size_t alignment, ImU64 completed_fence)
+{
+    IM_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    ImGuiUploadPlan plan;
+    plan.Recreate = plan.Discard = false;
+    plan.Size = size;
+
+    // Regions the GPU is done with
+    int retired = 0;
+    while (retired < InFlight.Size && InFlight[retired].Fence <= completed_fence)
+        retired++;
+    if (retired > 0)
+    {
+        memmove(InFlight.Data, InFlight.Data + retired, (size_t)(InFlight.Size - retired) * sizeof(ImGuiUploadRegion));
+        InFlight.resize(InFlight.Size - retired);
+    }
+
+    // Shrinking waits for a whole window of small uploads, and only happens when the buffer is 4x more than needed, so sizes going up and down don't recreate it every few frames
+    size_t shrink_capacity = 0;
+    if (size > PeakSize)
+        PeakSize = size;
+    if (ShrinkAfter > 0 && ++PeakCount >= ShrinkAfter)
+    {
+        const size_t capacity = ImUploadGrowCapacity(MinCapacity, MinCapacity, PeakSize * (size_t)FramesOfSlack);
+        if (capacity * 4 <= Capacity)
+            shrink_capacity = capacity;
+        PeakSize = 0;
+        PeakCount = 0;
+    }
+
+    const size_t aligned_head = ImUploadAlign(Head, alignment);
+    bool fits = false;
+    plan.Offset = aligned_head;
+    if (size <= Capacity && !UseFences)
+    {
+        // The driver renames discarded memory, wrapping is always possible
+        fits = true;
+        if (aligned_head + size > Capacity)
+        {
+            plan.Offset = 0;
+            plan.Discard = true;
+            Discards++;
+        }
+    }
+    else if (size <= Capacity)
+    {
+        // Occupied is the circular range [used_start, Head)
+        const bool empty = (InFlight.Size == 0 && PendingCount == 0);
+        const size_t used_start = InFlight.Size > 0 ? InFlight[0].Start : PendingStart;
+        if (empty)
+        {
+            fits = true;
+            if (aligned_head + size > Capacity)
+                plan.Offset = 0;
+        }
+        else if (used_start < Head)
+        {
+            if (aligned_head + size <= Capacity)
+                fits = true;
+            else if (size <= used_start)
+            {
+                fits = true;
+                plan.Offset = 0;
+            }
+        }
+        else
+        {
+            fits = (aligned_head + size <= used_start);
+        }
+    }
+
+    if (!fits || shrink_capacity > 0)
+    {
+        // Geometric growth, or the shrunk size. The old buffer is dropped along with everything it tracked.
+        if (shrink_capacity > 0)
+            Capacity = shrink_capacity;
+        else
+            Capacity = ImUploadGrowCapacity(Capacity * 2, MinCapacity, size * (size_t)FramesOfSlack);
+        InFlight.resize(0);
+        PendingCount = 0;
+        PendingStart = 0;
+        plan.Offset = 0;
+        plan.Recreate = plan.Discard = true;
+        Recreations++;
+    }
+
+    if (PendingCount++ == 0)
+        PendingStart = plan.Offset;
+    Head = plan.Offset + size;
+    plan.BufferSize = Capacity;
+    return plan;
+}
+
+void ImGuiUploadRing::Submit(ImU64 fence)
+{
+    if (PendingCount == 0)
+        return;
+    ImGuiUploadRegion region;
+    region.Start = PendingStart;
+    region.Fence = fence;
+    InFlight.push_back(region);
+    PendingCount = 0;
+    PendingStart = Head;
+}
+
+size_t ImGui::CalcDrawDataUploadSize(const ImDrawData* draw_data, size_t* out_idx_offset)
+{
+    const size_t idx_offset = ImUploadAlign((size_t)draw_data->TotalVtxCount * sizeof(ImDrawVert), 4);
+    if (out_idx_offset)
+        *out_idx_offset = idx_offset;
+    return idx_offset + (size_t)draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+}
+
+bool ImGui::CanRebaseDrawDataIndices(const ImDrawData* draw_data)
+{
+    return sizeof(ImDrawIdx) >= 4 || draw_data->TotalVtxCount <= (1 << (8 * sizeof(ImDrawIdx)));
+}
+
+void ImGui::PackDrawData(const ImDrawData* draw_data, void* dst, size_t idx_offset, bool rebase_indices)
+{
+    IM_ASSERT(!rebase_indices || CanRebaseDrawDataIndices(draw_data));
+    ImDrawVert* vtx_dst = (ImDrawVert*)dst;
+    ImDrawIdx* idx_dst = (ImDrawIdx*)((char*)dst + idx_offset);
+    unsigned int vtx_base = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        memcpy(vtx_dst, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        if (!rebase_indices || vtx_base == 0)
+        {
+            memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        }
+        else
+        {
+            const ImDrawIdx* idx_src = cmd_list->IdxBuffer.Data;
+            for (int i = 0; i < cmd_list->IdxBuffer.Size; i++)
+                idx_dst[i] = (ImDrawIdx)(idx_src[i] + vtx_base);
+        }
+        vtx_dst += cmd_list->VtxBuffer.Size;
+        idx_dst += cmd_list->IdxBuffer.Size;
+        vtx_base += (unsigned int)cmd_list->VtxBuffer.Size;
+    }
+}
+
+// Scissor rectangle of a clip rectangle, truncated the way the back-ends do it: (LONG)(clip.x - display_pos.x)
+static ImRect ImGetScissorRect(const ImVec4& clip_rect, const ImVec2& display_pos)
+{
+    return ImRect((float)(int)(clip_rect.x - display_pos.x), (float)(int)(clip_rect.y - display_pos.y), (float)(int)(clip_rect.z - display_pos.x), (float)(int)(clip_rect.w - display_pos.y));
+}
+
+static ImRect ImCalcDrawCmdBounds(const ImDrawList* cmd_list, unsigned int idx_start, unsigned int elem_count, const ImVec2& display_pos)
+{
+    ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + idx_start;
+    const ImDrawVert* vtx = cmd_list->VtxBuffer.Data;
+    for (unsigned int i = 0; i < elem_count; i++)
+        bounds.Add(vtx[idx[i]].pos);
+    bounds.Translate(ImVec2(-display_pos.x, -display_pos.y));
+    return bounds;
+}
+
+// A batch may use any clip rectangle R for which each merged command is either drawn with its own clip rectangle (R equals it),
+// or has all of its geometry inside both its own scissor rectangle and R's, so that neither clips anything.
+// Bounds are only measured when a merge depends on them, most adjacent commands differ by texture or are in separate lists.
+int ImGui::BuildDrawBatches(const ImDrawData* draw_data, bool indices_rebased, ImVector<ImGuiDrawBatch>* out_batches)
+{
+    out_batches->resize(0);
+    const ImVec2 display_pos = draw_data->DisplayPos;
+    int cmd_count = 0;
+    unsigned int idx_offset = 0;
+    int vtx_offset = 0;
+    bool batch_open = false;            // Last batch can take more commands
+    bool batch_bounds_valid = false;
+    bool batch_unclipped = false;       // Valid with batch_bounds: every command unaffected by its own clip rectangle, all inside the batch one
+    int batch_cmd_count = 0;
+    ImRect batch_bounds;
+    const ImDrawList* batch_first_list = NULL;
+    unsigned int batch_first_idx_start = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        unsigned int idx_start = 0;
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            cmd_count++;
+            if (pcmd->UserCallback)
+            {
+                ImGuiDrawBatch batch = { pcmd->ClipRect, pcmd->TextureId, idx_offset, pcmd->ElemCount, indices_rebased ? 0 : vtx_offset, cmd_list, pcmd };
+                out_batches->push_back(batch);
+                batch_open = false;
+                idx_start += pcmd->ElemCount;
+                idx_offset += pcmd->ElemCount;
+                continue;
+            }
+            if (pcmd->ElemCount == 0)
+                continue;
+
+            const int base_vtx = indices_rebased ? 0 : vtx_offset;
+            ImGuiDrawBatch* last = batch_open ? &out_batches->back() : NULL;
+            bool merged = false;
+            if (last && last->TextureId == pcmd->TextureId && last->VtxOffset == base_vtx && last->IdxOffset + last->ElemCount == idx_offset)
+            {
+                if (memcmp(&last->ClipRect, &pcmd->ClipRect, sizeof(ImVec4)) == 0)
+                {
+                    merged = true;
+                    batch_bounds_valid = false;
+                }
+                else
+                {
+                    if (!batch_bounds_valid && batch_cmd_count == 1)
+                    {
+                        batch_bounds = ImCalcDrawCmdBounds(batch_first_list, batch_first_idx_start, last->ElemCount, display_pos);
+                        batch_unclipped = ImGetScissorRect(last->ClipRect, display_pos).Contains(batch_bounds);
+                        batch_bounds_valid = true;
+                    }
+                    const ImRect bounds = ImCalcDrawCmdBounds(cmd_list, idx_start, pcmd->ElemCount, display_pos);
+                    const ImRect scissor = ImGetScissorRect(pcmd->ClipRect, display_pos);
+                    const bool unclipped = scissor.Contains(bounds);
+                    const bool batch_unclipped_valid = batch_bounds_valid && batch_unclipped;
+                    if (unclipped && ImGetScissorRect(last->ClipRect, display_pos).Contains(bounds))
+                    {
+                        // Keep the batch clip rectangle
+                        merged = true;
+                    }
+                    else if (batch_unclipped_valid && unclipped)
+                    {
+                        last->ClipRect = ImVec4(ImMin(last->ClipRect.x, pcmd->ClipRect.x), ImMin(last->ClipRect.y, pcmd->ClipRect.y), ImMax(last->ClipRect.z, pcmd->ClipRect.z), ImMax(last->ClipRect.w, pcmd->ClipRect.w));
+                        merged = true;
+                    }
+                    else if (batch_unclipped_valid && scissor.Contains(batch_bounds))
+                    {
+                        // The batch becomes clipped by this command rectangle, which leaves its earlier geometry alone
+                        last->ClipRect = pcmd->ClipRect;
+                        batch_unclipped = unclipped;
+                        merged = true;
+                    }
+                    if (merged && batch_bounds_valid)
+                        batch_bounds.Add(bounds);
+                }
+            }
+
+            if (merged)
+            {
+                last->ElemCount += pcmd->ElemCount;
+                last->Cmd = pcmd;
+                batch_cmd_count++;
+            }
+            else
+            {
+                ImGuiDrawBatch batch = { pcmd->ClipRect, pcmd->TextureId, idx_offset, pcmd->ElemCount, base_vtx, cmd_list, pcmd };
+                out_batches->push_back(batch);
+                batch_open = true;
+                batch_bounds_valid = false;
+                batch_cmd_count = 1;
+                batch_first_list = cmd_list;
+                batch_first_idx_start = idx_start;
+            }
+            idx_start += pcmd->ElemCount;
+            idx_offset += pcmd->ElemCount;
+        }
+        vtx_offset += cmd_list->VtxBuffer.Size;
+    }
+    return cmd_count - out_batches->Size;
+}
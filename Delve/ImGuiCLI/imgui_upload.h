@@ -0,0 +1,75 @@
+#pragma once
+
+#include "imgui.h"
+
+// Upload planning for renderer back-ends: where the geometry of each ImDrawData goes in a GPU buffer that is kept from frame to frame.
+// - Vertices and indices of every draw list are packed into one region, so an upload is a single map/lock and sub-allocation.
+// - The buffer is used as a ring. Uploads append until it wraps, then either the back-end maps with a discard (Direct3D 11 dynamic
+//   buffers, the driver renames the memory) or, with UseFences, regions are only reused once the fence submitted with them completed.
+// - The buffer grows geometrically, sized for a few uploads of the largest frame seen, and shrinks back once recent frames are much smaller.
+// Nothing here touches a graphics API: back-ends execute the ImGuiUploadPlan (imgui_impl_dx11.cpp, ImGuiHarness).
+
+struct ImGuiUploadPlan
+{
+    bool        Recreate;           // Release the buffer and create one of BufferSize bytes (Discard is set too). With fences the old buffer stays in use until the last submitted fence completes.
+    bool        Discard;            // Map discarding the previous contents, otherwise map without overwriting (nothing in flight is touched)
+    size_t      BufferSize;
+    size_t      Offset;             // Start of the upload in the buffer, in bytes
+    size_t      Size;
+};
+
+// One draw call after BuildDrawBatches(): adjacent commands that can share a draw call are merged, nothing is reordered
+struct ImGuiDrawBatch
+{
+    ImVec4              ClipRect;
+    ImTextureID         TextureId;
+    unsigned int        IdxOffset;          // First index in the packed index data
+    unsigned int        ElemCount;
+    int                 VtxOffset;          // Base vertex to draw with, 0 when the indices were rebased
+    const ImDrawList*   CmdList;
+    const ImDrawCmd*    Cmd;                // Last command merged in. When Cmd->UserCallback is set call it with (CmdList, Cmd) instead of drawing.
+};
+
+struct ImGuiUploadRegion
+{
+    size_t      Start;
+    ImU64       Fence;
+};
+
+struct ImGuiUploadRing
+{
+    // Settings
+    size_t      MinCapacity;        // = 64 KB
+    int         FramesOfSlack;      // = 3      // Growing makes room for this many uploads of the requested size
+    bool        UseFences;          // = false  // See Submit()
+    int         ShrinkAfter;        // = 600    // Recreate smaller when the largest of the last ShrinkAfter uploads fits in a quarter of the buffer (with FramesOfSlack). 0 to never shrink.
+
+    // State
+    size_t      Capacity;           // Size of the current buffer, 0 before the first Plan()
+    size_t      Head;               // Next free byte
+    size_t      PendingStart;       // Start of the uploads planned since the last Submit()
+    int         PendingCount;
+    ImVector<ImGuiUploadRegion> InFlight;   // Oldest first
+    size_t      PeakSize;           // Largest upload since PeakCount was reset
+    int         PeakCount;
+    int         Recreations;        // Stats, never reset
+    int         Discards;
+
+    IMGUI_API ImGuiUploadRing();
+    IMGUI_API ImGuiUploadPlan   Plan(size_t size, size_t alignment = 16, ImU64 completed_fence = 0); // completed_fence: latest fence the GPU is done with (UseFences only)
+    IMGUI_API void              Submit(ImU64 fence);    // UseFences only: the uploads planned since the last Submit() are read by the GPU until 'fence' completes
+    IMGUI_API void              Clear();                // Forget the buffer, e.g. after the device got lost
+};
+
+namespace ImGui
+{
+    // Packed layout: all vertices, then all indices starting at *out_idx_offset (aligned to 4 bytes). Draw with the base vertex/index of each list as usual.
+    // With rebase_indices the indices are made relative to the first vertex of the draw data instead, which lets BuildDrawBatches() merge across draw lists.
+    IMGUI_API size_t    CalcDrawDataUploadSize(const ImDrawData* draw_data, size_t* out_idx_offset);
+    IMGUI_API bool      CanRebaseDrawDataIndices(const ImDrawData* draw_data);  // All vertices addressable by ImDrawIdx
+    IMGUI_API void      PackDrawData(const ImDrawData* draw_data, void* dst, size_t idx_offset, bool rebase_indices = false);
+
+    // Merge adjacent commands sharing a texture when the result is pixel identical: same clip rectangle, or geometry that the scissor
+    // rectangles (as back-ends truncate them) don't clip anyway. Returns the number of draw calls saved.
+    IMGUI_API int       BuildDrawBatches(const ImDrawData* draw_data, bool indices_rebased, ImVector<ImGuiDrawBatch>* out_batches);
+}